@@ -3,6 +3,20 @@
 in vec3 v_normal;
 in vec2 v_uv;
 in vec3 v_position;
+in float v_viewDepth;  // profondeur en espace vue
+
+// Matériaux de tous les meshes (MaterialBuffer), une page de 256 liée par draw
+struct MaterialData {
+    vec4 diffuse;    // rgb + shininess
+    vec4 specular;   // rgb + specularStrength
+    vec4 emissive;   // lightColor + emissiveIntensity
+    ivec4 params;    // illuminationModel, isEmissive, textures utilisées, ignoreObjectMaterial
+};
+
+layout(std140) uniform Materials {
+    MaterialData u_materials[256];
+};
+uniform int u_materialIndex;
 
 struct Material {
     vec3 diffuseColor;
@@ -15,23 +29,20 @@ struct Material {
     int illuminationModel;  // 0: Lambert, 1: Phong, 2: Blinn-Phong
 };
 
-// Définir une structure pour les lumières émissives
-struct EmissiveLight {
-    vec3 position;
-    vec3 color;
-    float intensity;
-};
-
-uniform Material u_material;
+// Matériau de l'objet, décodé une fois au début de main()
+Material material;
 uniform sampler2D u_texture;
 uniform vec3 u_viewPos;
 uniform bool u_hasTexture;  // Ajout d'un uniform pour gérer la présence de texture
-uniform bool u_useTexture; // Ajouter les uniformes pour contrôler la texture
 
-// Nouveau uniform pour recevoir les lumières émissives
-#define MAX_EMISSIVE_LIGHTS 10
-uniform EmissiveLight u_emissiveLights[MAX_EMISSIVE_LIGHTS];
-uniform int u_numEmissiveLights;
+// Éclairage par clusters (LightManager) : lumières de la frame dans des
+// texture buffers, liste des lumières qui touchent chaque cluster de la vue
+uniform samplerBuffer u_lights;         // 2 texels par lumière : position + rayon, couleur + intensité
+uniform usamplerBuffer u_clusterLights; // début + nombre dans u_lightIndices
+uniform usamplerBuffer u_lightIndices;
+uniform ivec3 u_clusterGrid;            // tuiles x, tuiles y, tranches de profondeur
+uniform vec2 u_clusterTileSize;         // taille d'une tuile en pixels
+uniform vec2 u_clusterDepth;            // tranche = log(profondeur) * x + y
 
 out vec4 FragColor;
 
@@ -47,8 +58,8 @@ vec3 CalculatePhong(vec3 normal, vec3 lightDir, vec3 viewDir, vec3 lightColor) {
     
     // Specular (Phong)
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), u_material.shininess);
-    vec3 specular = spec * lightColor * u_material.specularStrength;
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    vec3 specular = spec * lightColor * material.specularStrength;
     
     return diffuse + specular;
 }
@@ -60,21 +71,22 @@ vec3 CalculateBlinnPhong(vec3 normal, vec3 lightDir, vec3 viewDir, vec3 lightCol
     
     // Specular (Blinn-Phong)
     vec3 halfwayDir = normalize(lightDir + viewDir);
-    float spec = pow(max(dot(normal, halfwayDir), 0.0), u_material.shininess);
-    vec3 specular = spec * lightColor * u_material.specularStrength;
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
+    vec3 specular = spec * lightColor * material.specularStrength;
     
     return diffuse + specular;
 }
 
-vec3 CalculateLight(vec3 normal, vec3 fragPos, vec3 lightPos, vec3 lightColor, float lightIntensity) {
+vec3 CalculateLight(vec3 normal, vec3 fragPos, vec4 positionRadius, vec3 lightColor, float lightIntensity) {
+    vec3 lightPos = positionRadius.xyz;
     vec3 lightDir = normalize(lightPos - fragPos);
     vec3 viewDir = normalize(u_viewPos - fragPos);
     
     vec3 result;
-    if (u_material.illuminationModel == 0) {
+    if (material.illuminationModel == 0) {
         result = CalculateLambert(normal, lightDir, lightColor);
     }
-    else if (u_material.illuminationModel == 1) {
+    else if (material.illuminationModel == 1) {
         result = CalculatePhong(normal, lightDir, viewDir, lightColor);
     }
     else {
@@ -84,37 +96,62 @@ vec3 CalculateLight(vec3 normal, vec3 fragPos, vec3 lightPos, vec3 lightColor, f
     // Atténuation
     float distance = length(lightPos - fragPos);
     float attenuation = 1.0 / (1.0 + 0.045 * distance + 0.0075 * distance * distance);
+    // Fondu jusqu'à 0 au rayon du cluster, pour ne pas voir les bords des tuiles
+    float falloff = clamp(1.0 - pow(distance / positionRadius.w, 4.0), 0.0, 1.0);
+    attenuation *= falloff * falloff;
     
     return result * attenuation * lightIntensity;
 }
 
+// Cluster du fragment : début et nombre de ses lumières
+uvec2 GetClusterLights() {
+    ivec2 tile = min(ivec2(gl_FragCoord.xy / u_clusterTileSize), u_clusterGrid.xy - 1);
+    int slice = clamp(int(log(v_viewDepth) * u_clusterDepth.x + u_clusterDepth.y), 0, u_clusterGrid.z - 1);
+    int cluster = (slice * u_clusterGrid.y + tile.y) * u_clusterGrid.x + tile.x;
+    return texelFetch(u_clusterLights, cluster).xy;
+}
+
 void main() {
+    MaterialData data = u_materials[u_materialIndex];
+    material.diffuseColor = data.diffuse.rgb;
+    material.shininess = data.diffuse.a;
+    material.specularColor = data.specular.rgb;
+    material.specularStrength = data.specular.a;
+    material.lightColor = data.emissive.rgb;
+    material.emissiveIntensity = data.emissive.a;
+    material.illuminationModel = data.params.x;
+    material.isEmissive = data.params.y != 0;
+
     // Utiliser la couleur de base si pas de texture
-    vec4 texColor = u_hasTexture ? texture(u_texture, v_uv) : vec4(u_material.diffuseColor, 1.0);
+    vec4 texColor = u_hasTexture ? texture(u_texture, v_uv) : vec4(material.diffuseColor, 1.0);
     vec3 norm = normalize(v_normal);
     
-    if (u_material.isEmissive) {
+    if (material.isEmissive) {
         // Les objets émissifs ne devraient pas être affectés par la shininess
-        vec3 emissiveColor = u_material.lightColor * u_material.emissiveIntensity * texColor.rgb;
+        vec3 emissiveColor = material.lightColor * material.emissiveIntensity * texColor.rgb;
         FragColor = vec4(emissiveColor, texColor.a);
         return;
     }
 
     // Lumière ambiante de base
-    vec3 ambient = vec3(0.15) * texColor.rgb * u_material.diffuseColor;
+    vec3 ambient = vec3(0.15) * texColor.rgb * material.diffuseColor;
     vec3 result = ambient;
     
     // Lumière diffuse et spéculaire seulement pour les objets non émissifs
-    for(int i = 0; i < u_numEmissiveLights; i++) {
+    uvec2 cluster = GetClusterLights();
+    for(uint i = 0u; i < cluster.y; i++) {
+        int light = int(texelFetch(u_lightIndices, int(cluster.x + i)).r);
+        vec4 positionRadius = texelFetch(u_lights, light * 2);
+        vec4 colorIntensity = texelFetch(u_lights, light * 2 + 1);
         vec3 lightContrib = CalculateLight(
-            norm, 
+            norm,
             v_position,
-            u_emissiveLights[i].position,
-            u_emissiveLights[i].color,
-            u_emissiveLights[i].intensity
+            positionRadius,
+            colorIntensity.rgb,
+            colorIntensity.a
         );
         
-        result += lightContrib * texColor.rgb * u_material.diffuseColor;
+        result += lightContrib * texColor.rgb * material.diffuseColor;
     }
     
     result = pow(result, vec3(1.0/2.2)); // Correction gamma
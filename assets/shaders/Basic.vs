@@ -17,12 +17,14 @@ layout(location = 2) in vec2 a_uv;
 out vec3 v_normal;
 out vec2 v_uv;
 out vec3 v_position;
+out float v_viewDepth;
 
 void main() {
     gl_Position = u_projection * u_view * u_transform * vec4(a_position, 1.0);
     // Position en espace monde
     vec4 worldPos = u_transform * vec4(a_position, 1.0);
     v_position = worldPos.xyz;
+    v_viewDepth = -(u_view * worldPos).z;
     
     // Normal en espace monde
     v_normal = normalize(mat3(u_transform) * a_normal);
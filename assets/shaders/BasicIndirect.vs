@@ -0,0 +1,71 @@
+#version 430 core
+#extension GL_ARB_shader_draw_parameters : enable
+
+layout(std140) uniform ProjectionView {
+    mat4 u_projection;
+    mat4 u_view;
+};
+
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec2 a_uv;
+// Index du draw par instance (baseInstance), si gl_DrawIDARB n'existe pas
+layout(location = 3) in uint a_drawIndex;
+
+// Une entrée par draw de la frame (voir IndirectDrawData)
+struct DrawData {
+    mat4 model;
+    uvec4 params;   // slot du matériau, texture affichée
+};
+
+layout(std430, binding = 0) readonly buffer DrawStorage {
+    DrawData u_draws[];
+};
+
+// Tous les matériaux de MaterialBuffer (même layout que le bloc Materials)
+struct MaterialData {
+    vec4 diffuse;    // rgb + shininess
+    vec4 specular;   // rgb + specularStrength
+    vec4 emissive;   // lightColor + emissiveIntensity
+    ivec4 params;    // illuminationModel, isEmissive, textures utilisées, ignoreObjectMaterial
+};
+
+layout(std430, binding = 1) readonly buffer MaterialStorage {
+    MaterialData u_materials[];
+};
+
+// Premier draw du glMultiDrawElementsIndirect en cours
+uniform uint u_drawOffset;
+
+out vec3 v_normal;
+out vec2 v_uv;
+out vec3 v_position;
+out float v_viewDepth;
+
+// Mêmes sorties que BasicInstanced.vs : BasicInstanced.fs sert aux deux
+flat out vec4 v_diffuse;
+flat out vec4 v_specular;
+flat out vec4 v_emissive;
+flat out vec4 v_params;
+
+void main() {
+#ifdef GL_ARB_shader_draw_parameters
+    uint drawIndex = u_drawOffset + uint(gl_DrawIDARB);
+#else
+    uint drawIndex = a_drawIndex;
+#endif
+    DrawData draw = u_draws[drawIndex];
+    MaterialData material = u_materials[draw.params.x];
+
+    vec4 worldPos = draw.model * vec4(a_position, 1.0);
+    gl_Position = u_projection * u_view * worldPos;
+    v_position = worldPos.xyz;
+    v_viewDepth = -(u_view * worldPos).z;
+    v_normal = normalize(mat3(draw.model) * a_normal);
+    v_uv = a_uv;
+
+    v_diffuse = material.diffuse;
+    v_specular = material.specular;
+    v_emissive = material.emissive;
+    v_params = vec4(float(material.params.x), float(material.params.y), float(draw.params.y), 0.0);
+}
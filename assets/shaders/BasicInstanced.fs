@@ -0,0 +1,103 @@
+#version 330 core
+
+in vec3 v_normal;
+in vec2 v_uv;
+in vec3 v_position;
+in float v_viewDepth;  // profondeur en espace vue
+
+// Matériau de l'instance
+flat in vec4 v_diffuse;
+flat in vec4 v_specular;
+flat in vec4 v_emissive;
+flat in vec4 v_params;
+
+uniform sampler2D u_texture;
+uniform vec3 u_viewPos;
+
+// Éclairage par clusters (LightManager) : lumières de la frame dans des
+// texture buffers, liste des lumières qui touchent chaque cluster de la vue
+uniform samplerBuffer u_lights;         // 2 texels par lumière : position + rayon, couleur + intensité
+uniform usamplerBuffer u_clusterLights; // début + nombre dans u_lightIndices
+uniform usamplerBuffer u_lightIndices;
+uniform ivec3 u_clusterGrid;            // tuiles x, tuiles y, tranches de profondeur
+uniform vec2 u_clusterTileSize;         // taille d'une tuile en pixels
+uniform vec2 u_clusterDepth;            // tranche = log(profondeur) * x + y
+
+out vec4 FragColor;
+
+vec3 CalculateLight(vec3 normal, vec3 fragPos, vec4 positionRadius, vec3 lightColor, float lightIntensity) {
+    vec3 lightPos = positionRadius.xyz;
+    vec3 lightDir = normalize(lightPos - fragPos);
+    vec3 viewDir = normalize(u_viewPos - fragPos);
+    int illuminationModel = int(v_params.x + 0.5);
+    float shininess = v_diffuse.a;
+    float specularStrength = v_specular.a;
+
+    // Diffuse (Lambert)
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 result = diff * lightColor;
+
+    if (illuminationModel == 1) {
+        // Specular (Phong)
+        vec3 reflectDir = reflect(-lightDir, normal);
+        float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+        result += spec * lightColor * specularStrength;
+    }
+    else if (illuminationModel == 2) {
+        // Specular (Blinn-Phong)
+        vec3 halfwayDir = normalize(lightDir + viewDir);
+        float spec = pow(max(dot(normal, halfwayDir), 0.0), shininess);
+        result += spec * lightColor * specularStrength;
+    }
+
+    // Atténuation
+    float distance = length(lightPos - fragPos);
+    float attenuation = 1.0 / (1.0 + 0.045 * distance + 0.0075 * distance * distance);
+    // Fondu jusqu'à 0 au rayon du cluster, pour ne pas voir les bords des tuiles
+    float falloff = clamp(1.0 - pow(distance / positionRadius.w, 4.0), 0.0, 1.0);
+    attenuation *= falloff * falloff;
+
+    return result * attenuation * lightIntensity;
+}
+
+// Cluster du fragment : début et nombre de ses lumières
+uvec2 GetClusterLights() {
+    ivec2 tile = min(ivec2(gl_FragCoord.xy / u_clusterTileSize), u_clusterGrid.xy - 1);
+    int slice = clamp(int(log(v_viewDepth) * u_clusterDepth.x + u_clusterDepth.y), 0, u_clusterGrid.z - 1);
+    int cluster = (slice * u_clusterGrid.y + tile.y) * u_clusterGrid.x + tile.x;
+    return texelFetch(u_clusterLights, cluster).xy;
+}
+
+void main() {
+    vec3 diffuseColor = v_diffuse.rgb;
+    vec4 texColor = v_params.z > 0.5 ? texture(u_texture, v_uv) : vec4(diffuseColor, 1.0);
+    vec3 norm = normalize(v_normal);
+
+    if (v_params.y > 0.5) {
+        vec3 emissiveColor = v_emissive.rgb * v_emissive.a * texColor.rgb;
+        FragColor = vec4(emissiveColor, texColor.a);
+        return;
+    }
+
+    vec3 ambient = vec3(0.15) * texColor.rgb * diffuseColor;
+    vec3 result = ambient;
+
+    uvec2 cluster = GetClusterLights();
+    for(uint i = 0u; i < cluster.y; i++) {
+        int light = int(texelFetch(u_lightIndices, int(cluster.x + i)).r);
+        vec4 positionRadius = texelFetch(u_lights, light * 2);
+        vec4 colorIntensity = texelFetch(u_lights, light * 2 + 1);
+        vec3 lightContrib = CalculateLight(
+            norm,
+            v_position,
+            positionRadius,
+            colorIntensity.rgb,
+            colorIntensity.a
+        );
+
+        result += lightContrib * texColor.rgb * diffuseColor;
+    }
+
+    result = pow(result, vec3(1.0/2.2)); // Correction gamma
+    FragColor = vec4(result, texColor.a);
+}
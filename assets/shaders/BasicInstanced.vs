@@ -0,0 +1,41 @@
+#version 330 core
+
+layout(std140) uniform ProjectionView {
+    mat4 u_projection;
+    mat4 u_view;
+};
+
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec2 a_uv;
+
+// Attributs par instance (voir InstanceData)
+layout(location = 3) in mat4 a_transform;   // locations 3 à 6
+layout(location = 7) in vec4 a_diffuse;     // rgb + shininess
+layout(location = 8) in vec4 a_specular;    // rgb + specularStrength
+layout(location = 9) in vec4 a_emissive;    // lightColor + emissiveIntensity
+layout(location = 10) in vec4 a_params;     // illuminationModel, isEmissive, hasTexture
+
+out vec3 v_normal;
+out vec2 v_uv;
+out vec3 v_position;
+out float v_viewDepth;
+
+flat out vec4 v_diffuse;
+flat out vec4 v_specular;
+flat out vec4 v_emissive;
+flat out vec4 v_params;
+
+void main() {
+    vec4 worldPos = a_transform * vec4(a_position, 1.0);
+    gl_Position = u_projection * u_view * worldPos;
+    v_position = worldPos.xyz;
+    v_viewDepth = -(u_view * worldPos).z;
+    v_normal = normalize(mat3(a_transform) * a_normal);
+    v_uv = a_uv;
+
+    v_diffuse = a_diffuse;
+    v_specular = a_specular;
+    v_emissive = a_emissive;
+    v_params = a_params;
+}
@@ -1,7 +1,18 @@
 #version 330 core
 
-uniform vec3 u_color;
-uniform bool u_useTexture;
+// Matériaux de tous les meshes (MaterialBuffer), une page de 256 liée par draw
+struct MaterialData {
+    vec4 diffuse;    // rgb + shininess
+    vec4 specular;   // rgb + specularStrength
+    vec4 emissive;   // lightColor + emissiveIntensity
+    ivec4 params;    // illuminationModel, isEmissive, textures utilisées, ignoreObjectMaterial
+};
+
+layout(std140) uniform Materials {
+    MaterialData u_materials[256];
+};
+uniform int u_materialIndex;
+
 uniform sampler2D u_texture;
 uniform bool u_hasTexture;
 
@@ -9,11 +20,13 @@ in vec2 v_uv;
 out vec4 FragColor;
 
 void main() {
-    vec3 finalColor = u_color;
+    MaterialData material = u_materials[u_materialIndex];
+    vec3 finalColor = material.diffuse.rgb;
+    bool useTexture = (material.params.z & 2) != 0;
     
-    if (u_useTexture && u_hasTexture) {
+    if (useTexture && u_hasTexture) {
         vec3 texColor = texture(u_texture, v_uv).rgb;
-        finalColor = texColor * u_color;
+        finalColor = texColor * material.diffuse.rgb;
     }
     
     FragColor = vec4(finalColor, 1.0);
@@ -7,14 +7,20 @@ out vec4 FragColor;
 uniform samplerCube u_envmap;
 uniform sampler2D u_texture;
 uniform vec3 u_viewPos;
-uniform bool u_useTexture;
 uniform bool u_hasTexture;
-uniform struct Material {
-    vec3 diffuseColor;
-    vec3 specularColor;
-    float shininess;
-    float specularStrength;
-} u_material;
+
+// Matériaux de tous les meshes (MaterialBuffer), une page de 256 liée par draw
+struct MaterialData {
+    vec4 diffuse;    // rgb + shininess
+    vec4 specular;   // rgb + specularStrength
+    vec4 emissive;   // lightColor + emissiveIntensity
+    ivec4 params;    // illuminationModel, isEmissive, textures utilisées, ignoreObjectMaterial
+};
+
+layout(std140) uniform Materials {
+    MaterialData u_materials[256];
+};
+uniform int u_materialIndex;
 
 void main() {
     vec3 N = normalize(v_normal);
@@ -24,17 +30,26 @@ void main() {
     // Échantillonner le cubemap avec le vecteur de réflexion
     vec3 reflectionColor = texture(u_envmap, R).rgb;
     
+    MaterialData material = u_materials[u_materialIndex];
+
+    // Matériau ignoré : miroir parfait
+    if (material.params.w != 0) {
+        FragColor = vec4(reflectionColor, 1.0);
+        return;
+    }
+
     // Couleur de base - soit la texture soit la couleur du matériau
-    vec3 baseColor = u_material.diffuseColor;
-    if (u_useTexture && u_hasTexture) {
+    vec3 baseColor = material.diffuse.rgb;
+    bool useTexture = (material.params.z & 4) != 0;
+    if (useTexture && u_hasTexture) {
         // Si on utilise la texture, on l'échantillonne et on la multiplie avec la couleur de base
         vec3 texColor = texture(u_texture, v_uv).rgb;
-        baseColor = texColor * u_material.diffuseColor;
+        baseColor = texColor * material.diffuse.rgb;
     }
     
     // Calculer l'effet Fresnel pour un rendu plus réaliste
     float fresnel = pow(1.0 - max(dot(normalize(-I), N), 0.0), 3.0);
-    float reflectivity = mix(0.1, u_material.specularStrength, fresnel);
+    float reflectivity = mix(0.1, material.specular.a, fresnel);
     
     // Mélanger la couleur de base avec la réflexion
     vec3 finalColor = mix(baseColor, reflectionColor, reflectivity);
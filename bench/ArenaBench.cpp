@@ -0,0 +1,126 @@
+// Benchmark du RangeAllocator de la GeometryArena : des géométries de tailles
+// variées (sphères de tessellations différentes, modèles importés) sont allouées
+// puis libérées au hasard, comme pendant des changements de scène. On mesure le
+// coût d'une allocation, l'espace perdu dans les trous, la fragmentation, et ce
+// que rapporte un compactage (Defragment). Les blocs vivants sont vérifiés
+// (aucun chevauchement) à la fin de chaque tour.
+// Usage : arena_bench.exe [tours] [opérations par tour]
+#include "../include/RangeAllocator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+struct Block {
+    size_t offset;
+    size_t count;
+};
+
+// Nombre de sommets d'une géométrie : surtout des sphères (niveaux de détail
+// compris), parfois un modèle importé bien plus gros
+size_t RandomVertexCount(std::mt19937& rng) {
+    static const int SPHERE_SECTORS[] = { 6, 9, 18, 36, 72 };
+    std::uniform_int_distribution<int> kind(0, 9);
+    if (kind(rng) == 0) {
+        return std::uniform_int_distribution<size_t>(20000, 200000)(rng);
+    }
+    int sectors = SPHERE_SECTORS[std::uniform_int_distribution<int>(0, 4)(rng)];
+    int stacks = std::max(4, sectors / 2);
+    return static_cast<size_t>((sectors + 1) * (stacks + 1));
+}
+
+bool CheckNoOverlap(std::vector<Block> blocks) {
+    std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) { return a.offset < b.offset; });
+    for (size_t i = 1; i < blocks.size(); ++i) {
+        if (blocks[i - 1].offset + blocks[i - 1].count > blocks[i].offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+    int operations = argc > 2 ? std::atoi(argv[2]) : 20000;
+
+    std::mt19937 rng(42);
+    RangeAllocator allocator(1 << 16);
+    std::vector<Block> live;
+    size_t allocations = 0, grows = 0;
+    double allocMs = 0.0, freeMs = 0.0;
+
+    std::printf("Round  live  used MB  end MB  holes  hole MB  largest MB  fragmentation\n");
+    for (int round = 0; round < rounds; ++round) {
+        for (int op = 0; op < operations; ++op) {
+            // Population qui varie au hasard entre 200 et 4000 géométries
+            bool allocate = live.size() < 200 || (live.size() < 4000 && rng() % 2 == 0);
+            if (allocate) {
+                size_t count = RandomVertexCount(rng);
+                auto start = std::chrono::high_resolution_clock::now();
+                size_t offset = allocator.Allocate(count);
+                if (offset == RangeAllocator::INVALID) {
+                    // Comme GeometryArena : capacité doublée jusqu'à ce que le bloc tienne
+                    size_t capacity = allocator.GetCapacity();
+                    while (capacity - allocator.GetEnd() < count) capacity *= 2;
+                    allocator.Grow(capacity);
+                    offset = allocator.Allocate(count);
+                    ++grows;
+                }
+                allocMs += ElapsedMs(start);
+                live.push_back({ offset, count });
+                ++allocations;
+            } else {
+                size_t index = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+                auto start = std::chrono::high_resolution_clock::now();
+                allocator.Free(live[index].offset, live[index].count);
+                freeMs += ElapsedMs(start);
+                live[index] = live.back();
+                live.pop_back();
+            }
+        }
+
+        if (!CheckNoOverlap(live)) {
+            std::printf("ERROR: overlapping blocks after round %d\n", round);
+            return 1;
+        }
+        const double mb = 32.0 / (1024.0 * 1024.0);    // sizeof(Vertex)
+        std::printf("%5d  %4zu  %7.1f  %6.1f  %5zu  %7.1f  %10.1f  %12.0f%%\n", round, live.size(),
+            allocator.GetLiveCount() * mb, allocator.GetEnd() * mb, allocator.GetHoleCount(),
+            allocator.GetHoleSize() * mb, allocator.GetLargestFree() * mb, allocator.GetFragmentation() * 100.0f);
+    }
+
+    std::printf("\n%zu allocations: %.3f us each, %.3f us per free, %zu grows (capacity %.1f MB)\n",
+        allocations, allocMs * 1000.0 / allocations, freeMs * 1000.0 / std::max<size_t>(1, allocations - live.size()),
+        grows, allocator.GetCapacity() * 32.0 / (1024.0 * 1024.0));
+
+    // Compactage : les blocs sont recopiés bout à bout dans l'ordre de leurs positions
+    size_t endBefore = allocator.GetEnd();
+    size_t holesBefore = allocator.GetHoleCount();
+    float fragmentationBefore = allocator.GetFragmentation();
+    auto start = std::chrono::high_resolution_clock::now();
+    std::sort(live.begin(), live.end(), [](const Block& a, const Block& b) { return a.offset < b.offset; });
+    size_t cursor = 0, moved = 0;
+    for (Block& block : live) {
+        if (block.offset != cursor) moved += block.count;
+        block.offset = cursor;
+        cursor += block.count;
+    }
+    allocator.SetPacked(cursor);
+    double compactMs = ElapsedMs(start);
+    std::printf("Defragment: end %.1f -> %.1f MB, %zu -> %zu holes, fragmentation %.0f%% -> %.0f%%, "
+                "%.1f MB to copy, %.3f ms of bookkeeping\n",
+        endBefore * 32.0 / (1024.0 * 1024.0), allocator.GetEnd() * 32.0 / (1024.0 * 1024.0),
+        holesBefore, allocator.GetHoleCount(), fragmentationBefore * 100.0f,
+        allocator.GetFragmentation() * 100.0f, moved * 32.0 / (1024.0 * 1024.0), compactMs);
+    return 0;
+}
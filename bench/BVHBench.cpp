@@ -0,0 +1,188 @@
+// Benchmark du DynamicBVH : objets qui bougent à chaque frame, recalage de
+// l'arbre puis requêtes (frustum, portée de lumière, rayons vers des objets
+// tirés au hasard) comparées au parcours linéaire de la liste
+// Usage : bvh_bench.exe [objets] [frames]
+#include "../include/Bounds.h"
+#include "../include/DynamicBVH.h"
+#include "../include/Frustum.h"
+#include "../include/Mat4.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Object {
+    Bounds bounds;
+    float velocity[3];
+    int proxy;
+};
+
+double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+Bounds MakeBounds(const float* center, float radius) {
+    float boxMin[3], boxMax[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        boxMin[axis] = center[axis] - radius;
+        boxMax[axis] = center[axis] + radius;
+    }
+    return Bounds::FromBox(boxMin, boxMax, radius * 1.7320508f);
+}
+
+// Test des dalles sur la boîte exacte, le même pour l'arbre et la liste
+bool RayHitsBox(const Bounds& bounds, const float* origin, const float* inverse, float maxDistance) {
+    float tMin = 0.0f, tMax = maxDistance;
+    for (int axis = 0; axis < 3; ++axis) {
+        float t1 = (bounds.min[axis] - origin[axis]) * inverse[axis];
+        float t2 = (bounds.max[axis] - origin[axis]) * inverse[axis];
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+    }
+    return tMin <= tMax;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 60;
+
+    // Objets répartis dans un cube de 2 km, vitesse jusqu'à 0.1 unité par frame
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    std::uniform_real_distribution<float> speed(-0.1f, 0.1f);
+    std::vector<Object> objects(count);
+    DynamicBVH tree;
+
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    for (Object& obj : objects) {
+        float center[3] = { position(rng), position(rng), position(rng) };
+        obj.bounds = MakeBounds(center, size(rng));
+        for (float& v : obj.velocity) v = speed(rng);
+        obj.proxy = tree.Insert(obj.bounds, &obj);
+    }
+    double buildMs = ElapsedMs(buildStart);
+
+    Mat4 projection = Mat4::perspective(45.0f * 3.14159265f / 180.0f, 16.0f / 9.0f, 0.1f, 300.0f);
+    const float up[3] = { 0.0f, 1.0f, 0.0f };
+    const float lightCenter[3] = { 0.0f, 0.0f, 0.0f };
+    const float lightRadius = 150.0f;
+    const int raysPerFrame = 64;
+    std::uniform_int_distribution<size_t> pickObject(0, count - 1);
+
+    double moveMs = 0.0, refitMs = 0.0, treeQueryMs = 0.0, linearQueryMs = 0.0;
+    double treeLightMs = 0.0, linearLightMs = 0.0, treeRayMs = 0.0, linearRayMs = 0.0;
+    size_t reinserted = 0, visibleTree = 0, mismatches = 0, lit = 0, hits = 0;
+    for (int f = 0; f < frames; f++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (Object& obj : objects) {
+            for (int axis = 0; axis < 3; ++axis) {
+                obj.bounds.min[axis] += obj.velocity[axis];
+                obj.bounds.max[axis] += obj.velocity[axis];
+                obj.bounds.center[axis] += obj.velocity[axis];
+            }
+            tree.MarkMoved(obj.proxy);
+        }
+        moveMs += ElapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        reinserted += tree.Refit([](void* userData) -> const Bounds& {
+            return static_cast<Object*>(userData)->bounds;
+        });
+        refitMs += ElapsedMs(start);
+
+        // Caméra qui tourne autour du centre
+        float angle = f * 0.05f;
+        const float eye[3] = { std::cos(angle) * 800.0f, 100.0f, std::sin(angle) * 800.0f };
+        const float target[3] = { 0.0f, 0.0f, 0.0f };
+        Frustum frustum(projection * Mat4::lookAt(eye, target, up));
+
+        // Frustum : boîtes élargies dans l'arbre, puis test exact par objet
+        size_t treeCount = 0, linearCount = 0;
+        start = std::chrono::high_resolution_clock::now();
+        tree.Query(frustum, [&](void* userData) {
+            if (frustum.Intersects(static_cast<Object*>(userData)->bounds)) treeCount++;
+        });
+        treeQueryMs += ElapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (const Object& obj : objects) {
+            if (frustum.Intersects(obj.bounds)) linearCount++;
+        }
+        linearQueryMs += ElapsedMs(start);
+        visibleTree += treeCount;
+        if (treeCount != linearCount) mismatches++;
+
+        // Portée d'une lumière
+        size_t litTree = 0, litLinear = 0;
+        start = std::chrono::high_resolution_clock::now();
+        tree.QuerySphere(lightCenter, lightRadius, [&](void*) { litTree++; });
+        treeLightMs += ElapsedMs(start);
+        start = std::chrono::high_resolution_clock::now();
+        for (const Object& obj : objects) {
+            float dx = obj.bounds.center[0] - lightCenter[0];
+            float dy = obj.bounds.center[1] - lightCenter[1];
+            float dz = obj.bounds.center[2] - lightCenter[2];
+            float reach = lightRadius + obj.bounds.radius;
+            if (dx * dx + dy * dy + dz * dz <= reach * reach) litLinear++;
+        }
+        linearLightMs += ElapsedMs(start);
+
+        // Rayons depuis la caméra vers des objets tirés au hasard (au moins un
+        // impact chacun) : boîtes exactes touchées, par l'arbre puis par la liste
+        for (int r = 0; r < raysPerFrame; ++r) {
+            const Object& targetObject = objects[pickObject(rng)];
+            float direction[3], length = 0.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                direction[axis] = targetObject.bounds.center[axis] - eye[axis];
+                length += direction[axis] * direction[axis];
+            }
+            length = std::sqrt(length);
+            float inverse[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                direction[axis] /= length;
+                inverse[axis] = 1.0f / direction[axis];
+            }
+            const float maxDistance = 3000.0f;
+
+            size_t hitTree = 0, hitLinear = 0;
+            start = std::chrono::high_resolution_clock::now();
+            tree.Raycast(eye, direction, maxDistance, [&](void* userData, float&) {
+                if (RayHitsBox(static_cast<Object*>(userData)->bounds, eye, inverse, maxDistance)) hitTree++;
+            });
+            treeRayMs += ElapsedMs(start);
+            start = std::chrono::high_resolution_clock::now();
+            for (const Object& obj : objects) {
+                if (RayHitsBox(obj.bounds, eye, inverse, maxDistance)) hitLinear++;
+            }
+            linearRayMs += ElapsedMs(start);
+            hits += hitLinear;
+            if (hitTree != hitLinear || hitLinear == 0) mismatches++;
+        }
+        lit += litLinear;
+        if (litTree < litLinear) mismatches++;
+    }
+
+    std::printf("%zu moving objects, %d frames, tree height %d\n", count, frames, tree.GetHeight());
+    std::printf("build            %9.3f ms\n", buildMs);
+    std::printf("move + mark      %9.3f ms/frame\n", moveMs / frames);
+    std::printf("refit            %9.3f ms/frame (%.1f%% reinserted)\n", refitMs / frames,
+                100.0 * reinserted / (double(count) * frames));
+    std::printf("frustum  linear  %9.3f ms/frame\n", linearQueryMs / frames);
+    std::printf("frustum  tree    %9.3f ms/frame (speedup x%.1f, %zu visible/frame, %zu mismatches)\n",
+                treeQueryMs / frames, linearQueryMs / treeQueryMs, visibleTree / frames, mismatches);
+    std::printf("light    linear  %9.3f ms/frame\n", linearLightMs / frames);
+    std::printf("light    tree    %9.3f ms/frame (speedup x%.1f, %zu objects in range/frame)\n",
+                treeLightMs / frames, linearLightMs / treeLightMs, lit / frames);
+    std::printf("ray      linear  %9.3f ms/frame (%d rays)\n", linearRayMs / frames, raysPerFrame);
+    std::printf("ray      tree    %9.3f ms/frame (speedup x%.1f, %.1f boxes hit/ray)\n",
+                treeRayMs / frames, linearRayMs / treeRayMs, hits / double(frames * raysPerFrame));
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+// Benchmark du frustum culling : chemin SIMD vs chemin scalaire de référence,
+// sur des objets répartis autour de la caméra (la plupart hors champ)
+// Usage : frustum_bench.exe [objets] [frames]
+#include "../include/Bounds.h"
+#include "../include/Frustum.h"
+#include "../include/Mat4.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    // Sphères de rayon 1 placées et tournées au hasard (mêmes volumes que Mesh)
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+    std::uniform_real_distribution<float> scale(0.5f, 5.0f);
+    const float unitMin[3] = { -1.0f, -1.0f, -1.0f };
+    const float unitMax[3] = { 1.0f, 1.0f, 1.0f };
+    Bounds local = Bounds::FromBox(unitMin, unitMax, 1.0f);
+    std::vector<Bounds> objects(count);
+    for (Bounds& bounds : objects) {
+        float s = scale(rng);
+        Mat4 model = Mat4::translate(position(rng), position(rng), position(rng))
+                   * Mat4::rotate(angle(rng), 0.0f, 1.0f, 0.0f)
+                   * Mat4::scale(s, s, s);
+        bounds = local.Transform(model.data());
+    }
+
+    Mat4 projection = Mat4::perspective(45.0f * 3.14159265f / 180.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    const float eye[3] = { 0.0f, 20.0f, 50.0f };
+    const float target[3] = { 0.0f, 0.0f, 0.0f };
+    const float up[3] = { 0.0f, 1.0f, 0.0f };
+    Frustum frustum(projection * Mat4::lookAt(eye, target, up));
+
+    // Les deux chemins doivent donner le même verdict
+    size_t visible = 0, mismatches = 0;
+    for (const Bounds& bounds : objects) {
+        bool simd = frustum.Intersects(bounds);
+        if (simd != frustum.IntersectsScalar(bounds)) mismatches++;
+        if (simd) visible++;
+    }
+
+    size_t sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (const Bounds& bounds : objects) sink += frustum.IntersectsScalar(bounds);
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (const Bounds& bounds : objects) sink += frustum.Intersects(bounds);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double scalarMs = std::chrono::duration<double, std::milli>(mid - start).count() / frames;
+    double simdMs = std::chrono::duration<double, std::milli>(end - mid).count() / frames;
+
+    std::printf("%zu objects, %d frames (SIMD path: %s)\n", count, frames, Mat4::simdPath());
+    std::printf("visible %zu, culled %zu, mismatches %zu\n", visible, count - visible, mismatches);
+    std::printf("scalar  %8.3f ms/frame\n", scalarMs);
+    std::printf("simd    %8.3f ms/frame (speedup x%.2f)\n", simdMs, scalarMs / simdMs);
+    std::printf("(checksum %zu)\n", sink);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// Benchmark de la collecte des lumières émissives : parcours historique de
+// toute la scène à chaque draw vs collecte unique + LightGrid::Build
+// Usage : lightgrid_bench.exe [lumières] [frames]
+#include "../include/Mat4.h"
+#include "../include/LightGrid.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Ce que setupLighting lisait pour chaque objet de la scène
+struct SceneObject {
+    float position[3];
+    float lightColor[3];
+    float intensity;
+    bool isEmissive;
+};
+
+// Chemin historique : pour chaque draw, liste des émissifs reconstruite puis
+// tronquée à MAX_EMISSIVE_LIGHTS (10) uniforms
+float LegacyFrame(const std::vector<SceneObject>& objects) {
+    float sink = 0.0f;
+    std::vector<const SceneObject*> emissive;
+    for (size_t draw = 0; draw < objects.size(); ++draw) {
+        emissive.clear();
+        for (const SceneObject& obj : objects) {
+            if (obj.isEmissive) emissive.push_back(&obj);
+        }
+        for (size_t i = 0; i < emissive.size() && i < 10; ++i) {
+            sink += emissive[i]->position[0] + emissive[i]->intensity;
+        }
+    }
+    return sink;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    // Corps émissifs répartis dans un disque, comme des lunes autour du soleil
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> distance(5.0f, 300.0f);
+    std::uniform_real_distribution<float> height(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> intensity(0.02f, 0.2f);
+    std::vector<SceneObject> objects(count);
+    for (SceneObject& obj : objects) {
+        float a = angle(rng), d = distance(rng);
+        obj.position[0] = std::cos(a) * d;
+        obj.position[1] = height(rng);
+        obj.position[2] = std::sin(a) * d;
+        obj.lightColor[0] = 1.0f; obj.lightColor[1] = 0.8f; obj.lightColor[2] = 0.6f;
+        obj.intensity = intensity(rng);
+        obj.isEmissive = true;
+    }
+
+    Mat4 projection = Mat4::perspective(45.0f * 3.14159265f / 180.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    const float eye[3] = { 0.0f, 120.0f, 320.0f };
+    const float target[3] = { 0.0f, 0.0f, 0.0f };
+    const float up[3] = { 0.0f, 1.0f, 0.0f };
+    Mat4 view = Mat4::lookAt(eye, target, up);
+
+    // Chemin historique en O(n²) : une seule frame au-delà de quelques milliers
+    int legacyFrames = count > 2000 ? 1 : frames;
+    float sink = 0.0f;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < legacyFrames; f++) {
+        sink += LegacyFrame(objects);
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+
+    LightGrid grid;
+    std::vector<PointLight> lights;
+    for (int f = 0; f < frames; f++) {
+        lights.clear();
+        for (const SceneObject& obj : objects) {
+            if (!obj.isEmissive) continue;
+            PointLight light;
+            for (int k = 0; k < 3; k++) {
+                light.position[k] = obj.position[k];
+                light.color[k] = obj.lightColor[k];
+            }
+            light.intensity = obj.intensity;
+            light.radius = LightGrid::ComputeRadius(light.color, light.intensity);
+            if (light.radius > 0.0f) lights.push_back(light);
+        }
+        grid.Build(lights, view, projection);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double legacyMs = std::chrono::duration<double, std::milli>(mid - start).count() / legacyFrames;
+    double gridMs = std::chrono::duration<double, std::milli>(end - mid).count() / frames;
+
+    size_t nonEmpty = 0;
+    const std::vector<uint32_t>& clusters = grid.GetClusters();
+    for (int c = 0; c < LightGrid::CLUSTER_COUNT; c++) {
+        if (clusters[c * 2 + 1] > 0) nonEmpty++;
+    }
+    double averageLights = nonEmpty ? (double)grid.GetIndices().size() / nonEmpty : 0.0;
+
+    std::printf("%zu emissive lights, %d frames\n", count, frames);
+    std::printf("per-draw scan      %9.3f ms/frame (10 lights max per fragment)\n", legacyMs);
+    std::printf("gather + clusters  %9.3f ms/frame (all lights, speedup x%.1f)\n", gridMs, legacyMs / gridMs);
+    std::printf("%zu/%d clusters lit, %.1f lights per lit cluster, max %u\n",
+                nonEmpty, LightGrid::CLUSTER_COUNT, averageLights, grid.GetMaxLightsPerCluster());
+    std::printf("(checksum %f)\n", sink);
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Benchmark des niveaux de détail :
+//  - simplification QEM d'une sphère bosselée (temps, erreur à la surface exacte) ;
+//  - triangles soumis par frame pour un champ de sphères vu par une caméra qui
+//    avance, avec et sans LOD, et changements de niveau avec et sans hystérésis.
+// Usage : lod_bench.exe [triangles] [sphères] [frames]
+#include "../include/Bounds.h"
+#include "../include/LodSelector.h"
+#include "../include/MeshSimplifier.h"
+#include "../include/Vertex.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+const float PI = 3.14159265f;
+
+double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+float BumpyRadius(float phi, float theta) {
+    return 1.0f + 0.1f * std::sin(7.0f * phi) * std::cos(5.0f * theta);
+}
+
+// Même surface que PickBench : sphère UV dont le rayon varie
+void CreateBumpySphere(size_t targetTriangles, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    int stacks = std::max(2, static_cast<int>(std::sqrt(targetTriangles / 4.0)));
+    int sectors = 2 * stacks;
+    for (int i = 0; i <= stacks; ++i) {
+        float phi = PI * i / stacks;
+        for (int j = 0; j <= sectors; ++j) {
+            float theta = 2.0f * PI * j / sectors;
+            float radius = BumpyRadius(phi, theta);
+            Vertex v = {};
+            v.position[0] = radius * std::sin(phi) * std::cos(theta);
+            v.position[1] = radius * std::cos(phi);
+            v.position[2] = radius * std::sin(phi) * std::sin(theta);
+            v.uv[0] = static_cast<float>(j) / sectors;
+            v.uv[1] = static_cast<float>(i) / stacks;
+            vertices.push_back(v);
+        }
+    }
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < sectors; ++j) {
+            unsigned int a = i * (sectors + 1) + j;
+            unsigned int b = a + sectors + 1;
+            indices.insert(indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+        }
+    }
+}
+
+// Écart des sommets à la surface exacte, en fraction du rayon moyen
+void SurfaceError(const std::vector<Vertex>& vertices, double& average, double& worst) {
+    average = worst = 0.0;
+    for (const Vertex& v : vertices) {
+        const float* p = v.position;
+        float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        float phi = std::acos(std::max(-1.0f, std::min(1.0f, p[1] / length)));
+        float theta = std::atan2(p[2], p[0]);
+        double error = std::fabs(length - BumpyRadius(phi, theta));
+        average += error;
+        worst = std::max(worst, error);
+    }
+    average /= std::max<size_t>(vertices.size(), 1);
+}
+
+void BenchSimplify(size_t triangles) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    CreateBumpySphere(triangles, vertices, indices);
+    std::printf("QEM simplification, %zu triangles\n", indices.size() / 3);
+
+    // Chaîne comme à l'import : chaque niveau part du précédent
+    for (int level = 1; level <= 3; ++level) {
+        size_t target = indices.size() / 3 / 2;
+        auto start = std::chrono::high_resolution_clock::now();
+        MeshSimplifier::Result result = MeshSimplifier::Simplify(vertices, indices, target);
+        double ms = ElapsedMs(start);
+        double average, worst;
+        SurfaceError(result.vertices, average, worst);
+        std::printf("  level %d  %8zu -> %8zu triangles  %8.1f ms  error avg %.5f max %.5f\n", level,
+                    indices.size() / 3, result.indices.size() / 3, ms, average, worst);
+        vertices.swap(result.vertices);
+        indices.swap(result.indices);
+    }
+}
+
+struct Object {
+    Bounds bounds;
+    int level = 0;
+};
+
+// Sphères 32x32 de createSphere et leurs tessellations réduites (GeometryCache)
+const int LEVEL_TRIANGLES[] = { 2 * 32 * 32, 2 * 16 * 16, 2 * 8 * 8, 2 * 6 * 4 };
+const int LEVEL_COUNT = 4;
+
+void BenchSelection(int count, int frames) {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> spread(-400.0f, 400.0f);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    std::vector<Object> objects(count);
+    for (Object& object : objects) {
+        float center[3] = { spread(rng), spread(rng) * 0.1f, spread(rng) };
+        float radius = size(rng);
+        float boxMin[3], boxMax[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            boxMin[axis] = center[axis] - radius;
+            boxMax[axis] = center[axis] + radius;
+        }
+        object.bounds = Bounds::FromBox(boxMin, boxMax, radius);
+    }
+
+    // 60° de champ vertical, viewport de 1080 lignes
+    float pixelScale = 1.0f / std::tan(PI / 6.0f) * 1080.0f * 0.5f;
+    LodSelector& selector = LodSelector::Get();
+    float savedHysteresis = selector.hysteresis;
+
+    std::printf("\nLOD selection, %d spheres of %d triangles, %d frames\n", count, LEVEL_TRIANGLES[0], frames);
+    long long fullTriangles = static_cast<long long>(count) * LEVEL_TRIANGLES[0];
+    for (int pass = 0; pass < 2; ++pass) {
+        selector.hysteresis = pass == 0 ? savedHysteresis : 0.0f;
+        for (Object& object : objects) object.level = 0;
+
+        long long triangles = 0, switches = 0;
+        double selectMs = 0.0;
+        for (int frame = 0; frame < frames; ++frame) {
+            // Caméra qui avance et oscille : des objets franchissent les seuils dans les deux sens
+            float t = static_cast<float>(frame) / frames;
+            float cameraPos[3] = { 40.0f * std::sin(t * 12.0f * PI), 20.0f, -400.0f + 800.0f * t };
+            auto start = std::chrono::high_resolution_clock::now();
+            for (Object& object : objects) {
+                float diameter = LodSelector::ScreenDiameter(object.bounds, cameraPos, pixelScale);
+                int level = selector.Select(object.level, LEVEL_COUNT, diameter);
+                switches += level != object.level ? 1 : 0;
+                object.level = level;
+                triangles += LEVEL_TRIANGLES[level];
+            }
+            selectMs += ElapsedMs(start);
+        }
+        std::printf("  hysteresis %.2f  triangles/frame %10.0f (%.1f%% of %lld)  switches/frame %7.1f  select %.3f ms\n",
+                    selector.hysteresis, static_cast<double>(triangles) / frames,
+                    100.0 * triangles / frames / fullTriangles, fullTriangles,
+                    static_cast<double>(switches) / frames, selectMs / frames);
+    }
+    selector.hysteresis = savedHysteresis;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t triangles = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500000;
+    int spheres = argc > 2 ? std::atoi(argv[2]) : 10000;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 600;
+
+    BenchSimplify(triangles);
+    BenchSelection(spheres, frames);
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Micro-benchmark Mat4 : chemin SIMD vs chemin scalaire de référence
+// Usage : mat4_bench.exe [iterations]
+#include "../include/Mat4.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+const float TOLERANCE = 1e-4f;
+
+Mat4 RandomMatrix(std::mt19937& rng) {
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+    std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 4.0f);
+    // Matrices de transformation réalistes (toujours inversibles)
+    return Mat4::translate(value(rng), value(rng), value(rng))
+         * Mat4::rotate(angle(rng), value(rng), value(rng), value(rng))
+         * Mat4::scale(scale(rng), scale(rng), scale(rng));
+}
+
+float MaxRelativeError(const float* a, const float* b, int count) {
+    float maxErr = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float err = std::fabs(a[i] - b[i]) / std::max(1.0f, std::fabs(b[i]));
+        maxErr = std::max(maxErr, err);
+    }
+    return maxErr;
+}
+
+template <typename Fn>
+double TimeNs(int iterations, Fn&& fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+void Report(const char* name, double scalarNs, double simdNs) {
+    std::printf("%-16s scalar %7.2f ns   %-6s %7.2f ns   speedup x%.2f\n",
+                name, scalarNs, Mat4::simdPath(), simdNs, scalarNs / simdNs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    const int POOL = 1024;
+
+    std::mt19937 rng(42);
+    std::vector<Mat4> pool;
+    std::vector<float> points(POOL * 3);
+    for (int i = 0; i < POOL; i++) {
+        pool.push_back(RandomMatrix(rng));
+        points[i * 3 + 0] = (float)(rng() % 200) - 100.0f;
+        points[i * 3 + 1] = (float)(rng() % 200) - 100.0f;
+        points[i * 3 + 2] = (float)(rng() % 200) - 100.0f;
+    }
+
+    // 1. Validation : les deux chemins doivent concorder à la tolérance près
+    float errMul = 0.0f, errInv = 0.0f, errPoint = 0.0f;
+    for (int i = 0; i < POOL; i++) {
+        const Mat4& a = pool[i];
+        const Mat4& b = pool[(i * 7 + 3) % POOL];
+        errMul = std::max(errMul, MaxRelativeError((a * b).data(), Mat4::multiplyScalar(a, b).data(), 16));
+        errInv = std::max(errInv, MaxRelativeError(a.inverse().data(), Mat4::inverseScalar(a).data(), 16));
+
+        float simdOut[3], scalarOut[3];
+        a.transformPoint(&points[i * 3], simdOut);
+        Mat4::transformPointScalar(a, &points[i * 3], scalarOut);
+        errPoint = std::max(errPoint, MaxRelativeError(simdOut, scalarOut, 3));
+    }
+
+    std::printf("Mat4 path: %s, %d iterations\n", Mat4::simdPath(), iterations);
+    std::printf("Max relative error  multiply %.2e  inverse %.2e  transformPoint %.2e\n",
+                errMul, errInv, errPoint);
+    if (errMul > TOLERANCE || errInv > TOLERANCE || errPoint > TOLERANCE) {
+        std::printf("FAILED: SIMD results differ from scalar reference\n");
+        return 1;
+    }
+
+    // 2. Mesures ; l'accumulateur empêche le compilateur d'éliminer les calculs
+    float sink = 0.0f;
+
+    double mulScalar = TimeNs(iterations, [&] {
+        for (int i = 0; i < iterations; i++) {
+            sink += Mat4::multiplyScalar(pool[i & (POOL - 1)], pool[(i + 1) & (POOL - 1)])[5];
+        }
+    });
+    double mulSimd = TimeNs(iterations, [&] {
+        for (int i = 0; i < iterations; i++) {
+            sink += (pool[i & (POOL - 1)] * pool[(i + 1) & (POOL - 1)])[5];
+        }
+    });
+
+    double invScalar = TimeNs(iterations, [&] {
+        for (int i = 0; i < iterations; i++) {
+            sink += Mat4::inverseScalar(pool[i & (POOL - 1)])[5];
+        }
+    });
+    double invSimd = TimeNs(iterations, [&] {
+        for (int i = 0; i < iterations; i++) {
+            sink += pool[i & (POOL - 1)].inverse()[5];
+        }
+    });
+
+    float out[3];
+    double ptScalar = TimeNs(iterations, [&] {
+        for (int i = 0; i < iterations; i++) {
+            Mat4::transformPointScalar(pool[i & (POOL - 1)], &points[(i & (POOL - 1)) * 3], out);
+            sink += out[1];
+        }
+    });
+    double ptSimd = TimeNs(iterations, [&] {
+        for (int i = 0; i < iterations; i++) {
+            pool[i & (POOL - 1)].transformPoint(&points[(i & (POOL - 1)) * 3], out);
+            sink += out[1];
+        }
+    });
+
+    Report("multiply", mulScalar, mulSimd);
+    Report("inverse", invScalar, invSimd);
+    Report("transformPoint", ptScalar, ptSimd);
+    std::printf("(checksum %f)\n", sink);
+    return 0;
+}
@@ -0,0 +1,203 @@
+// Benchmark de l'import OBJ : soudure std::map (historique) vs table plate,
+// et analyse tinyobj vs analyse parallèle sur le ThreadPool
+// Usage : objimport_bench.exe [taille_grille]
+//         objimport_bench.exe --run <fichier.obj> <map|flat|value|parallel>
+// Chaque méthode tourne dans un processus séparé pour que le pic RSS soit le sien.
+#include "../include/ObjImporter.h"
+#include "../include/ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+double PeakRssMB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    // VmHWM est remis à zéro par ResetPeakRss(), contrairement à ru_maxrss
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status) {
+        char line[256];
+        while (fgets(line, sizeof(line), status)) {
+            long kb = 0;
+            if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) {
+                fclose(status);
+                return kb / 1024.0;
+            }
+        }
+        fclose(status);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+// Sous Linux, le pic de la soudure est mesuré séparément de celui de tinyobj.
+// Faux si le pic ne peut pas être remis à zéro (Windows : PeakWorkingSetSize
+// ne se réinitialise pas) : il n'y a alors qu'un pic pour tout le processus.
+bool ResetPeakRss() {
+#ifdef _WIN32
+    return false;
+#else
+    FILE* clearRefs = fopen("/proc/self/clear_refs", "w");
+    if (!clearRefs) {
+        return false;
+    }
+    bool reset = fputs("5", clearRefs) >= 0;
+    return fclose(clearRefs) == 0 && reset;
+#endif
+}
+
+// Reproduction de l'ancienne boucle de Mesh::loadFromOBJFile
+void BuildWithMap(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::shape_t>& shapes,
+                  std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    std::map<std::tuple<int, int, int>, unsigned int> vertexMap;
+    unsigned int currentIndex = 0;
+    for (const auto& shape : shapes) {
+        for (const tinyobj::index_t& idx : shape.mesh.indices) {
+            auto key = std::make_tuple(idx.vertex_index, idx.normal_index, idx.texcoord_index);
+            auto it = vertexMap.find(key);
+            if (it != vertexMap.end()) {
+                indices.push_back(it->second);
+            } else {
+                vertices.push_back(ObjImporter::MakeVertex(attrib, idx));
+                vertexMap[key] = currentIndex;
+                indices.push_back(currentIndex);
+                currentIndex++;
+            }
+        }
+    }
+}
+
+// Grille ondulée de grid x grid quads (2 triangles chacun), v/vt/vn partagés
+void WriteGridObj(const std::string& path, int grid) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        fprintf(stderr, "Cannot write %s\n", path.c_str());
+        exit(1);
+    }
+    int n = grid + 1;
+    for (int z = 0; z < n; ++z) {
+        for (int x = 0; x < n; ++x) {
+            fprintf(f, "v %g %g %g\n", (float)x, 0.25f * (float)((x * 7 + z * 3) % 5), (float)z);
+        }
+    }
+    for (int z = 0; z < n; ++z) {
+        for (int x = 0; x < n; ++x) {
+            fprintf(f, "vt %g %g\n", (float)x / grid, (float)z / grid);
+        }
+    }
+    fprintf(f, "vn 0 1 0\n");
+    for (int z = 0; z < grid; ++z) {
+        for (int x = 0; x < grid; ++x) {
+            int a = z * n + x + 1;
+            int b = a + 1;
+            int c = a + n;
+            int d = c + 1;
+            fprintf(f, "f %d/%d/1 %d/%d/1 %d/%d/1\n", a, a, c, c, b, b);
+            fprintf(f, "f %d/%d/1 %d/%d/1 %d/%d/1\n", b, b, c, c, d, d);
+        }
+    }
+    fclose(f);
+}
+
+int RunMethod(const char* path, const char* method) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    ObjParseResult parsed;
+    tinyobj::attrib_t& attrib = parsed.attrib;
+    std::vector<tinyobj::shape_t>& shapes = parsed.shapes;
+    if (strcmp(method, "parallel") == 0) {
+        std::string err;
+        if (!ObjImporter::ParseParallel(path, ThreadPool::Get(), parsed, err)) {
+            fprintf(stderr, "Failed to parse %s: %s\n", path, err.c_str());
+            return 1;
+        }
+    } else {
+        std::string warn, err;
+        if (!tinyobj::LoadObj(&attrib, &shapes, &parsed.materials, &warn, &err, path, nullptr, true)) {
+            fprintf(stderr, "Failed to parse %s: %s\n", path, err.c_str());
+            return 1;
+        }
+    }
+    double parsePeak = PeakRssMB();
+    bool peakReset = ResetPeakRss();
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    if (strcmp(method, "map") == 0) {
+        BuildWithMap(attrib, shapes, vertices, indices);
+    } else {
+        ObjImportOptions options;
+        options.weldByValue = strcmp(method, "value") == 0;
+        ObjImporter::BuildIndexedMesh(attrib, shapes, options, vertices, indices);
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    double parseMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double weldMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+    printf("%-8s parse %8.1f ms  weld %8.1f ms  total %8.1f ms  %7.1f MB/s  %9zu verts  %9zu tris  ",
+           method, parseMs, weldMs, parseMs + weldMs, megabytes * 1000.0 / (parseMs + weldMs),
+           vertices.size(), indices.size() / 3);
+    if (peakReset) {
+        printf("peak RSS parse %7.1f MB, weld %7.1f MB\n", parsePeak, PeakRssMB());
+    } else {
+        printf("peak RSS %7.1f MB (parse + weld, process peak)\n", PeakRssMB());
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && strcmp(argv[1], "--run") == 0) {
+        return RunMethod(argv[2], argv[3]);
+    }
+
+    int grid = argc > 1 ? atoi(argv[1]) : 1200;
+    std::string path = (std::filesystem::temp_directory_path() / "objimport_bench.obj").string();
+    WriteGridObj(path, grid);
+    printf("Synthetic OBJ: %d x %d grid, %d triangles, %.1f MB\n", grid, grid, 2 * grid * grid,
+           std::filesystem::file_size(path) / (1024.0 * 1024.0));
+    fflush(stdout);
+
+    printf("Thread pool: %zu threads\n", ThreadPool::Get().GetThreadCount());
+    fflush(stdout);
+
+    const char* methods[] = { "map", "flat", "value", "parallel" };
+    int result = 0;
+    for (const char* method : methods) {
+        std::string command = "\"" + std::string(argv[0]) + "\" --run \"" + path + "\" " + method;
+#ifdef _WIN32
+        // cmd /c retire le premier et le dernier guillemet de la ligne : une paire
+        // de plus autour de la commande garde ceux du chemin de l'exécutable
+        command = "\"" + command + "\"";
+#endif
+        if (std::system(command.c_str()) != 0) {
+            result = 1;
+        }
+    }
+
+    std::filesystem::remove(path);
+    return result;
+}
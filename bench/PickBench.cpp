@@ -0,0 +1,140 @@
+// Benchmark du picking : construction du TriangleBVH sur une sphère bosselée
+// de plusieurs millions de triangles, puis rayons aléatoires vers le modèle.
+// Les premiers rayons sont vérifiés contre un parcours de tous les triangles.
+// Usage : pick_bench.exe [triangles] [rayons]
+#include "../include/TriangleBVH.h"
+#include "../include/Vertex.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Sphère UV dont le rayon varie : des triangles de tailles et d'orientations variées
+void CreateBumpySphere(size_t targetTriangles, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    int stacks = std::max(2, static_cast<int>(std::sqrt(targetTriangles / 4.0)));
+    int sectors = 2 * stacks;
+    const float pi = 3.14159265f;
+    for (int i = 0; i <= stacks; ++i) {
+        float phi = pi * i / stacks;
+        for (int j = 0; j <= sectors; ++j) {
+            float theta = 2.0f * pi * j / sectors;
+            float radius = 1.0f + 0.1f * std::sin(7.0f * phi) * std::cos(5.0f * theta);
+            Vertex v = {};
+            v.position[0] = radius * std::sin(phi) * std::cos(theta);
+            v.position[1] = radius * std::cos(phi);
+            v.position[2] = radius * std::sin(phi) * std::sin(theta);
+            vertices.push_back(v);
+        }
+    }
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < sectors; ++j) {
+            unsigned int a = i * (sectors + 1) + j;
+            unsigned int b = a + sectors + 1;
+            indices.insert(indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+        }
+    }
+}
+
+// Référence : tous les triangles (Möller-Trumbore)
+bool BruteForce(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                const float* o, const float* d, float& distance) {
+    bool hit = false;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const float* a = vertices[indices[t]].position;
+        const float* b = vertices[indices[t + 1]].position;
+        const float* c = vertices[indices[t + 2]].position;
+        float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+        float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+        if (std::fabs(det) < 1e-12f) continue;
+        float inv = 1.0f / det;
+        float s[3] = { o[0] - a[0], o[1] - a[1], o[2] - a[2] };
+        float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv;
+        if (u < 0.0f || u > 1.0f) continue;
+        float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+        float v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * inv;
+        if (v < 0.0f || u + v > 1.0f) continue;
+        float tHit = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv;
+        if (tHit >= 0.0f && tHit < distance) {
+            distance = tHit;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t triangles = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+    int rays = argc > 2 ? std::atoi(argv[2]) : 10000;
+    const int checkedRays = 20;
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    CreateBumpySphere(triangles, vertices, indices);
+
+    TriangleBVH bvh;
+    auto start = std::chrono::high_resolution_clock::now();
+    bvh.Build(vertices, indices);
+    double buildMs = ElapsedMs(start);
+
+    // Rayons depuis une sphère de rayon 3 vers un point proche du modèle
+    std::mt19937 rng(22);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    double totalMs = 0.0, worstMs = 0.0;
+    int hits = 0, mismatches = 0;
+    for (int r = 0; r < rays; ++r) {
+        float origin[3], target[3], direction[3];
+        float length = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            origin[axis] = unit(rng);
+            target[axis] = 0.8f * unit(rng);
+            length += origin[axis] * origin[axis];
+        }
+        length = std::sqrt(length);
+        float directionLength = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            origin[axis] *= 3.0f / length;
+            direction[axis] = target[axis] - origin[axis];
+            directionLength += direction[axis] * direction[axis];
+        }
+        directionLength = std::sqrt(directionLength);
+        for (float& d : direction) d /= directionLength;
+
+        float distance = FLT_MAX;
+        start = std::chrono::high_resolution_clock::now();
+        bool hit = bvh.Raycast(origin, direction, distance);
+        double ms = ElapsedMs(start);
+        totalMs += ms;
+        worstMs = std::max(worstMs, ms);
+        hits += hit ? 1 : 0;
+
+        if (r < checkedRays) {
+            float reference = FLT_MAX;
+            bool referenceHit = BruteForce(vertices, indices, origin, direction, reference);
+            if (hit != referenceHit || (hit && std::fabs(distance - reference) > 1e-4f)) {
+                mismatches++;
+            }
+        }
+    }
+
+    std::printf("%zu triangles, %zu nodes (%.1f MB)\n", indices.size() / 3, bvh.GetNodeCount(),
+                bvh.GetByteSize() / (1024.0 * 1024.0));
+    std::printf("build           %9.1f ms\n", buildMs);
+    std::printf("pick  average   %9.4f ms (%d/%d hits)\n", totalMs / rays, hits, rays);
+    std::printf("pick  worst     %9.4f ms\n", worstMs);
+    std::printf("%d/%d rays checked against brute force, %d mismatches\n", checkedRays, checkedRays, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
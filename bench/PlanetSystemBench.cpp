@@ -0,0 +1,94 @@
+// Benchmark PlanetSystem (SoA, un passage) vs chemin historique par Planet
+// Usage : planetsystem_bench.exe [bodies] [frames]
+#include "../include/Mat4.h"
+#include "../include/PlanetSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Reproduction fidèle de Planet::Update / Planet::UpdateTransform :
+// cos/sin, trois Mat4, deux multiplications, écriture à travers un pointeur
+// (le Mesh* dans Planet)
+struct LegacyBody {
+    float orbitRadius;
+    float rotationSpeed;
+    float size;
+    float selfRotation = 0.0f;
+    float currentAngle = 0.0f;
+    std::unique_ptr<Mat4> transform = std::make_unique<Mat4>();
+
+    void Update(float deltaTime) {
+        currentAngle += rotationSpeed * deltaTime;
+        selfRotation += deltaTime * 0.5f;
+
+        float x = cos(currentAngle) * orbitRadius;
+        float z = sin(currentAngle) * orbitRadius;
+        Mat4 translation = Mat4::translate(x, 0.0f, z);
+        Mat4 rotation = Mat4::rotate(selfRotation, 0.0f, 1.0f, 0.0f);
+        Mat4 scale = Mat4::scale(size, size, size);
+        *transform = translation * rotation * scale;
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t bodies = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 100;
+    const float dt = 1.0f / 60.0f;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> radius(10.0f, 200.0f);
+    std::uniform_real_distribution<float> speed(0.05f, 1.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+    std::vector<LegacyBody> legacy(bodies);
+    PlanetSystem system;
+    system.Reserve(bodies);
+    for (size_t i = 0; i < bodies; i++) {
+        legacy[i].orbitRadius = radius(rng);
+        legacy[i].rotationSpeed = speed(rng);
+        legacy[i].size = size(rng);
+        system.AddBody(legacy[i].orbitRadius, legacy[i].rotationSpeed, legacy[i].size);
+    }
+
+    // Validation sur une frame (avant que les angles ne divergent par cumul)
+    for (auto& body : legacy) body.Update(dt);
+    system.Update(dt);
+    float maxErr = 0.0f;
+    for (size_t i = 0; i < bodies; i++) {
+        const float* a = legacy[i].transform->data();
+        const float* b = system.GetTransform(i);
+        for (int k = 0; k < 16; k++) {
+            maxErr = std::max(maxErr, std::fabs(a[k] - b[k]) / std::max(1.0f, std::fabs(a[k])));
+        }
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (auto& body : legacy) body.Update(dt);
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        system.Update(dt);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double total = (double)bodies * frames;
+    double legacyNs = std::chrono::duration<double, std::nano>(mid - start).count() / total;
+    double systemNs = std::chrono::duration<double, std::nano>(end - mid).count() / total;
+
+    std::printf("%zu bodies, %d frames (Mat4 path: %s)\n", bodies, frames, Mat4::simdPath());
+    std::printf("Max relative error vs per-Planet path: %.2e\n", maxErr);
+    std::printf("per-Planet   %7.2f ns/body  (%.3f ms/frame)\n", legacyNs, legacyNs * bodies * 1e-6);
+    std::printf("PlanetSystem %7.2f ns/body  (%.3f ms/frame)  speedup x%.2f\n",
+                systemNs, systemNs * bodies * 1e-6, legacyNs / systemNs);
+    std::printf("(checksum %f)\n", legacy[bodies / 2].transform->data()[12] + system.GetTransform(bodies / 2)[12]);
+    return maxErr > 1e-4f ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// Volumes englobants d'un mesh : boîte alignée sur les axes et sphère.
+// La sphère sert au rejet rapide, la boîte au test précis.
+struct Bounds {
+    float min[3] = {0.0f, 0.0f, 0.0f};
+    float max[3] = {0.0f, 0.0f, 0.0f};
+    float center[3] = {0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;
+
+    // Boîte + sphère centrée sur la boîte, de rayon donné
+    static Bounds FromBox(const float* boxMin, const float* boxMax, float sphereRadius);
+
+    // Volumes en espace monde pour une matrice modèle (column-major) :
+    // boîte englobant la boîte transformée, rayon multiplié par la plus
+    // grande échelle de la matrice
+    Bounds Transform(const float* matrix) const;
+};
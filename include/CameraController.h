@@ -1,6 +1,7 @@
 #pragma once
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include "Mat4.h"
 
 class CameraController {
 public:
@@ -22,6 +23,9 @@ public:
     bool IsEnabled() const { return m_Enabled; }
     bool IsCursorLocked() const { return m_CursorLocked; }
 
+    // Rayon monde passant par le curseur (direction normalisée), pour le picking
+    void GetCursorRay(const Mat4& projection, const Mat4& view, float* origin, float* direction) const;
+
     // Callback statique pour GLFW
     static void MouseCallback(GLFWwindow* window, double xpos, double ypos);
     
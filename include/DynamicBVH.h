@@ -0,0 +1,142 @@
+#pragma once
+#include <vector>
+#include "Bounds.h"
+#include "Frustum.h"
+
+// Arbre de boîtes englobantes dynamique (insertion par coût de surface,
+// rotations pour garder l'arbre équilibré). Chaque feuille garde une boîte
+// élargie : un objet qui bouge un peu ne modifie pas l'arbre, il n'est
+// réinséré que lorsqu'il sort de sa boîte.
+// Les objets déplacés sont signalés par MarkMoved puis recalés ensemble par
+// Refit, une fois par frame.
+class DynamicBVH {
+public:
+    static const int NULL_NODE = -1;
+
+    DynamicBVH();
+
+    // Renvoie l'identifiant de la feuille (stable jusqu'à Remove)
+    int Insert(const Bounds& bounds, void* userData);
+    void Remove(int proxy);
+    // Vrai si la feuille a dû être réinsérée (sortie de sa boîte et de celle de son parent)
+    bool Move(int proxy, const Bounds& bounds);
+    void Clear();
+
+    void MarkMoved(int proxy);
+    // getBounds(userData) : volumes monde à jour de l'objet.
+    // Renvoie le nombre de feuilles réinsérées.
+    template <typename F>
+    int Refit(F&& getBounds) {
+        int reinserted = 0;
+        for (int proxy : m_Moved) {
+            Node& node = m_Nodes[proxy];
+            if (!node.moved) {
+                continue;   // supprimé depuis
+            }
+            node.moved = false;
+            if (Move(proxy, getBounds(node.userData))) {
+                reinserted++;
+            }
+        }
+        m_Moved.clear();
+        return reinserted;
+    }
+
+    void* GetUserData(int proxy) const { return m_Nodes[proxy].userData; }
+    int GetHeight() const { return m_Root == NULL_NODE ? 0 : m_Nodes[m_Root].height; }
+    int GetProxyCount() const { return m_ProxyCount; }
+
+    // visit(userData) pour chaque feuille dont la boîte élargie touche le frustum.
+    // L'appelant teste ensuite les volumes exacts de l'objet s'il le souhaite.
+    template <typename F>
+    void Query(const Frustum& frustum, F&& visit) const {
+        Traverse([&](const Node& node) { return frustum.ClassifyBox(node.min, node.max); }, visit);
+    }
+
+    // Feuilles touchant une sphère (portée d'une lumière...)
+    template <typename F>
+    void QuerySphere(const float* center, float radius, F&& visit) const {
+        Traverse([&](const Node& node) {
+            return SphereOverlaps(node, center, radius) ? Frustum::INTERSECTING : Frustum::OUTSIDE;
+        }, visit);
+    }
+
+    // Feuilles traversées par le rayon origin + t * direction, t dans [0, maxDistance].
+    // visit(userData, maxDistance) peut réduire maxDistance (impact plus proche trouvé).
+    template <typename F>
+    void Raycast(const float* origin, const float* direction, float maxDistance, F&& visit) const {
+        float inverse[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            inverse[axis] = 1.0f / direction[axis];
+        }
+        Traverse([&](const Node& node) {
+            return RayOverlaps(node, origin, inverse, maxDistance) ? Frustum::INTERSECTING : Frustum::OUTSIDE;
+        }, [&](void* userData) { visit(userData, maxDistance); });
+    }
+
+private:
+    struct Node {
+        float min[3];       // boîte élargie pour les feuilles
+        float max[3];
+        void* userData = nullptr;
+        int parent = NULL_NODE;     // suivant dans la liste libre si le nœud est libre
+        int child1 = NULL_NODE;
+        int child2 = NULL_NODE;
+        int height = -1;    // 0 : feuille, -1 : libre
+        bool moved = false;
+
+        bool IsLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    // Parcours en profondeur ; sous un nœud INSIDE, plus aucun test
+    template <typename Test, typename F>
+    void Traverse(Test&& test, F&& visit) const {
+        if (m_Root == NULL_NODE) {
+            return;
+        }
+        m_Stack.clear();
+        m_Stack.push_back(m_Root << 1);
+        while (!m_Stack.empty()) {
+            int entry = m_Stack.back();
+            m_Stack.pop_back();
+            const Node& node = m_Nodes[entry >> 1];
+            int inside = entry & 1;
+            if (!inside) {
+                Frustum::Containment containment = test(node);
+                if (containment == Frustum::OUTSIDE) {
+                    continue;
+                }
+                inside = containment == Frustum::INSIDE ? 1 : 0;
+            }
+            if (node.IsLeaf()) {
+                visit(node.userData);
+            } else {
+                m_Stack.push_back((node.child1 << 1) | inside);
+                m_Stack.push_back((node.child2 << 1) | inside);
+            }
+        }
+    }
+
+    static bool Contains(const Node& node, const Node& inner);
+    static bool SphereOverlaps(const Node& node, const float* center, float radius);
+    static bool RayOverlaps(const Node& node, const float* origin, const float* inverseDirection, float maxDistance);
+    static float UnionArea(const Node& a, const Node& b);
+    static float Area(const Node& node);
+    static void SetUnion(Node& node, const Node& a, const Node& b);
+
+    int AllocateNode();
+    void FreeNode(int node);
+    void SetFatBounds(int leaf, const Bounds& bounds, const float* displacement);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    // Rotation autour de a si ses deux enfants diffèrent de plus d'un niveau
+    int Balance(int a);
+    void RefitAncestors(int node);
+
+    std::vector<Node> m_Nodes;
+    int m_Root;
+    int m_FreeList;
+    int m_ProxyCount;
+    std::vector<int> m_Moved;
+    mutable std::vector<int> m_Stack;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "Bounds.h"
+#include "Mat4.h"
+
+// Six plans du volume de vue, extraits de projection * view (Gribb-Hartmann).
+// Les plans sont rangés par composante (x de tous les plans, puis y...) pour
+// tester quatre plans à la fois en SSE.
+// Un Frustum construit par défaut accepte tout.
+class Frustum {
+public:
+    Frustum();
+    explicit Frustum(const Mat4& viewProjection);
+
+    // Faux si les volumes sont entièrement hors d'un plan : sphère d'abord,
+    // puis sommet de la boîte le plus avancé vers chaque plan
+    bool Intersects(const Bounds& bounds) const;
+
+    // Chemin scalaire de référence, pour valider le chemin SIMD
+    bool IntersectsScalar(const Bounds& bounds) const;
+
+    // Boîte seule, pour les nœuds d'une hiérarchie : un nœud entièrement
+    // dedans n'a plus besoin de tester ses enfants
+    enum Containment { OUTSIDE, INTERSECTING, INSIDE };
+    Containment ClassifyBox(const float* boxMin, const float* boxMax) const;
+
+    static const int PLANE_COUNT = 6;
+
+private:
+    // 8 entrées : deux groupes de 4, les deux dernières n'excluent rien
+    alignas(16) float m_X[8];
+    alignas(16) float m_Y[8];
+    alignas(16) float m_Z[8];
+    alignas(16) float m_W[8];
+};
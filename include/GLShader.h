@@ -2,29 +2,96 @@
 
 #include <GL/glew.h>
 #include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "GLStateCache.h"
+
+// Uniforms utilisés par le rendu, résolus une seule fois au link du programme
+enum class Uniform {
+	Projection,
+	View,
+	Transform,
+	ViewPos,
+	Texture,
+	HasTexture,
+	Intensity,
+	EnvMap,
+	Skybox,
+	LightDirection,
+	LightDiffuseColor,
+	LightSpecularColor,
+	MaterialIndex,
+	Lights,
+	ClusterLights,
+	LightIndices,
+	ClusterGrid,
+	ClusterTileSize,
+	ClusterDepth,
+	DrawOffset,
+	Count
+};
+
+// Locations des uniforms actifs d'un programme lié, remplies par GLShader::ReflectUniforms()
+struct ProgramReflection {
+	std::unordered_map<std::string, GLint> uniformLocations;
+	GLint locations[static_cast<int>(Uniform::Count)];
+
+	ProgramReflection() {
+		for (GLint& location : locations) location = -1;
+	}
+};
+
+// Étages d'un programme, dans l'ordre de ProgramSources
+enum class ShaderStage {
+	Vertex,
+	Geometry,
+	Fragment,
+	Count
+};
+
+// Sources GLSL d'un programme et fichiers d'où elles viennent (chemins
+// canoniques, pour le rechargement à chaud). Le geometry shader est optionnel.
+struct ProgramSources {
+	std::string code[static_cast<int>(ShaderStage::Count)];
+	std::string paths[static_cast<int>(ShaderStage::Count)];
+
+	const std::string& Get(ShaderStage stage) const { return code[static_cast<int>(stage)]; }
+};
 
 class GLShader
 {
 private:
-	// un programme fait le liens entre Vertex Shader et Fragment Shader
-	uint32_t m_Program;
-	// Un Vertex Shader est execute pour chaque sommet (vertex)
-	uint32_t m_VertexShader;
-	// Un Geometry Shader est execute pour chaque primitive
-	uint32_t m_GeometryShader;
-	// Un Fragment Shader est execute pour chaque "pixel"
-	// lors de la rasterization/remplissage de la primitive
-	uint32_t m_FragmentShader;
-
-	bool CompileShader(uint32_t type);
+	// un programme fait le liens entre Vertex Shader et Fragment Shader.
+	// Il appartient au ProgramRegistry et peut être partagé par plusieurs GLShader ;
+	// il n'est lié qu'au premier usage (Use, GetProgram, locations).
+	mutable uint32_t m_Program;
+	// Génération du registre vue au dernier EnsureLinked() ; 0 : jamais lié.
+	// Un rechargement à chaud incrémente s_ProgramGeneration et force la relecture.
+	mutable uint32_t m_Generation;
+	// Clé du programme dans le registre (hash des sources), 0 si non créé
+	uint64_t m_ProgramKey;
+
+	// Sources chargées par Load*Shader(), compilées par Create() si le registre
+	// ne connaît pas encore ce programme
+	ProgramSources m_Sources;
+
+	// Copie locale des locations (les uniforms inconnus y sont mémorisés à -1)
+	mutable ProgramReflection m_Reflection;
+
+	void EnsureLinked() const;
+	bool LoadStage(ShaderStage stage, const char* filename);
+
 public:
-	GLShader() : m_Program(0), m_VertexShader(0),
-		m_GeometryShader(0), m_FragmentShader(0) {
+	// Incrémenté par le ProgramRegistry chaque fois qu'un programme est remplacé
+	static uint32_t s_ProgramGeneration;
 
-	}
+	GLShader() : m_Program(0), m_Generation(0), m_ProgramKey(0) {}
 	~GLShader() {}
 
-	inline uint32_t GetProgram() { return m_Program; }
+	// Interroge le driver une fois pour tous les uniforms actifs de program
+	static void ReflectUniforms(GLuint program, ProgramReflection& reflection);
+
+	inline uint32_t GetProgram() const { if (m_Generation != s_ProgramGeneration) EnsureLinked(); return m_Program; }
 
 	bool LoadVertexShader(const char* filename);
 	bool LoadGeometryShader(const char* filename);
@@ -32,7 +99,7 @@ public:
 	bool Create();
 	void Destroy();
 
-	void Use() const { glUseProgram(m_Program); }
+	void Use() const { if (m_Generation != s_ProgramGeneration) EnsureLinked(); GLStateCache::Get().UseProgram(m_Program); }
 
 	// Ajout des méthodes pour gérer les uniformes
 	void SetBool(const char* name, bool value);
@@ -42,6 +109,10 @@ public:
 	void SetVec4(const char* name, const float* value);
 	void SetMat4(const char* name, const float* value);
 
-	// Méthode pour récupérer la location d'un uniform
+	// Méthode pour récupérer la location d'un uniform (cache, pas d'appel driver)
 	GLint GetUniformLocation(const char* name) const;
+	GLint GetLocation(Uniform uniform) const {
+		if (m_Generation != s_ProgramGeneration) EnsureLinked();
+		return m_Reflection.locations[static_cast<int>(uniform)];
+	}
 };
\ No newline at end of file
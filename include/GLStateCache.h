@@ -0,0 +1,72 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+
+// Copie côté CPU de l'état GL lié (programme, VAO, textures par unité,
+// buffers, capacités glEnable). Un appel qui ne change rien n'atteint pas le
+// driver ; RenderStats compte les appels émis et évités.
+// Tout le code du renderer passe par ce cache. Le code qui touche l'état sans
+// lui (ImGui, un contexte recréé) doit être suivi d'un Invalidate().
+// GL_ELEMENT_ARRAY_BUFFER fait partie du VAO : il n'est pas suivi ici.
+class GLStateCache {
+public:
+    static GLStateCache& Get();
+
+    // Oublie tout : le prochain appel de chaque sorte sera émis
+    void Invalidate();
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    // Active l'unité si besoin puis lie la texture sur la cible
+    void BindTexture(GLuint unit, GLenum target, GLuint texture);
+    void BindBuffer(GLenum target, GLuint buffer);
+    // Liaisons indexées : changent aussi la liaison générique de la cible
+    void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+    void Enable(GLenum cap) { SetEnabled(cap, true); }
+    void Disable(GLenum cap) { SetEnabled(cap, false); }
+    void SetEnabled(GLenum cap, bool enabled);
+    bool IsEnabled(GLenum cap);
+
+    // Suppressions : un nom libéré peut être réattribué par glGen*, ses
+    // liaisons connues doivent être oubliées
+    void DeleteProgram(GLuint program);
+    void DeleteVertexArrays(GLsizei count, const GLuint* vaos);
+    void DeleteTextures(GLsizei count, const GLuint* textures);
+    void DeleteBuffers(GLsizei count, const GLuint* buffers);
+
+    static const GLuint MAX_TEXTURE_UNITS = 16;
+    static const GLuint MAX_UNIFORM_BINDINGS = 8;
+
+private:
+    GLStateCache() { Invalidate(); }
+    GLStateCache(const GLStateCache&) = delete;
+    GLStateCache& operator=(const GLStateCache&) = delete;
+
+    enum TextureTarget { TEX_2D, TEX_CUBE_MAP, TEX_BUFFER, TEX_TARGET_COUNT };
+    enum BufferTarget { BUF_ARRAY, BUF_UNIFORM, BUF_TEXTURE, BUF_PIXEL_UNPACK, BUF_DRAW_INDIRECT, BUF_TARGET_COUNT };
+    enum Capability { CAP_DEPTH_TEST, CAP_CULL_FACE, CAP_BLEND, CAP_SCISSOR_TEST, CAP_STENCIL_TEST, CAP_COUNT };
+
+    struct IndexedBinding {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;    // -1 : glBindBufferBase
+    };
+
+    static int TextureTargetIndex(GLenum target);
+    static int BufferTargetIndex(GLenum target);
+    static int CapabilityIndex(GLenum cap);
+
+    void ActiveTexture(GLuint unit);
+    void Skipped();
+    void Issued();
+
+    GLuint m_Program;
+    GLuint m_VAO;
+    GLuint m_ActiveUnit;
+    GLuint m_Textures[MAX_TEXTURE_UNITS][TEX_TARGET_COUNT];
+    GLuint m_Buffers[BUF_TARGET_COUNT];
+    IndexedBinding m_UniformBindings[MAX_UNIFORM_BINDINGS];
+    int8_t m_Capabilities[CAP_COUNT];   // -1 inconnu, 0 désactivé, 1 activé
+};
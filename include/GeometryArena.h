@@ -0,0 +1,98 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RangeAllocator.h"
+#include "Vertex.h"
+
+// Place d'une géométrie dans l'arène, telle qu'attendue par glDrawElementsBaseVertex
+// ou une commande de draw indirect (baseVertex, firstIndex, count)
+struct ArenaRange {
+    GLint baseVertex = 0;
+    GLuint vertexCount = 0;
+    GLuint firstIndex = 0;
+    GLsizei indexCount = 0;
+
+    bool IsValid() const { return indexCount > 0; }
+};
+
+// Poignée d'une allocation : sa place peut changer (Defragment), la poignée non
+using ArenaHandle = uint32_t;
+static const ArenaHandle INVALID_ARENA_HANDLE = UINT32_MAX;
+
+// Un VBO et un EBO partagés par toutes les géométries, sous-alloués par
+// RangeAllocator, et un seul VAO pour le format Vertex : les meshes se
+// dessinent sans changer de VAO (glDrawElementsBaseVertex), ou tous ensemble
+// par glMultiDrawElementsIndirect.
+// Un buffer plein est remplacé par un buffer deux fois plus grand (copie GPU) ;
+// Defragment recopie les allocations bout à bout. Dans les deux cas
+// GetGeneration change et les autres VAO qui pointent sur l'arène doivent être refaits.
+class GeometryArena {
+public:
+    struct Stats {
+        size_t liveAllocations = 0;
+        size_t totalAllocations = 0;    // depuis le lancement
+        size_t frees = 0;
+        size_t defragmentations = 0;
+        size_t bytesUsed = 0;           // sommets + index vivants
+        size_t bytesReserved = 0;       // taille des deux buffers
+        size_t holeBytes = 0;           // trous entre allocations
+        size_t holeCount = 0;
+        float fragmentation = 0.0f;     // pire des deux buffers (voir RangeAllocator)
+    };
+
+    static GeometryArena& Get();
+
+    void Cleanup();
+
+    ArenaHandle Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    void Free(ArenaHandle handle);
+    // Place courante ; invalide pour INVALID_ARENA_HANDLE
+    ArenaRange GetRange(ArenaHandle handle) const;
+
+    // Compacte les deux buffers (à appeler entre deux frames)
+    void Defragment();
+
+    GLuint GetVertexArray() const { return m_VAO; }
+    GLuint GetVertexBuffer() const { return m_Vertices.buffer; }
+    GLuint GetIndexBuffer() const { return m_Indices.buffer; }
+    unsigned int GetGeneration() const { return m_Generation; }
+
+    // Attributs 0 à 2 (Vertex) et EBO de l'arène sur le VAO actif
+    void SetupVertexArray() const;
+
+    Stats GetStats() const;
+
+private:
+    GeometryArena() = default;
+    ~GeometryArena() = default;
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    // Un buffer GL et son allocateur, en éléments (Vertex ou index)
+    struct Region {
+        GLuint buffer = 0;
+        size_t elementSize = 0;
+        RangeAllocator allocator;
+    };
+
+    size_t AllocateIn(Region& region, size_t count);
+    void Resize(Region& region, size_t capacity);
+    void Upload(Region& region, size_t offset, const void* data, size_t count);
+    void Compact(Region& region, bool vertices);
+    void BuffersChanged();
+
+    Region m_Vertices;
+    Region m_Indices;
+    GLuint m_VAO = 0;
+    std::vector<ArenaRange> m_Ranges;           // par poignée
+    std::vector<ArenaHandle> m_FreeHandles;
+    size_t m_TotalAllocations = 0;
+    size_t m_Frees = 0;
+    size_t m_Defragmentations = 0;
+    unsigned int m_Generation = 0;
+
+    static const size_t INITIAL_VERTICES = 1 << 16;
+    static const size_t INITIAL_INDICES = 3 << 16;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include <GL/glew.h>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GeometryArena.h"
+#include "Mesh.h"
+#include "TriangleBVH.h"
+
+// Géométrie partagée entre plusieurs meshes : place dans la GeometryArena + copie CPU
+struct MeshGeometry {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    // Sommets et index sur le GPU, INVALID_ARENA_HANDLE avant Upload()
+    ArenaHandle arenaHandle = INVALID_ARENA_HANDLE;
+
+    // Boîte englobante en espace objet, et rayon de la sphère centrée sur la boîte
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+    float boundsRadius = 0.0f;
+
+    // Matériau lu dans le .mtl (OBJ uniquement), la texture reste à charger
+    bool hasSourceMaterial = false;
+    Material sourceMaterial;
+    std::string texturePath;
+
+    // Niveaux de détail plus grossiers (1, 2, ...) : tessellations réduites pour
+    // les sphères, simplification QEM pour les OBJ. Le niveau 0 est cette géométrie.
+    std::vector<std::shared_ptr<MeshGeometry>> lods;
+
+    MeshGeometry() = default;
+    ~MeshGeometry();
+    MeshGeometry(const MeshGeometry&) = delete;
+    MeshGeometry& operator=(const MeshGeometry&) = delete;
+
+    void Upload();
+    void ComputeBounds();
+    size_t GetByteSize() const;
+
+    int GetLevelCount() const { return 1 + static_cast<int>(lods.size()); }
+    const MeshGeometry& GetLevel(int level) const;
+
+    // Hiérarchie des triangles pour le picking, construite sur le ThreadPool
+    // (plusieurs secondes pour des millions de triangles). nullptr tant qu'elle
+    // n'est pas prête : le premier appel lance la construction.
+    const TriangleBVH* GetTriangleBVH();
+    void RequestTriangleBVH();
+
+private:
+    TriangleBVH m_TriangleBVH;
+    std::future<void> m_TriangleBVHBuild;
+    std::atomic<bool> m_TriangleBVHReady{false};
+};
+
+// Cache de géométries indexé par (générateur, paramètres) ou par chemin OBJ.
+// Les entrées sont des weak_ptr : la géométrie est libérée avec son dernier mesh.
+class GeometryCache {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t bytesSaved = 0;     // octets qu'auraient coûté les copies évitées
+        size_t liveEntries = 0;
+        size_t residentBytes = 0;
+    };
+
+    static GeometryCache& Get();
+
+    std::shared_ptr<MeshGeometry> GetSphere(float radius, int sectors, int stacks);
+    std::shared_ptr<MeshGeometry> GetOBJ(const std::string& filename, const ObjImportOptions& options = ObjImportOptions());
+
+    // Import en deux temps : LoadOBJGeometry ne touche pas à OpenGL et peut tourner
+    // sur un thread de travail ; AdoptOBJ (thread de rendu) envoie les buffers au GPU
+    // et enregistre l'entrée, ou renvoie celle déjà présente pour ce fichier.
+    static std::shared_ptr<MeshGeometry> LoadOBJGeometry(const std::string& filename, const ObjImportOptions& options);
+    std::shared_ptr<MeshGeometry> AdoptOBJ(const std::string& filename, const ObjImportOptions& options,
+                                           const std::shared_ptr<MeshGeometry>& geometry);
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    GeometryCache() = default;
+    ~GeometryCache() = default;
+    GeometryCache(const GeometryCache&) = delete;
+    GeometryCache& operator=(const GeometryCache&) = delete;
+
+    static const int MAX_LOD_LEVELS = 3;
+    static const size_t MIN_LOD_TRIANGLES = 64;
+
+    std::shared_ptr<MeshGeometry> Find(const std::string& key);
+    void Insert(const std::string& key, const std::shared_ptr<MeshGeometry>& geometry);
+
+    static void BuildSphere(float radius, int sectors, int stacks, MeshGeometry& geometry);
+    static void BuildSphereLODs(float radius, int sectors, int stacks, MeshGeometry& geometry);
+    static void BuildSimplifiedLODs(MeshGeometry& geometry);
+    static std::string MakeOBJKey(const std::string& filename, const ObjImportOptions& options);
+    static bool ParseOBJ(const std::string& filename, const ObjImportOptions& options, MeshGeometry& geometry);
+    static void SelectSourceMaterial(const std::vector<tinyobj::material_t>& materials, const std::string& baseDir,
+                                     MeshGeometry& geometry);
+    static void CalculateNormalsIfNeeded(MeshGeometry& geometry);
+
+    std::unordered_map<std::string, std::weak_ptr<MeshGeometry>> m_Entries;
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+    size_t m_BytesSaved = 0;
+};
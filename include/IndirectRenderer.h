@@ -0,0 +1,90 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "GLShader.h"
+#include "Mesh.h"
+
+// Commande lue par glMultiDrawElementsIndirect (layout imposé par OpenGL)
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;    // index du draw dans la frame (voir BasicIndirect.vs)
+};
+
+// Données par draw lues par BasicIndirect.vs (SSBO std430 "DrawStorage")
+struct IndirectDrawData {
+    float model[16];
+    uint32_t material;      // slot dans MaterialBuffer
+    uint32_t hasTexture;
+    uint32_t padding[2];
+};
+static_assert(sizeof(IndirectDrawData) == 80, "IndirectDrawData doit suivre le layout std430 du shader");
+
+// Soumission GPU des meshes dont la géométrie est dans la GeometryArena :
+// une commande et une entrée DrawStorage par objet, envoyées en deux
+// transferts, puis un glMultiDrawElementsIndirect par texture. Le shader
+// retrouve matrice et matériau par l'index du draw (gl_DrawIDARB, ou
+// baseInstance sans GL_ARB_shader_draw_parameters).
+// Demande OpenGL 4.3 (ou les extensions équivalentes) : sinon IsSupported()
+// est faux et les scènes gardent le chemin RenderQueue.
+class IndirectRenderer {
+public:
+    IndirectRenderer() = default;
+    ~IndirectRenderer() = default;
+    IndirectRenderer(const IndirectRenderer&) = delete;
+    IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+    static bool IsSupported();
+
+    // Bascule globale (UI, benchmark) : désactivé, Submit refuse tout
+    static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+    static bool IsEnabled() { return s_Enabled; }
+
+    bool Initialize(const std::string& vertexPath, const std::string& fragmentPath);
+    void Cleanup();
+    // Programme lié compris, comme InstancedRenderer
+    bool IsInitialized() const { return m_CommandBuffer != 0 && m_Shader.GetProgram() != 0; }
+
+    // Le programme doit être actif et éclairé par la scène avant Flush()
+    GLShader& GetShader() { return m_Shader; }
+
+    void Begin();
+    // Faux si la géométrie du mesh n'est pas dans l'arène (à dessiner autrement)
+    bool Submit(Mesh* mesh);
+    void Flush();
+
+    // Bindings des SSBO, fixés dans BasicIndirect.vs
+    static const GLuint DRAW_DATA_BINDING = 0;
+    static const GLuint MATERIAL_STORAGE_BINDING = 1;
+
+private:
+    struct Batch {
+        std::vector<DrawElementsIndirectCommand> commands;
+        std::vector<IndirectDrawData> draws;
+    };
+
+    void SetupVertexArray();
+    static void Upload(GLenum target, GLuint buffer, size_t& capacity, const void* data, size_t bytes);
+
+    GLShader m_Shader;
+    GLuint m_VAO = 0;
+    GLuint m_CommandBuffer = 0;
+    GLuint m_DrawDataBuffer = 0;
+    GLuint m_DrawIndexBuffer = 0;   // 0, 1, 2... lu par instance avec baseInstance
+    size_t m_CommandCapacity = 0;
+    size_t m_DrawDataCapacity = 0;
+    size_t m_DrawIndexCount = 0;
+    unsigned int m_ArenaGeneration = 0;
+
+    // Par texture ; les batches (et leur capacité) sont gardés d'une frame à l'autre
+    std::map<GLuint, Batch> m_Batches;
+    std::vector<DrawElementsIndirectCommand> m_Commands;
+    std::vector<IndirectDrawData> m_Draws;
+
+    static bool s_Enabled;
+};
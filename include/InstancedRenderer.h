@@ -0,0 +1,63 @@
+#pragma once
+#include <GL/glew.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GLShader.h"
+#include "Mesh.h"
+
+// Données par instance, lues par BasicInstanced.vs (locations 3 à 10)
+struct InstanceData {
+    float model[16];     // locations 3-6
+    float diffuse[4];    // rgb + shininess
+    float specular[4];   // rgb + specularStrength
+    float emissive[4];   // lightColor rgb + emissiveIntensity
+    float params[4];     // illuminationModel, isEmissive, hasTexture, inutilisé
+};
+
+// Regroupe les sphères qui partagent la même géométrie (même place dans la
+// GeometryArena via GeometryCache) et la même texture, puis les dessine avec
+// un glDrawElementsInstancedBaseVertex par groupe
+class InstancedRenderer {
+public:
+    InstancedRenderer();
+    ~InstancedRenderer();
+
+    bool Initialize(const std::string& vertexPath, const std::string& fragmentPath);
+    void Cleanup();
+    // Programme lié compris (premier appel : link différé) : un shader qui ne
+    // compile pas laisse Submit refuser, et les objets passent par draw
+    bool IsInitialized() const { return m_InstanceVBO != 0 && m_Shader.GetProgram() != 0; }
+
+    // Le programme doit être actif et éclairé par la scène avant Flush()
+    GLShader& GetShader() { return m_Shader; }
+
+    void Begin();
+    // Ajoute un mesh sphérique avec sa matrice et son matériau courants
+    bool Submit(Mesh* mesh);
+    // Ajoute plusieurs instances d'un même mesh avec un matériau commun
+    void SubmitInstances(const Mesh* mesh, const float* transforms, size_t count, const Material& material);
+    void Flush();
+
+private:
+    // (premier index dans l'arène, texture)
+    using GroupKey = std::pair<GLuint, GLuint>;
+
+    struct Group {
+        ArenaRange range;
+        GLuint texture = 0;
+        std::vector<InstanceData> instances;
+    };
+
+    Group& GetGroup(const Mesh* mesh, GLuint texture);
+    static void FillMaterial(InstanceData& instance, const Material& material, bool hasTexture);
+    // Attributs d'instance 3 à 10 à partir de offset dans le buffer d'instances
+    static void SetInstancePointers(size_t offset);
+
+    GLShader m_Shader;
+    GLuint m_InstanceVBO;
+    size_t m_InstanceCapacity;
+    std::map<GroupKey, Group> m_Groups;
+    std::vector<InstanceData> m_Upload;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Conteneur KTX2 limité aux formats compressés par blocs BC1/BC3/BC7,
+// sans supercompression. Partagé entre le chargeur et l'outil hors ligne.
+namespace KTX2 {
+    // Valeurs VkFormat utilisées dans l'en-tête
+    enum Format : uint32_t {
+        BC1_RGB_UNORM = 131,
+        BC1_RGB_SRGB = 132,
+        BC1_RGBA_UNORM = 133,
+        BC1_RGBA_SRGB = 134,
+        BC3_UNORM = 137,
+        BC3_SRGB = 138,
+        BC7_UNORM = 145,
+        BC7_SRGB = 146
+    };
+
+    struct Image {
+        uint32_t format = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t faceCount = 1;   // 6 pour un cubemap (+X -X +Y -Y +Z -Z)
+        // levels[i] : blocs du niveau i, faces concaténées ; niveau 0 = pleine résolution
+        std::vector<std::vector<unsigned char>> levels;
+
+        uint32_t GetLevelWidth(size_t level) const;
+        uint32_t GetLevelHeight(size_t level) const;
+        size_t GetFaceSize(size_t level) const { return levels[level].size() / faceCount; }
+        const unsigned char* GetFaceData(size_t level, uint32_t face) const {
+            return levels[level].data() + face * GetFaceSize(level);
+        }
+        size_t GetByteSize() const;
+    };
+
+    // Octets par bloc 4x4, 0 si le format n'est pas géré
+    size_t GetBlockBytes(uint32_t format);
+    bool IsSRGB(uint32_t format);
+    size_t GetLevelByteSize(uint32_t format, uint32_t width, uint32_t height);
+
+    // Lecture de l'en-tête seul (format, dimensions, faces) : rapide, sans les blocs
+    bool ReadHeader(const std::string& path, Image& header);
+    bool Load(const std::string& path, Image& image, std::string& error);
+    bool Save(const std::string& path, const Image& image, std::string& error);
+}
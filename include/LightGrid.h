@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Mat4.h"
+
+// Lumière ponctuelle telle qu'envoyée aux shaders : deux texels RGBA32F
+struct PointLight {
+    float position[3];   // monde
+    float radius;        // au-delà, contribution négligeable
+    float color[3];
+    float intensity;
+};
+static_assert(sizeof(PointLight) == 32, "PointLight doit tenir dans deux texels RGBA32F");
+
+// Découpage de la pyramide de vue en clusters (tuiles écran x tranches de
+// profondeur exponentielles) et liste des lumières qui touchent chaque cluster.
+// Pur CPU : LightManager envoie le résultat au GPU, le benchmark l'utilise seul.
+class LightGrid {
+public:
+    static const int TILES_X = 16;
+    static const int TILES_Y = 9;
+    static const int SLICES = 24;
+    static const int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+
+    // Distance où l'atténuation des shaders fait tomber la lumière sous 1/256
+    static float ComputeRadius(const float* color, float intensity);
+
+    // view/projection : matrices de la caméra (perspective de Mat4::perspective)
+    void Build(const std::vector<PointLight>& lights, const Mat4& view, const Mat4& projection);
+
+    // Deux entiers par cluster : début dans GetIndices(), nombre de lumières
+    const std::vector<uint32_t>& GetClusters() const { return m_Clusters; }
+    const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+
+    // Tranche = log(profondeur) * scale + bias
+    float GetSliceScale() const { return m_SliceScale; }
+    float GetSliceBias() const { return m_SliceBias; }
+    uint32_t GetMaxLightsPerCluster() const { return m_MaxPerCluster; }
+
+private:
+    // Clusters couverts par une lumière, bornes incluses
+    struct Range {
+        int x0, x1, y0, y1, z0, z1;
+    };
+
+    int DepthToSlice(float depth) const;
+
+    std::vector<uint32_t> m_Clusters;
+    std::vector<uint32_t> m_Indices;
+    std::vector<Range> m_Ranges;
+    std::vector<uint32_t> m_Cursor;
+    float m_SliceScale = 0.0f;
+    float m_SliceBias = 0.0f;
+    uint32_t m_MaxPerCluster = 0;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+#include "LightGrid.h"
+
+class GLShader;
+class Mesh;
+
+// Lumières émissives de la frame, rassemblées une seule fois puis réparties
+// dans la grille de clusters. Trois texture buffers (GL 3.1) les portent aux
+// shaders : les lumières, le début/nombre par cluster et les index. Un
+// fragment n'évalue que les lumières de son cluster.
+class LightManager {
+public:
+    static LightManager& Get();
+
+    void Cleanup();
+
+    // Nouvelle frame : liste vide
+    void BeginFrame();
+    void AddLight(const float* position, const float* color, float intensity);
+    // Ajoute chaque mesh émissif (position du mesh, lightColor, emissiveIntensity)
+    void AddEmissiveMeshes(const std::vector<Mesh*>& meshes);
+
+    // Construit la grille pour cette caméra et l'envoie au GPU
+    void Build(const Mat4& view, const Mat4& projection);
+
+    // Lie les texture buffers et renseigne les uniforms du programme courant
+    void Apply(const GLShader& shader) const;
+
+    size_t GetLightCount() const { return m_Lights.size(); }
+    uint32_t GetMaxLightsPerCluster() const { return m_Grid.GetMaxLightsPerCluster(); }
+
+    // Unités de texture réservées aux buffers de lumières
+    static const int LIGHTS_UNIT = 2;
+    static const int CLUSTERS_UNIT = 3;
+    static const int INDICES_UNIT = 4;
+
+private:
+    LightManager() = default;
+    ~LightManager() = default;
+    LightManager(const LightManager&) = delete;
+    LightManager& operator=(const LightManager&) = delete;
+
+    struct TextureBuffer {
+        GLuint buffer = 0;
+        GLuint texture = 0;
+        size_t capacity = 0;
+    };
+
+    static void Upload(TextureBuffer& target, GLuint unit, GLenum format, const void* data, size_t bytes);
+    static void Release(TextureBuffer& target);
+
+    std::vector<PointLight> m_Lights;
+    LightGrid m_Grid;
+    TextureBuffer m_LightBuffer;     // RGBA32F, 2 texels par lumière
+    TextureBuffer m_ClusterBuffer;   // RG32UI, début + nombre
+    TextureBuffer m_IndexBuffer;     // R32UI
+    float m_TileSize[2] = { 1.0f, 1.0f };
+};
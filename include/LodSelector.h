@@ -0,0 +1,26 @@
+#pragma once
+#include "Bounds.h"
+
+// Choix du niveau de détail d'après la taille projetée de la sphère englobante.
+// Sans OpenGL : partagé par le rendu et les benchmarks.
+struct LodSelector {
+    static const int MAX_SWITCHES = 3;
+
+    static LodSelector& Get();
+
+    bool enabled = true;
+
+    // Diamètre à l'écran (pixels) sous lequel on passe au niveau suivant
+    float switchDiameters[MAX_SWITCHES] = { 256.0f, 96.0f, 32.0f };
+
+    // Marge relative autour de chaque seuil : un objet à la limite ne
+    // change pas de niveau à chaque frame
+    float hysteresis = 0.15f;
+
+    // Niveau pour un diamètre donné, en partant du niveau courant
+    int Select(int currentLevel, int levelCount, float screenDiameter) const;
+
+    // Diamètre projeté (pixels) de bounds vu depuis cameraPos ; pixelScale vaut
+    // projection[5] * hauteur du viewport / 2
+    static float ScreenDiameter(const Bounds& bounds, const float* cameraPos, float pixelScale);
+};
@@ -4,7 +4,7 @@
 
 class Mat4 {
 private:
-    std::array<float, 16> m_data;  // Column-major order
+    alignas(16) std::array<float, 16> m_data;  // Column-major order
 
 public:
     Mat4();
@@ -22,6 +22,19 @@ public:
     bool operator==(const Mat4& other) const;
     bool operator!=(const Mat4& other) const;
 
+    // Inverse générale (retourne l'identité si la matrice est singulière)
+    Mat4 inverse() const;
+    // Transforme un point (w = 1), sans division perspective
+    void transformPoint(const float* in, float* out) const;
+
+    // Chemins scalaires de référence, utilisés pour valider le chemin SIMD
+    static Mat4 multiplyScalar(const Mat4& a, const Mat4& b);
+    static Mat4 inverseScalar(const Mat4& m);
+    static void transformPointScalar(const Mat4& m, const float* in, float* out);
+
+    // Nom du chemin sélectionné à la compilation ("AVX", "SSE2" ou "Scalar")
+    static const char* simdPath();
+
     // Transformations
     static Mat4 translate(float x, float y, float z);
     static Mat4 rotate(float angle, float x, float y, float z);
@@ -0,0 +1,72 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Material;
+
+// Matériau tel que lu par les shaders (bloc std140 "Materials", 64 octets).
+// Même découpage que les attributs d'instance de InstancedRenderer.
+struct GPUMaterial {
+    float diffuse[4];    // rgb + shininess
+    float specular[4];   // rgb + specularStrength
+    float emissive[4];   // lightColor + emissiveIntensity
+    int32_t params[4];   // illuminationModel, isEmissive, textures utilisées, ignoreObjectMaterialInEnvMap
+};
+static_assert(sizeof(GPUMaterial) == 64, "GPUMaterial doit suivre le layout std140 des shaders");
+
+// Tous les matériaux des meshes dans un seul UBO. Chaque Mesh reçoit un slot
+// à sa création ; le slot n'est réécrit que quand le matériau change
+// (setMaterial, texture, import OBJ). Un draw ne fait plus qu'un glUniform1i
+// (u_materialIndex) au lieu d'un glUniform par champ.
+// Le buffer est découpé en pages de MATERIALS_PER_PAGE (16 Ko, la taille d'UBO
+// minimale garantie) ; la page du slot est liée par glBindBufferRange.
+class MaterialBuffer {
+public:
+    static MaterialBuffer& Get();
+
+    void Cleanup();
+
+    uint32_t Allocate();
+    void Free(uint32_t slot);
+    void Update(uint32_t slot, const Material& material);
+
+    // Lie la page du slot (si ce n'est pas déjà la page liée) et renvoie l'index
+    // à passer dans u_materialIndex. Envoie d'abord les slots modifiés.
+    GLint Bind(uint32_t slot);
+
+    // Tout le buffer en SSBO (rendu indirect : le slot est lu par draw dans le shader)
+    void BindStorage(GLuint binding);
+
+    // Benchmark : renvoyer le matériau à chaque draw, comme l'ancien chemin
+    void SetPerDrawUpload(bool enabled) { m_PerDrawUpload = enabled; }
+    bool IsPerDrawUpload() const { return m_PerDrawUpload; }
+
+    static const int MATERIALS_PER_PAGE = 256;   // doit correspondre aux shaders
+    static const size_t PAGE_SIZE = MATERIALS_PER_PAGE * sizeof(GPUMaterial);
+
+    // Drapeaux de params[2]
+    static const int32_t TEXTURE_IN_BASIC = 1 << 0;
+    static const int32_t TEXTURE_IN_COLOR = 1 << 1;
+    static const int32_t TEXTURE_IN_ENVMAP = 1 << 2;
+
+private:
+    MaterialBuffer() = default;
+    ~MaterialBuffer() = default;
+    MaterialBuffer(const MaterialBuffer&) = delete;
+    MaterialBuffer& operator=(const MaterialBuffer&) = delete;
+
+    void Flush();
+
+    std::vector<GPUMaterial> m_Materials;   // copie CPU, arrondie à des pages entières
+    std::vector<uint32_t> m_FreeSlots;
+    uint32_t m_SlotCount = 0;
+
+    GLuint m_Buffer = 0;
+    size_t m_BufferSize = 0;
+    // Slots à renvoyer : [m_DirtyBegin, m_DirtyEnd)
+    uint32_t m_DirtyBegin = UINT32_MAX;
+    uint32_t m_DirtyEnd = 0;
+    bool m_PerDrawUpload = false;
+};
@@ -3,23 +3,24 @@
 #include <cmath>
 #include <vector>
 #include <string>
+#include <memory>
 #include <GL/glew.h>
 #include "GLShader.h"
 #include "Mat4.h"
+#include "Bounds.h"
+#include "DynamicBVH.h"
+#include "GeometryArena.h"
 #include "tiny_obj_loader.h"
-
-struct Vertex {
-    float position[3];
-    float normal[3];
-    float uv[2];
-};
+#include "Vertex.h"
+#include "ObjImporter.h"
+#include "TextureCache.h"
 
 struct Material {
     float diffuse[3] = {0.8f, 0.8f, 0.8f};
     float specular[3] = {1.0f, 1.0f, 1.0f};
     float ambient[3] = {0.2f, 0.2f, 0.2f};
     float shininess = 32.0f;
-    GLuint diffuseMap = 0;
+    TextureHandle diffuseMap;  // partagée via ResourceManager::GetTextures()
     bool isEmissive = false;
     float emissiveIntensity = 1.0f;
     float lightColor[3] = {1.0f, 1.0f, 1.0f};
@@ -36,10 +37,15 @@ struct Material {
     } illuminationModel = IlluminationModel::BLINN_PHONG;
 };
 
+struct MeshGeometry;
+
 class Mesh {
 public:
     Mesh();
     ~Mesh();
+    // Le slot du MaterialBuffer appartient à un seul mesh
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
     
     void setPosition(float x, float y, float z);
     void setRotation(const Mat4& rotationMatrix); // Nouveau
@@ -60,7 +66,9 @@ public:
     void bindTexture();
 
     // Ajoute ces deux méthodes publiques :
-    bool loadFromOBJFile(const char* filename);
+    bool loadFromOBJFile(const char* filename, const ObjImportOptions& options = ObjImportOptions());
+    // Reprend une géométrie OBJ déjà envoyée au GPU (import asynchrone)
+    void applyOBJGeometry(const std::shared_ptr<MeshGeometry>& geometry);
     void draw(GLShader& shader);
 
     const float* getScale() const { return scale; }
@@ -70,20 +78,64 @@ public:
     }
     GLShader* getCurrentShader() const { return m_CurrentShader; }
 
+    // Accès à la géométrie pour le rendu instancié
+    bool isSphere() const { return m_SphereSectors > 0; }
+    float getSphereRadius() const { return m_SphereRadius; }
+    int getSphereSectors() const { return m_SphereSectors; }
+    int getSphereStacks() const { return m_SphereStacks; }
+    // VAO de la GeometryArena (0 sans géométrie) et nombre d'indices du niveau courant
+    GLuint getVAO() const;
+    GLsizei getIndexCount() const;
+    // Place du niveau de détail courant dans la GeometryArena
+    ArenaRange getArenaRange() const;
+    uint32_t getMaterialSlot() const { return m_MaterialSlot; }
+    const std::shared_ptr<MeshGeometry>& getGeometry() const { return m_Geometry; }
+    bool isTextureEnabled() const { return textureEnabled; }
+
+    // Volumes englobants de la géométrie, en espace objet puis monde.
+    // Le monde est recalculé au premier accès après un changement de transformation.
+    Bounds getLocalBounds() const;
+    const Bounds& getWorldBounds();
+
+    // Feuille dans le BVH de la scène ; chaque changement de transformation
+    // la signale pour le Refit de la frame
+    void attachToBVH(DynamicBVH* bvh);
+    void detachFromBVH();
+
+    // Rayon monde origin + t * direction contre les triangles du mesh ;
+    // distance (t max en entrée) devient celle de l'impact
+    bool raycast(const float* origin, const float* direction, float& distance);
+
+    // Choisit le niveau de détail d'après la taille à l'écran (voir LodSelector) ;
+    // le picking reste sur la géométrie complète
+    void updateLOD(const float* cameraPos, float pixelScale);
+    int getLODLevel() const { return m_LodLevel; }
+
 private:
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    // Géométrie partagée via GeometryCache
+    std::shared_ptr<MeshGeometry> m_Geometry;
     Material material;
+    // Copie GPU du matériau dans MaterialBuffer, réécrite quand il change
+    uint32_t m_MaterialSlot;
     bool textureEnabled = true;
     
-    GLuint VAO, VBO, EBO;
     float position[3] = {0.0f, 0.0f, 0.0f};
     Mat4 rotation; // Changement ici
     float scale[3] = {1.0f, 1.0f, 1.0f};
     Mat4 m_transform;  // Nouvelle matrice de transformation complète
     GLShader* m_CurrentShader = nullptr;
+
+    Bounds m_WorldBounds;
+    bool m_WorldBoundsDirty = true;
+    DynamicBVH* m_BVH = nullptr;
+    int m_BVHProxy = DynamicBVH::NULL_NODE;
+    int m_LodLevel = 0;
+
+    // Paramètres de createSphere (0 secteurs si le mesh vient d'un OBJ)
+    float m_SphereRadius = 0.0f;
+    int m_SphereSectors = 0;
+    int m_SphereStacks = 0;
     
-    void setupMesh();
     void updateShaderUniforms();  // Nouvelle méthode pour mettre à jour les uniformes
-    void calculateNormalsIfNeeded();  // Ajout de la déclaration de la fonction
+    void markBoundsDirty();
 };
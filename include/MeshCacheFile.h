@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "MappedFile.h"
+
+struct MeshGeometry;
+
+// Cache binaire d'un OBJ, écrit à côté de la source ("modele.obj.meshcache").
+// Contient les Vertex entrelacés, les indices, le matériau, les bornes et les
+// niveaux de détail simplifiés (la simplification ne tourne qu'une fois).
+namespace MeshCacheFile {
+    static const uint32_t VERSION = 3;    // 2 : rayon de la sphère englobante, 3 : niveaux de détail
+
+    // Options d'import enregistrées dans l'en-tête (un cache ne sert qu'aux mêmes options)
+    static const uint32_t FLAG_WELD_BY_VALUE = 1u << 0;
+
+    std::string GetCachePath(const std::string& objPath);
+
+    // Charge le cache s'il existe et correspond à la source (mtime/taille, puis hash)
+    bool Load(const std::string& objPath, uint32_t importFlags, MeshGeometry& geometry);
+    bool Save(const std::string& objPath, uint32_t importFlags, const MeshGeometry& geometry);
+
+    // FNV-1a 64 bits
+    uint64_t HashBytes(const unsigned char* data, size_t size);
+}
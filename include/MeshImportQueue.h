@@ -0,0 +1,51 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ObjImporter.h"
+
+struct MeshGeometry;
+
+// Import d'OBJ hors du thread de rendu : analyse, soudure et normales tournent
+// en arrière-plan (analyse répartie sur le ThreadPool), puis ProcessCompleted,
+// appelé à chaque frame, envoie au plus une géométrie terminée au GPU.
+// Toutes les méthodes sont à appeler depuis le thread de rendu.
+class MeshImportQueue {
+public:
+    using Callback = std::function<void(const std::shared_ptr<MeshGeometry>&)>;
+
+    static MeshImportQueue& Get();
+
+    // Le callback reçoit nullptr si l'import a échoué
+    void Request(const std::string& filename, const ObjImportOptions& options, Callback callback);
+    void ProcessCompleted();
+
+    // Attend la fin des imports en cours sans les livrer (fermeture)
+    void Shutdown();
+
+    size_t GetPendingCount() const { return m_Jobs.size(); }
+    double GetLastThroughputMBs() const { return m_LastThroughputMBs; }
+    const std::string& GetLastImportName() const { return m_LastImportName; }
+
+private:
+    MeshImportQueue() = default;
+    ~MeshImportQueue() = default;
+    MeshImportQueue(const MeshImportQueue&) = delete;
+    MeshImportQueue& operator=(const MeshImportQueue&) = delete;
+
+    struct Job {
+        std::string filename;
+        ObjImportOptions options;
+        Callback callback;
+        std::future<std::shared_ptr<MeshGeometry>> result;
+        std::chrono::steady_clock::time_point start;
+        size_t bytes = 0;
+    };
+
+    std::vector<Job> m_Jobs;
+    double m_LastThroughputMBs = 0.0;
+    std::string m_LastImportName;
+};
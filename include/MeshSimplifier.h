@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Vertex.h"
+
+// Simplification par fusion d'arêtes guidée par les quadriques d'erreur
+// (Garland-Heckbert), sans OpenGL : tourne sur le thread d'import.
+// Les passes fusionnent les arêtes dont l'erreur passe sous un seuil croissant
+// jusqu'à atteindre le nombre de triangles visé. Les sommets de bord ne bougent
+// pas : bords ouverts et coutures d'UV (sommets dupliqués) restent fermés.
+namespace MeshSimplifier {
+    struct Result {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    // Le résultat peut garder plus de triangles que visé si les fusions
+    // restantes retourneraient des faces ou toucheraient un bord
+    Result Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                    size_t targetTriangles);
+}
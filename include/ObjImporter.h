@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Vertex.h"
+#include "tiny_obj_loader.h"
+
+struct ObjImportOptions {
+    // false : un sommet par triplet d'indices OBJ (position, normale, uv)
+    // true  : soude aussi les sommets dont les attributs sont égaux en valeur
+    bool weldByValue = false;
+};
+
+class ThreadPool;
+
+// Contenu brut d'un OBJ, au format tinyobj, avant soudure des sommets
+struct ObjParseResult {
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    size_t bytes = 0;  // taille du fichier source
+};
+
+// Construction du maillage indexé à partir des données tinyobj, sans OpenGL
+namespace ObjImporter {
+    Vertex MakeVertex(const tinyobj::attrib_t& attrib, const tinyobj::index_t& idx);
+
+    void BuildIndexedMesh(const tinyobj::attrib_t& attrib,
+                          const std::vector<tinyobj::shape_t>& shapes,
+                          const ObjImportOptions& options,
+                          std::vector<Vertex>& vertices,
+                          std::vector<unsigned int>& indices);
+
+    // Lecture parallèle : le fichier projeté en mémoire est découpé en blocs de
+    // lignes analysés sur le pool, puis fusionnés en une seule forme triangulée.
+    // Ne traite que v/vn/vt/f/mtllib ; renvoie false si le fichier sort de ce cadre
+    // (l'appelant se rabat alors sur tinyobj::LoadObj).
+    bool ParseParallel(const std::string& filename, ThreadPool& pool,
+                       ObjParseResult& result, std::string& error);
+}
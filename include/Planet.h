@@ -1,6 +1,7 @@
 #pragma once
 #include <GL/glew.h>
 #include "Mesh.h"
+#include "PlanetSystem.h"
 
 class Planet {
 public:
@@ -18,6 +19,12 @@ public:
     void SetMaterial(const Material& material);
     bool LoadTexture(const char* texturePath);
 
+    // Rattache la planète à un PlanetSystem : l'orbite est alors avancée par
+    // PlanetSystem::Update et les setters écrivent dans ses tableaux
+    void AttachToSystem(PlanetSystem* system, size_t index);
+    // Copie la matrice calculée par le système dans le mesh
+    void SyncFromSystem();
+
     // Getters
     Mesh* GetMesh() const { return m_Mesh; }
     float GetOrbitRadius() const { return m_OrbitRadius; }
@@ -27,7 +34,7 @@ public:
 
     // Setters
     void SetOrbitRadius(float radius) { m_OrbitRadius = radius; UpdateTransform(); }
-    void SetRotationSpeed(float speed) { m_RotationSpeed = speed; }
+    void SetRotationSpeed(float speed);
     void SetSize(float size);  // Déplacer l'implémentation dans le .cpp
 
 private:
@@ -41,4 +48,6 @@ private:
     float m_Size;
     float m_SelfRotation;
     float m_CurrentAngle;
+    PlanetSystem* m_System;
+    size_t m_SystemIndex;
 };
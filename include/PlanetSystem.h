@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Système de corps en orbite stocké en structure-of-arrays.
+// Update() avance tous les angles et écrit toutes les matrices de modèle
+// (translation orbitale * rotation propre * échelle) en un seul passage.
+class PlanetSystem {
+public:
+    // Vitesse de rotation propre, identique à Planet::Update
+    static constexpr float SELF_ROTATION_SPEED = 0.5f;
+
+    size_t AddBody(float orbitRadius, float angularSpeed, float size);
+    void Reserve(size_t count);
+    void Clear();
+    size_t GetCount() const { return m_OrbitRadius.size(); }
+
+    void Update(float deltaTime);
+
+    // Matrices column-major, 16 floats consécutifs par corps
+    const float* GetTransform(size_t index) const { return &m_Transforms[index * 16]; }
+    const float* GetTransforms() const { return m_Transforms.data(); }
+
+    // Paramètres d'un corps
+    float GetOrbitRadius(size_t index) const { return m_OrbitRadius[index]; }
+    float GetAngularSpeed(size_t index) const { return m_AngularSpeed[index]; }
+    float GetSize(size_t index) const { return m_Size[index]; }
+    float GetAngle(size_t index) const { return m_Angle[index]; }
+    void SetBodyParameters(size_t index, float orbitRadius, float angularSpeed, float size);
+    void SetOrbitRadius(size_t index, float radius);
+    void SetAngularSpeed(size_t index, float speed) { m_AngularSpeed[index] = speed; }
+    void SetSize(size_t index, float size);
+    void SetAngle(size_t index, float angle);
+
+private:
+    void WriteTransforms(size_t begin, size_t end);
+
+    std::vector<float> m_OrbitRadius;
+    std::vector<float> m_AngularSpeed;
+    std::vector<float> m_Angle;
+    std::vector<float> m_SelfRotation;
+    std::vector<float> m_Size;
+    std::vector<float> m_Transforms;
+};
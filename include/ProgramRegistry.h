@@ -0,0 +1,115 @@
+#pragma once
+#include <GL/glew.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GLShader.h"
+
+// Registre des programmes GLSL du processus, indexé par le hash des sources.
+// Chaque combinaison vertex/geometry/fragment n'est compilée qu'une fois : les
+// scènes, le ResourceManager, la skybox et le rendu instancié partagent le même
+// programme. Quand le driver le permet (GL 4.1 / ARB_get_program_binary), le
+// binaire lié est gardé sur disque et rechargé au lancement suivant.
+// Le link est paresseux : il n'a lieu qu'au premier Use() du programme.
+// Reload() remplace un programme sur place quand un de ses fichiers change.
+class ProgramRegistry {
+public:
+    struct Program {
+        enum class State { Compiling, Linked, Failed };
+
+        GLuint id = 0;
+        int refCount = 0;
+        State state = State::Compiling;
+        bool fromBinary = false;
+        ProgramReflection reflection;
+
+        // Shader objects soumis au driver, libérés au link
+        GLuint stages[3] = { 0, 0, 0 };
+
+        // Sources courantes, relues par Reload()
+        ProgramSources sources;
+
+        // Rapport de démarrage : "basic.vs + basic.fs", temps en ms
+        std::string label;
+        double submitTime = 0.0;
+        double compileMs = -1.0;    // soumission -> compilation terminée, -1 tant que non observée
+        double linkMs = 0.0;        // link (ou glProgramBinary) bloquant
+    };
+
+    struct Stats {
+        size_t livePrograms = 0;
+        size_t pending = 0;         // soumis, pas encore liés
+        size_t compiled = 0;        // compilés depuis les sources
+        size_t binaryHits = 0;      // rechargés depuis le cache disque
+        size_t shared = 0;          // déjà présents dans le registre
+        double blockingMs = 0.0;    // temps passé bloqué sur link/glProgramBinary
+        size_t reloads = 0;         // programmes remplacés à chaud
+        size_t reloadFailures = 0;  // rechargements rejetés (ancien programme conservé)
+    };
+
+    static ProgramRegistry& Get();
+
+    // Hash FNV-1a des trois sources (geometry vide si absent)
+    static uint64_t HashSources(const ProgramSources& sources);
+
+    // Référence vers le programme de ces sources. Au premier appel, les shaders
+    // sont seulement soumis au driver (sans attendre le résultat) : avec
+    // KHR_parallel_shader_compile, toutes les scènes compilent en parallèle.
+    void Acquire(uint64_t key, const ProgramSources& sources);
+    void Release(uint64_t key);
+
+    // Lie le programme s'il ne l'est pas encore (bloquant) ; nullptr en cas d'échec
+    const Program* Link(uint64_t key);
+
+    // Relève les compilations terminées sans bloquer (GL_COMPLETION_STATUS_KHR)
+    void Poll();
+
+    // Recompile les programmes qui utilisent ce fichier avec la nouvelle source.
+    // Le nouveau programme ne remplace l'ancien que s'il compile et se lie ;
+    // les GLShader relisent alors id, locations et bindings à leur prochain usage.
+    // Renvoie le nombre de programmes remplacés.
+    int Reload(const std::string& path, const std::string& source);
+
+    // Fichiers sources des programmes vivants ; la révision change quand la liste change
+    std::vector<std::string> GetSourcePaths() const;
+    uint32_t GetPathsRevision() const { return m_PathsRevision; }
+
+    Stats GetStats() const;
+    // Temps de compilation et de link par programme, sur la console
+    void PrintReport() const;
+
+private:
+    ProgramRegistry();
+    ProgramRegistry(const ProgramRegistry&) = delete;
+    ProgramRegistry& operator=(const ProgramRegistry&) = delete;
+
+    void SubmitCompile(Program& program);
+    bool LinkStages(Program& program);
+    void DeleteStages(Program& program);
+    static void BindUniformBlocks(GLuint program);
+    // Clé du registre pour un hash de sources (les entrées rechargées gardent leur clé d'origine)
+    uint64_t Resolve(uint64_t key) const;
+    void UpdateAlias(uint64_t key, uint64_t previousHash, uint64_t currentHash);
+    double Now() const;
+    bool IsParallelCompileSupported();
+
+    // Cache binaire : un fichier par hash de sources, valide pour un seul driver
+    bool IsBinaryCacheSupported();
+    std::string GetBinaryPath(uint64_t key) const;
+    GLuint LoadBinary(uint64_t key);
+    void SaveBinary(uint64_t key, GLuint program);
+
+    std::unordered_map<uint64_t, Program> m_Programs;
+    // Hash des sources courantes -> clé d'une entrée rechargée à chaud
+    std::unordered_map<uint64_t, uint64_t> m_Aliases;
+    std::string m_CacheDirectory;
+    std::string m_DriverString;
+    int m_BinarySupport = -1;   // -1 : pas encore interrogé
+    int m_ParallelSupport = -1;
+    std::chrono::steady_clock::time_point m_Epoch;
+    uint32_t m_PathsRevision = 0;
+    Stats m_Stats;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+// Sous-allocation d'un intervalle [0, capacité) en éléments, sans OpenGL.
+// Liste de trous triée par position : allocation dans le plus petit trou qui
+// suffit (best fit), sinon à la suite ; un trou libéré fusionne avec ses
+// voisins, et avec la fin s'il la touche.
+class RangeAllocator {
+public:
+    static const size_t INVALID = SIZE_MAX;
+
+    explicit RangeAllocator(size_t capacity = 0) : m_Capacity(capacity) {}
+
+    // Position du bloc, ou INVALID s'il faut agrandir (Grow) avant
+    size_t Allocate(size_t count);
+    void Free(size_t offset, size_t count);
+
+    void Grow(size_t capacity);
+    // Après compactage : count éléments occupés au début, aucun trou
+    void SetPacked(size_t count);
+    void Clear() { SetPacked(0); }
+
+    size_t GetCapacity() const { return m_Capacity; }
+    size_t GetLiveCount() const { return m_Live; }
+    size_t GetEnd() const { return m_End; }             // fin du dernier bloc occupé
+    size_t GetHoleCount() const { return m_Holes.size(); }
+    size_t GetHoleSize() const { return m_End - m_Live; }  // éléments libres avant m_End
+    size_t GetLargestFree() const;
+
+    // 0 : toute la place libre d'un seul tenant ; proche de 1 : émiettée en petits trous
+    float GetFragmentation() const;
+
+private:
+    std::map<size_t, size_t> m_Holes;   // position -> taille, tous avant m_End
+    size_t m_Capacity = 0;
+    size_t m_End = 0;
+    size_t m_Live = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+#include "Mat4.h"
+
+class GLShader;
+class Mesh;
+
+// File de draws d'une scène : les meshes sont collectés pendant Render(),
+// triés par clé 64 bits puis soumis en ne touchant qu'à l'état qui change
+// (programme, texture, VAO, index de matériau, u_hasTexture).
+// Les uniforms communs (éclairage, cubemap...) sont réglés par la scène une
+// fois par programme avant Flush().
+class RenderQueue {
+public:
+    // Clé, bits de poids fort en premier :
+    // programme (8) | page du MaterialBuffer (8) | texture (16) | VAO (16) | profondeur (16)
+    // Les identifiants GL sont tronqués : une collision ne coûte qu'un
+    // changement d'état de plus, la soumission compare les vrais objets.
+    static uint64_t MakeKey(GLuint program, uint32_t materialPage, GLuint texture, GLuint vao, float depth);
+
+    // view/projection : caméra de la frame, pour trier d'avant en arrière
+    void Begin(const Mat4& view, const Mat4& projection);
+    // textureUnit : unité lue par u_texture dans ce shader
+    void Submit(Mesh* mesh, GLShader& shader, GLuint textureUnit = 0);
+    void Flush();
+
+    size_t GetPacketCount() const { return m_Packets.size(); }
+
+private:
+    struct DrawPacket {
+        uint64_t key;
+        Mesh* mesh;
+        GLShader* shader;
+        GLuint program;
+        GLuint texture;      // 0 : pas de texture affichée
+        GLuint textureUnit;
+        GLuint vao;
+    };
+
+    std::vector<DrawPacket> m_Packets;
+    Mat4 m_View;
+    float m_FarPlane = 1.0f;
+};
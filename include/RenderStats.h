@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+
+// Compteurs de rendu remis à zéro à chaque frame et affichés dans l'UI
+struct RenderStats {
+    static RenderStats& Get();
+    void Reset();
+
+    // Objets de la scène testés contre le frustum
+    int visibleObjects = 0;
+    int culledObjects = 0;
+
+    // Draws individuels et changements d'état (RenderQueue, Mesh::draw)
+    int draws = 0;
+    // Triangles envoyés (tous chemins de dessin), après choix du niveau de détail
+    int triangles = 0;
+    int programSwitches = 0;
+    int textureBinds = 0;
+
+    // Appels d'état envoyés au driver / évités par GLStateCache
+    int stateCallsIssued = 0;
+    int stateCallsSkipped = 0;
+
+    // Rendu instancié
+    int instancedDrawCalls = 0;
+    int instances = 0;
+
+    // Rendu indirect : appels glMultiDrawElementsIndirect et draws qu'ils contiennent
+    int indirectDrawCalls = 0;
+    int indirectDraws = 0;
+
+    // Matrices de transformation envoyées (ring buffer ou chemin synchrone)
+    int transformUploads = 0;
+
+    // Envois du buffer de matériaux (0 tant qu'aucun matériau ne change)
+    int materialUploads = 0;
+
+    // Éclairage par clusters : lumières de la frame, entrées dans les listes
+    int lights = 0;
+    int lightIndices = 0;
+
+    // Appels glGetUniformLocation (doit rester à 0 hors chargement de shader)
+    int uniformDriverLookups = 0;
+
+    // Textures arrivées du TextureStreamer pendant la frame
+    int textureUploads = 0;
+    size_t textureUploadBytes = 0;
+};
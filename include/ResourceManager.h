@@ -1,5 +1,6 @@
 #pragma once
 #include "GLShader.h"
+#include "TextureCache.h"
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -13,6 +14,7 @@ public:
 
     bool LoadShader(const std::string& name, const char* vertexPath, const char* fragmentPath);
     GLShader* GetShader(const std::string& name);
+    TextureCache& GetTextures() { return m_Textures; }
     void Clear();
 
 private:
@@ -20,4 +22,5 @@ private:
     ~ResourceManager();
 
     std::unordered_map<std::string, std::unique_ptr<GLShader>> m_Shaders;
+    TextureCache m_Textures;
 };
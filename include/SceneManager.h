@@ -5,9 +5,16 @@
 #include <string>
 #include <vector>
 #include <algorithm>  // Ajout pour std::find
+#include <cstring>
 #include "GLShader.h"
 #include "Mesh.h"
 #include "Planet.h"
+#include "PlanetSystem.h"
+#include "InstancedRenderer.h"
+#include "IndirectRenderer.h"
+#include "RenderQueue.h"
+#include "Frustum.h"
+#include "DynamicBVH.h"
 #include "Mat4.h"
 #include "UI.h" // Ajouter cet include au début du fichier
 #include "CubeMap.h"
@@ -48,10 +55,21 @@ public:
     // Accesseur pour le CubeMap
     CubeMap& GetCubeMap() { return m_CubeMap; }
 
+    // Frustum de la frame, à régler avant Render() (accepte tout par défaut)
+    void SetFrustum(const Frustum& frustum) { m_frustum = frustum; }
+
+    // Point de vue du choix des niveaux de détail : position caméra et
+    // pixels par unité à distance 1 (projection[5] * hauteur / 2)
+    void SetLODView(const float* cameraPos, float pixelScale) {
+        memcpy(m_lodCameraPos, cameraPos, sizeof(m_lodCameraPos));
+        m_lodPixelScale = pixelScale;
+    }
+
     // Ajouter cette méthode
     virtual void AddObject(Mesh* object) { 
         if (object) {
             m_objects.push_back(object);
+            object->attachToBVH(&m_bvh);
         }
     }
 
@@ -64,11 +82,17 @@ public:
         }
     }
 
+    // Objet le plus proche touché par le rayon (boîtes du BVH puis triangles), ou nullptr
+    Mesh* Pick(const float* origin, const float* direction, float maxDistance);
+
     // Ajouter la déclaration de la fonction GetShaderPath
     std::string GetShaderPath(const std::string& filename);
 
 protected:
     std::string m_name;
+    // Hiérarchie des volumes de m_objects, déclarée avant eux : les meshes
+    // s'en retirent à leur destruction
+    DynamicBVH m_bvh;
     std::vector<Mesh*> m_objects;
     std::vector<Planet> m_planets;
     Mesh* m_sun = nullptr;
@@ -82,6 +106,26 @@ protected:
 
     // Ajouter le CubeMap
     CubeMap m_CubeMap;
+
+    // Draws de la frame, triés par état avant soumission
+    RenderQueue m_renderQueue;
+
+    // Objets du shader Basic dessinés par glMultiDrawElementsIndirect (GL 4.3).
+    // Non initialisé ou désactivé, Submit refuse et le chemin par draw reste utilisé.
+    IndirectRenderer m_indirectRenderer;
+    bool InitializeIndirect();
+    // Éclaire le programme indirect comme le shader Basic puis envoie les draws
+    void FlushIndirect(const float* viewPos);
+
+    // Rejet des objets hors champ, avant tout travail GL (compté dans RenderStats) :
+    // recale le BVH sur les objets déplacés puis le parcourt
+    // Les objets retenus passent aussi au niveau de détail de leur taille à l'écran
+    Frustum m_frustum;
+    float m_lodCameraPos[3] = {0.0f, 0.0f, 0.0f};
+    float m_lodPixelScale = 0.0f;
+    std::vector<Mesh*> m_visibleObjects;
+    const std::vector<Mesh*>& GatherVisible();
+    void RefitBVH();
     
     // Méthode pour initialiser le CubeMap
     bool InitializeCubeMap();
@@ -98,14 +142,34 @@ public:
     void Render(const Mat4& projection, const Mat4& view) override;
     void Cleanup() override;
 
+    // Ceinture d'astéroïdes (démonstration de l'instanciation), masquée par défaut
+    static void SetAsteroidBeltEnabled(bool enabled) { s_AsteroidBeltEnabled = enabled; }
+    static bool IsAsteroidBeltEnabled() { return s_AsteroidBeltEnabled; }
+
 private:
     void createSun();
     void createPlanets();
     void loadPlanetTextures();
+    void createAsteroidBelt();
     void updatePlanets(float deltaTime);
-    void setupBasicShader(GLuint program, Mesh* obj, float* light_color, float light_intensity, const float* cameraPos);
-    void setupColorShader(GLuint program, Mesh* obj);
-    void setupEnvMapShader(GLuint program, Mesh* obj, const float* cameraPos);
+    void setupLighting(GLShader& shader, float* light_color, float light_intensity, const float* cameraPos);
+
+    // Orbites de toutes les planètes, mises à jour en un seul passage
+    PlanetSystem m_planetSystem;
+
+    // Sphères dessinées en glDrawElementsInstanced, un appel par groupe de matériau
+    InstancedRenderer m_instancedRenderer;
+
+    // Ceinture d'astéroïdes entre Mars et Jupiter, jamais dessinée objet par objet.
+    // Hors du BVH (ni picking ni lumières) : chaque astéroïde est testé contre
+    // le frustum avant d'entrer dans le buffer d'instances.
+    static const int ASTEROID_COUNT = 4000;
+    static bool s_AsteroidBeltEnabled;
+    PlanetSystem m_asteroidBelt;
+    Mesh* m_asteroidMesh = nullptr;
+    Material m_asteroidMaterial;
+    std::vector<float> m_visibleAsteroids;
+    void submitAsteroidBelt();
 };
 
 // Scène de démonstration
@@ -121,9 +185,9 @@ public:
 
 private:
     void createDemoObjects();
-    void setupBasicShaderDemo(GLuint program, Mesh* obj, float* light_color, float light_intensity, float* lightPos, const float* cameraPos);
-    void setupColorShaderDemo(GLuint program, Mesh* obj);
-    void setupEnvMapShaderDemo(GLuint program, Mesh* obj, const float* cameraPos);
+    // Uniforms communs, réglés une fois par frame et par programme
+    void setupBasicShaderDemo(GLShader& shader, float* light_color, float light_intensity, float* lightPos, const float* cameraPos);
+    void setupEnvMapShaderDemo(GLShader& shader, const float* cameraPos);
     float m_rotationTime = 0.0f;
 };
 
@@ -139,6 +203,27 @@ public:
     void Cleanup() override;
 };
 
+// Scène de mesure : N sphères dessinées une à une, un UpdateTransform par draw
+class BenchmarkScene : public Scene {
+public:
+    explicit BenchmarkScene(int objectCount);
+    virtual ~BenchmarkScene() override;
+
+    bool Initialize() override;
+    void Update(float deltaTime) override;
+    void Render(const Mat4& projection, const Mat4& view) override;
+    void Cleanup() override;
+
+    // Sphères dessinées par InstancedRenderer plutôt qu'une à une (--render-check)
+    bool SetInstancingEnabled(bool enabled);
+
+private:
+    int m_objectCount;
+    float m_time = 0.0f;
+    bool m_instancing = false;
+    InstancedRenderer m_instancedRenderer;
+};
+
 // Gestionnaire de scènes
 class SceneManager {
 public:
@@ -148,12 +233,13 @@ public:
     void AddScene(std::unique_ptr<Scene> scene);
     bool SetActiveScene(const std::string& sceneName);
     Scene* GetActiveScene() const { return m_activeScene; }
+    Scene* GetScene(const std::string& name) const;
     void RemoveScene(const std::string& name);
     
     // Méthodes de cycle de vie
     bool Initialize();
     void Update(float deltaTime);
-    void Render(const Mat4& projection, const Mat4& view);
+    void Render(const Mat4& projection, const Mat4& view, const Frustum& frustum);
     void Cleanup();
     
     // Utilitaires
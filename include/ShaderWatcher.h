@@ -0,0 +1,50 @@
+#pragma once
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Rechargement à chaud des shaders. Un thread surveille la date de modification
+// des fichiers utilisés par le ProgramRegistry et relit ceux qui changent ;
+// Update(), sur le thread de rendu, recompile les programmes concernés.
+class ShaderWatcher {
+public:
+    static ShaderWatcher& Get();
+
+    void Start();
+    void Stop();
+
+    // Thread de rendu, une fois par frame : met à jour la liste des fichiers
+    // surveillés et applique les sources relues
+    void Update();
+
+private:
+    ShaderWatcher() = default;
+    ~ShaderWatcher();
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+    void WatchLoop();
+
+    // Intervalle entre deux relevés des dates de modification
+    static const int POLL_INTERVAL_MS = 250;
+
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    bool m_Running = false;
+
+    // Protégés par m_Mutex
+    std::vector<std::string> m_WatchedPaths;
+    std::vector<std::pair<std::string, std::string>> m_ChangedSources;   // chemin, nouvelle source
+
+    // Thread de surveillance uniquement
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_WriteTimes;
+
+    // Thread de rendu uniquement
+    uint32_t m_PathsRevision = 0;
+};
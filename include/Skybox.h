@@ -19,6 +19,7 @@ public:
 private:
     bool CreateBuffers();
     bool LoadCubeMap();
+    bool LoadCompressedCubeMap(const std::string& directory, const std::vector<std::string>& faceFiles);
     bool CreateProceduralCubeMap();
     
     GLuint m_VAO;
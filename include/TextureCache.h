@@ -0,0 +1,70 @@
+#pragma once
+#include <GL/glew.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "TextureStreamer.h"
+
+// Texture GL partagée ; le nom GL est libéré avec la dernière référence
+struct Texture {
+    GLuint id = 0;
+    std::string path;
+    size_t residentBytes = 0;
+
+    Texture() = default;
+    ~Texture();
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+};
+
+// Référence comptée vers une Texture du cache, à la place d'un GLuint brut
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    explicit TextureHandle(std::shared_ptr<Texture> texture) : m_Texture(std::move(texture)) {}
+
+    GLuint GetID() const { return m_Texture ? m_Texture->id : 0; }
+    const std::string& GetPath() const;
+    explicit operator bool() const { return GetID() != 0; }
+    void Reset() { m_Texture.reset(); }
+
+private:
+    std::shared_ptr<Texture> m_Texture;
+};
+
+// Cache de textures indexé par chemin canonique + paramètres (format, mipmaps,
+// wrap). Comme GeometryCache, il ne garde que des weak_ptr : une texture
+// partagée par plusieurs meshes ou scènes n'est décodée et envoyée qu'une fois.
+class TextureCache {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t liveEntries = 0;
+        size_t residentBytes = 0;
+
+        float GetHitRate() const {
+            size_t total = hits + misses;
+            return total ? static_cast<float>(hits) / total : 0.0f;
+        }
+    };
+
+    TextureCache();
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // Handle vide si le fichier n'existe pas
+    TextureHandle Load2D(const std::string& path, const TextureSettings& settings = TextureSettings());
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    static std::string MakeKey(const std::string& path, const TextureSettings& settings);
+    void OnUploaded(GLuint texture, size_t residentBytes);
+
+    std::unordered_map<std::string, std::weak_ptr<Texture>> m_Entries;
+    std::unordered_map<GLuint, std::weak_ptr<Texture>> m_ByID;
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+};
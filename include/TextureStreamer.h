@@ -0,0 +1,91 @@
+#pragma once
+#include <GL/glew.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "KTX2.h"
+
+// Paramètres d'échantillonnage et de format d'une texture 2D
+struct TextureSettings {
+    bool srgb = true;
+    bool mipmaps = true;
+    GLenum wrap = GL_REPEAT;
+};
+
+// Chargement de textures en arrière-plan : le nom GL est créé tout de suite avec
+// un placeholder 1x1, les images sont décodées sur le ThreadPool, puis Update
+// (thread de rendu, une fois par frame) les envoie au GPU dans la limite d'un
+// budget d'octets par frame, via un PBO quand il est disponible.
+// Un .ktx2 à jour à côté de l'image (voir "make textures") est envoyé tel quel :
+// blocs BC1/BC3/BC7 et mipmaps précalculés, sans glGenerateMipmap.
+class TextureStreamer {
+public:
+    static TextureStreamer& Get();
+
+    // Texture 2D. Renvoie 0 si le fichier n'existe pas.
+    GLuint RequestTexture2D(const std::string& path, const TextureSettings& settings = TextureSettings());
+    // Cubemap, faces dans l'ordre +X -X +Y -Y +Z -Z. Renvoie 0 si une face manque.
+    GLuint RequestCubeMap(const std::vector<std::string>& faces);
+    // Cubemap KTX2 compressé. Renvoie 0 si le fichier est absent ou non pris en charge.
+    GLuint RequestCubeMapKTX2(const std::string& path);
+
+    // Format GL d'un VkFormat KTX2 si le GPU le gère, 0 sinon
+    static GLenum GetCompressedFormat(uint32_t format, bool srgb);
+
+    // À appeler avant glDeleteTextures sur une texture éventuellement en attente
+    void Cancel(GLuint texture);
+
+    // Prévenu à chaque envoi terminé, avec la taille occupée sur le GPU (mipmaps compris)
+    using UploadListener = std::function<void(GLuint texture, size_t residentBytes)>;
+    void SetUploadListener(UploadListener listener) { m_UploadListener = std::move(listener); }
+
+    void Update();
+    void Cleanup();
+
+    void SetUploadBudget(size_t bytesPerFrame) { m_UploadBudget = bytesPerFrame; }
+    size_t GetUploadBudget() const { return m_UploadBudget; }
+    size_t GetPendingCount() const { return m_Jobs.size(); }
+
+private:
+    TextureStreamer() = default;
+    ~TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    struct ImageDeleter {
+        void operator()(unsigned char* data) const;
+    };
+
+    // Image décodée en RGBA8, ou face d'un KTX2 (blocs compressés, tous niveaux)
+    struct DecodedImage {
+        int width = 0;
+        int height = 0;
+        std::unique_ptr<unsigned char, ImageDeleter> pixels;
+        std::shared_ptr<KTX2::Image> blocks;
+        uint32_t face = 0;
+
+        size_t GetByteSize() const;
+    };
+
+    struct Job {
+        GLuint texture = 0;
+        GLenum target = GL_TEXTURE_2D;
+        TextureSettings settings;
+        std::vector<std::string> paths;
+        std::future<std::vector<DecodedImage>> images;  // vide si le décodage a échoué
+    };
+
+    static std::vector<DecodedImage> Decode(const std::vector<std::string>& paths);
+    void Submit(GLuint texture, GLenum target, const TextureSettings& settings, const std::vector<std::string>& paths);
+    size_t Upload(Job& job, std::vector<DecodedImage>& images);
+    void UploadLevel(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                     const unsigned char* data, size_t size, bool compressed);
+    static std::string FindCompressedVariant(const std::string& path);
+
+    std::vector<Job> m_Jobs;
+    size_t m_UploadBudget = 8 * 1024 * 1024;
+    GLuint m_PBO = 0;
+    UploadListener m_UploadListener;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Vertex.h"
+
+// Hiérarchie statique de boîtes sur les triangles d'une géométrie, en espace
+// objet (découpe par coût de surface sur des intervalles de centroïdes).
+// Sert au picking : le rayon ne teste que les triangles des feuilles qu'il
+// traverse, du plus proche au plus lointain.
+// Les sommets et indices ne sont pas copiés : ils doivent survivre à l'arbre.
+class TriangleBVH {
+public:
+    void Build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    void Clear();
+    bool IsBuilt() const { return !m_Nodes.empty(); }
+
+    // Premier triangle touché par origin + t * direction avec t dans [0, distance] ;
+    // distance devient le t de l'impact
+    bool Raycast(const float* origin, const float* direction, float& distance) const;
+
+    size_t GetNodeCount() const { return m_Nodes.size(); }
+    size_t GetByteSize() const;
+
+private:
+    // 32 octets : deux nœuds par ligne de cache
+    struct Node {
+        float min[3];
+        unsigned int leftFirst;     // enfant gauche (le droit suit), ou premier triangle
+        float max[3];
+        unsigned int count;         // 0 pour un nœud interne
+    };
+
+    // Données de construction par triangle
+    struct TriangleBox {
+        float min[3];
+        float max[3];
+        float centroid[3];
+    };
+
+    struct Bin;
+
+    void Subdivide(std::vector<TriangleBox>& boxes);
+    bool IntersectTriangle(unsigned int triangle, const float* origin, const float* direction, float& distance) const;
+
+    std::vector<Node> m_Nodes;
+    std::vector<unsigned int> m_Triangles;  // triangles réordonnés par feuille
+    const Vertex* m_Vertices = nullptr;
+    const unsigned int* m_Indices = nullptr;
+};
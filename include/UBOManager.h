@@ -8,21 +8,50 @@ public:
     void Initialize();
     void Cleanup();
 
+    // Encadrent le rendu d'une frame : choix de la région du ring et fence de fin
+    void BeginFrame();
+    void EndFrame();
+
     // Mise à jour des données UBO
     void UpdateProjectionView(const float* projection, const float* view);
+    // Écrit la matrice dans le prochain slot du ring et le lie via glBindBufferRange
     void UpdateTransform(const float* transform);
 
+    // Permet au benchmark de comparer avec l'ancien chemin (un glBufferSubData par draw)
+    void SetRingBufferEnabled(bool enabled) { m_ringEnabled = enabled; }
+    bool IsRingBufferEnabled() const { return m_ringEnabled && m_ringUBO != 0; }
+    bool IsPersistentlyMapped() const { return m_mappedRing != nullptr; }
+
     // Binding points
     static const GLuint PROJECTION_VIEW_BINDING = 0;
     static const GLuint TRANSFORM_BINDING = 1;
+    static const GLuint MATERIAL_BINDING = 2;     // pages de MaterialBuffer
+
+    // Frames en vol dans le ring (chemin persistant) et capacité par frame
+    static const int RING_FRAMES = 3;
+    static const size_t MAX_TRANSFORMS_PER_FRAME = 16384;
 
 private:
     UBOManager() = default;
     ~UBOManager() = default;
 
+    void UpdateTransformLegacy(const float* transform);
+
     GLuint m_projViewUBO = 0;
     GLuint m_transformUBO = 0;
 
+    // Ring buffer des transforms
+    GLuint m_ringUBO = 0;
+    unsigned char* m_mappedRing = nullptr;   // non nul si GL_ARB_buffer_storage
+    GLsync m_fences[RING_FRAMES] = {};
+    size_t m_slotSize = 0;                   // 64 octets arrondis à l'alignement UBO
+    size_t m_frameSize = 0;
+    size_t m_frameOffset = 0;
+    size_t m_slotCursor = 0;
+    int m_frameIndex = 0;
+    bool m_inFrame = false;
+    bool m_ringEnabled = true;
+
     static const size_t MATRIX_SIZE = 16 * sizeof(float);
     static const size_t PROJ_VIEW_SIZE = 2 * MATRIX_SIZE;  // projection + view
 };
@@ -26,6 +26,8 @@ public:
     void SetShaders(GLShader* basic, GLShader* color, GLShader* envmap); // Changed from references to pointers
     void SetLightParameters(float* lightColor, float* lightIntensity);
     bool IsWireframeMode() const { return m_WireframeMode; }
+    // Objet choisi par clic dans la vue (nullptr : rien sous le curseur)
+    void SelectObject(Mesh* object, double pickMs);
 
 private:
     void ShowMainWindow(float fps, const float* cameraPos, const float* cameraFront);
@@ -35,6 +37,7 @@ private:
     void ShowSceneControls();
     void ShowNewSceneDialog();
     void ShowLoadModelDialog(); // Added function to show load model dialog
+    void ShowSelection();
 
     GLFWwindow* m_Window;
     int m_Width;
@@ -42,7 +45,8 @@ private:
     bool m_ShowDebugWindow;
     bool m_ShowSettings;
     bool m_WireframeMode = false;
-    int m_SelectedObject;
+    int m_SelectedObject;   // indice dans m_SceneObjects, -1 si aucun
+    double m_LastPickMs = 0.0;
     bool m_ShowNewSceneDialog;
     char m_NewSceneName[256];
 
@@ -0,0 +1,8 @@
+#pragma once
+
+// Format de sommet entrelacé commun à tous les meshes (VBO, cache binaire)
+struct Vertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
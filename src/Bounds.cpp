@@ -0,0 +1,45 @@
+#include "../include/Bounds.h"
+#include <algorithm>
+#include <cmath>
+
+Bounds Bounds::FromBox(const float* boxMin, const float* boxMax, float sphereRadius) {
+    Bounds bounds;
+    for (int axis = 0; axis < 3; ++axis) {
+        bounds.min[axis] = boxMin[axis];
+        bounds.max[axis] = boxMax[axis];
+        bounds.center[axis] = 0.5f * (boxMin[axis] + boxMax[axis]);
+    }
+    bounds.radius = sphereRadius;
+    return bounds;
+}
+
+Bounds Bounds::Transform(const float* matrix) const {
+    // Boîte d'Arvo : centre transformé, demi-étendue par valeurs absolues
+    float localCenter[3], extent[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        localCenter[axis] = 0.5f * (min[axis] + max[axis]);
+        extent[axis] = 0.5f * (max[axis] - min[axis]);
+    }
+
+    Bounds world;
+    for (int i = 0; i < 3; ++i) {
+        float boxCenter = matrix[12 + i];
+        float boxExtent = 0.0f;
+        world.center[i] = matrix[12 + i];
+        for (int j = 0; j < 3; ++j) {
+            boxCenter += matrix[i + j * 4] * localCenter[j];
+            boxExtent += std::fabs(matrix[i + j * 4]) * extent[j];
+            world.center[i] += matrix[i + j * 4] * center[j];
+        }
+        world.min[i] = boxCenter - boxExtent;
+        world.max[i] = boxCenter + boxExtent;
+    }
+
+    float maxScaleSq = 0.0f;
+    for (int j = 0; j < 3; ++j) {
+        const float* column = matrix + j * 4;
+        maxScaleSq = std::max(maxScaleSq, column[0] * column[0] + column[1] * column[1] + column[2] * column[2]);
+    }
+    world.radius = radius * std::sqrt(maxScaleSq);
+    return world;
+}
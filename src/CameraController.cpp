@@ -28,6 +28,38 @@ void CameraController::Initialize() {
     SetCursorLocked(true);
 }
 
+void CameraController::GetCursorRay(const Mat4& projection, const Mat4& view, float* origin, float* direction) const {
+    double cursorX, cursorY;
+    int width, height;
+    glfwGetCursorPos(m_Window, &cursorX, &cursorY);
+    glfwGetWindowSize(m_Window, &width, &height);
+
+    // Coordonnées normalisées du curseur (y vers le haut), ramenées sur les plans near et far
+    float ndcX = 2.0f * static_cast<float>(cursorX) / (width > 0 ? width : 1) - 1.0f;
+    float ndcY = 1.0f - 2.0f * static_cast<float>(cursorY) / (height > 0 ? height : 1);
+    Mat4 inverse = (projection * view).inverse();
+    const float* m = inverse.data();
+    float points[2][3];
+    for (int p = 0; p < 2; ++p) {
+        float ndcZ = p == 0 ? -1.0f : 1.0f;
+        float w = m[3] * ndcX + m[7] * ndcY + m[11] * ndcZ + m[15];
+        for (int i = 0; i < 3; ++i) {
+            points[p][i] = (m[i] * ndcX + m[i + 4] * ndcY + m[i + 8] * ndcZ + m[i + 12]) / w;
+        }
+    }
+
+    float length = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        origin[i] = points[0][i];
+        direction[i] = points[1][i] - points[0][i];
+        length += direction[i] * direction[i];
+    }
+    length = std::sqrt(length);
+    for (int i = 0; i < 3; ++i) {
+        direction[i] /= length;
+    }
+}
+
 void CameraController::MouseCallback(GLFWwindow* window, double xpos, double ypos) {
     if (s_Instance) {
         s_Instance->ProcessMouseMovement(xpos, ypos);
@@ -1,5 +1,6 @@
 #include "../include/CubeMap.h"
-#include <stb/stb_image.h>
+#include "../include/GLStateCache.h"
+#include "../include/TextureStreamer.h"
 #include <iostream>
 #include <GL/glew.h>
 
@@ -8,7 +9,8 @@ CubeMap::CubeMap() : m_TextureID(0), m_IsLoaded(false) {
 
 CubeMap::~CubeMap() {
     if (m_TextureID) {
-        glDeleteTextures(1, &m_TextureID);
+        TextureStreamer::Get().Cancel(m_TextureID);
+        GLStateCache::Get().DeleteTextures(1, &m_TextureID);
     }
 }
 
@@ -18,29 +20,16 @@ bool CubeMap::LoadFromImages(const std::vector<std::string>& faces) {
         return false;
     }
 
-    glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
-
-    for (int i = 0; i < 6; i++) {
-        int width, height, channels;
-        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &channels, 0);
-        
-        if (data) {
-            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, width, height, 0,
-                         format, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
-        } else {
-            std::cerr << "Failed to load cubemap texture: " << faces[i] << std::endl;
-            return false;
-        }
+    // Décodage en arrière-plan, le nom GL est valide tout de suite
+    GLuint texture = TextureStreamer::Get().RequestCubeMap(faces);
+    if (!texture) {
+        return false;
     }
-
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    if (m_TextureID) {
+        TextureStreamer::Get().Cancel(m_TextureID);
+        GLStateCache::Get().DeleteTextures(1, &m_TextureID);
+    }
+    m_TextureID = texture;
 
     m_IsLoaded = true;
     return true;
@@ -48,7 +37,7 @@ bool CubeMap::LoadFromImages(const std::vector<std::string>& faces) {
 
 bool CubeMap::CreateProcedural() {
     glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
+    GLStateCache::Get().BindTexture(0, GL_TEXTURE_CUBE_MAP, m_TextureID);
     
     unsigned char colors[6][3] = {
         {255, 100, 100},  // +X (droite) - rouge
@@ -94,13 +83,13 @@ bool CubeMap::CreateProcedural() {
 void CubeMap::Bind(GLuint unit) {
     if (!m_IsLoaded) return;
     
-    glActiveTexture(GL_TEXTURE0 + unit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
+    GLStateCache::Get().BindTexture(unit, GL_TEXTURE_CUBE_MAP, m_TextureID);
 }
 
 void CubeMap::Reload() {
     if (m_TextureID) {
-        glDeleteTextures(1, &m_TextureID);
+        TextureStreamer::Get().Cancel(m_TextureID);
+        GLStateCache::Get().DeleteTextures(1, &m_TextureID);
         m_TextureID = 0;
         m_IsLoaded = false;
     }
@@ -0,0 +1,318 @@
+#include "../include/DynamicBVH.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Marge des boîtes élargies, relative à la taille de l'objet
+    const float FAT_MARGIN_RATIO = 0.2f;
+    const float MIN_FAT_MARGIN = 0.05f;
+    // Boîte étirée dans le sens du déplacement, pour quelques frames d'avance
+    const float DISPLACEMENT_MULTIPLIER = 4.0f;
+}
+
+DynamicBVH::DynamicBVH() {
+    Clear();
+}
+
+void DynamicBVH::Clear() {
+    m_Nodes.clear();
+    m_Moved.clear();
+    m_Root = NULL_NODE;
+    m_FreeList = NULL_NODE;
+    m_ProxyCount = 0;
+}
+
+float DynamicBVH::Area(const Node& node) {
+    float dx = node.max[0] - node.min[0];
+    float dy = node.max[1] - node.min[1];
+    float dz = node.max[2] - node.min[2];
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+float DynamicBVH::UnionArea(const Node& a, const Node& b) {
+    float d[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        d[axis] = std::max(a.max[axis], b.max[axis]) - std::min(a.min[axis], b.min[axis]);
+    }
+    return 2.0f * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+}
+
+void DynamicBVH::SetUnion(Node& node, const Node& a, const Node& b) {
+    for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = std::min(a.min[axis], b.min[axis]);
+        node.max[axis] = std::max(a.max[axis], b.max[axis]);
+    }
+}
+
+void DynamicBVH::SetFatBounds(int leaf, const Bounds& bounds, const float* displacement) {
+    float margin = std::max(MIN_FAT_MARGIN, FAT_MARGIN_RATIO * bounds.radius);
+    Node& node = m_Nodes[leaf];
+    for (int axis = 0; axis < 3; ++axis) {
+        float d = displacement[axis] * DISPLACEMENT_MULTIPLIER;
+        node.min[axis] = bounds.min[axis] - margin + std::min(d, 0.0f);
+        node.max[axis] = bounds.max[axis] + margin + std::max(d, 0.0f);
+    }
+}
+
+int DynamicBVH::AllocateNode() {
+    if (m_FreeList == NULL_NODE) {
+        m_Nodes.emplace_back();
+        return static_cast<int>(m_Nodes.size()) - 1;
+    }
+    int node = m_FreeList;
+    m_FreeList = m_Nodes[node].parent;
+    m_Nodes[node] = Node();
+    return node;
+}
+
+void DynamicBVH::FreeNode(int node) {
+    m_Nodes[node].parent = m_FreeList;
+    m_Nodes[node].height = -1;
+    m_Nodes[node].moved = false;
+    m_FreeList = node;
+}
+
+int DynamicBVH::Insert(const Bounds& bounds, void* userData) {
+    int leaf = AllocateNode();
+    const float noDisplacement[3] = { 0.0f, 0.0f, 0.0f };
+    SetFatBounds(leaf, bounds, noDisplacement);
+    m_Nodes[leaf].userData = userData;
+    m_Nodes[leaf].height = 0;
+    InsertLeaf(leaf);
+    m_ProxyCount++;
+    return leaf;
+}
+
+void DynamicBVH::Remove(int proxy) {
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    m_ProxyCount--;
+}
+
+bool DynamicBVH::Contains(const Node& node, const Node& inner) {
+    for (int axis = 0; axis < 3; ++axis) {
+        if (inner.min[axis] < node.min[axis] || inner.max[axis] > node.max[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DynamicBVH::Move(int proxy, const Bounds& bounds) {
+    Node& node = m_Nodes[proxy];
+    bool contained = true;
+    for (int axis = 0; axis < 3; ++axis) {
+        contained = contained && bounds.min[axis] >= node.min[axis] && bounds.max[axis] <= node.max[axis];
+    }
+    if (contained) {
+        return false;
+    }
+
+    // Déplacement estimé depuis le centre de l'ancienne boîte élargie
+    float displacement[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        displacement[axis] = bounds.center[axis] - 0.5f * (node.min[axis] + node.max[axis]);
+    }
+
+    // Nouvelle boîte élargie encore dans celle du parent : les ancêtres
+    // restent valides, la feuille est mise à jour sur place
+    Node previous = node;
+    SetFatBounds(proxy, bounds, displacement);
+    if (node.parent != NULL_NODE && Contains(m_Nodes[node.parent], node)) {
+        return false;
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = previous.min[axis];
+        node.max[axis] = previous.max[axis];
+    }
+
+    RemoveLeaf(proxy);
+    SetFatBounds(proxy, bounds, displacement);
+    InsertLeaf(proxy);
+    return true;
+}
+
+void DynamicBVH::MarkMoved(int proxy) {
+    Node& node = m_Nodes[proxy];
+    if (!node.moved) {
+        node.moved = true;
+        m_Moved.push_back(proxy);
+    }
+}
+
+void DynamicBVH::InsertLeaf(int leaf) {
+    if (m_Root == NULL_NODE) {
+        m_Root = leaf;
+        m_Nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Descente vers le frère le moins coûteux (heuristique de surface)
+    const Node leafNode = m_Nodes[leaf];
+    int index = m_Root;
+    while (!m_Nodes[index].IsLeaf()) {
+        const Node& node = m_Nodes[index];
+        float area = Area(node);
+        float combinedArea = UnionArea(node, leafNode);
+
+        // Coût d'un nouveau parent ici, et coût minimal ajouté aux ancêtres
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCost[2];
+        int children[2] = { node.child1, node.child2 };
+        for (int i = 0; i < 2; ++i) {
+            const Node& child = m_Nodes[children[i]];
+            float mergedArea = UnionArea(child, leafNode);
+            if (child.IsLeaf()) {
+                childCost[i] = mergedArea + inheritanceCost;
+            } else {
+                childCost[i] = mergedArea - Area(child) + inheritanceCost;
+            }
+        }
+
+        if (cost < childCost[0] && cost < childCost[1]) {
+            break;
+        }
+        index = childCost[0] < childCost[1] ? children[0] : children[1];
+    }
+
+    // Nouveau parent commun au frère et à la feuille
+    int sibling = index;
+    int oldParent = m_Nodes[sibling].parent;
+    int newParent = AllocateNode();
+    Node& parent = m_Nodes[newParent];
+    parent.parent = oldParent;
+    SetUnion(parent, leafNode, m_Nodes[sibling]);
+    parent.height = m_Nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    m_Nodes[sibling].parent = newParent;
+    m_Nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        m_Root = newParent;
+    } else if (m_Nodes[oldParent].child1 == sibling) {
+        m_Nodes[oldParent].child1 = newParent;
+    } else {
+        m_Nodes[oldParent].child2 = newParent;
+    }
+
+    RefitAncestors(m_Nodes[leaf].parent);
+}
+
+void DynamicBVH::RemoveLeaf(int leaf) {
+    if (leaf == m_Root) {
+        m_Root = NULL_NODE;
+        return;
+    }
+
+    // Le frère prend la place du parent, qui disparaît
+    int parent = m_Nodes[leaf].parent;
+    int grandParent = m_Nodes[parent].parent;
+    int sibling = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        m_Root = sibling;
+        m_Nodes[sibling].parent = NULL_NODE;
+        FreeNode(parent);
+        return;
+    }
+
+    if (m_Nodes[grandParent].child1 == parent) {
+        m_Nodes[grandParent].child1 = sibling;
+    } else {
+        m_Nodes[grandParent].child2 = sibling;
+    }
+    m_Nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    RefitAncestors(grandParent);
+}
+
+void DynamicBVH::RefitAncestors(int index) {
+    while (index != NULL_NODE) {
+        index = Balance(index);
+        Node& node = m_Nodes[index];
+        const Node& child1 = m_Nodes[node.child1];
+        const Node& child2 = m_Nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        SetUnion(node, child1, child2);
+        index = node.parent;
+    }
+}
+
+int DynamicBVH::Balance(int iA) {
+    Node& A = m_Nodes[iA];
+    if (A.IsLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int iB = A.child1;
+    int iC = A.child2;
+    int balance = m_Nodes[iC].height - m_Nodes[iB].height;
+    if (balance >= -1 && balance <= 1) {
+        return iA;
+    }
+
+    // Le plus haut des deux enfants remonte à la place de A
+    int iUp = balance > 1 ? iC : iB;
+    int iOther = balance > 1 ? iB : iC;
+    Node& up = m_Nodes[iUp];
+    int iF = up.child1;
+    int iG = up.child2;
+
+    up.child1 = iA;
+    up.parent = A.parent;
+    A.parent = iUp;
+    if (up.parent == NULL_NODE) {
+        m_Root = iUp;
+    } else if (m_Nodes[up.parent].child1 == iA) {
+        m_Nodes[up.parent].child1 = iUp;
+    } else {
+        m_Nodes[up.parent].child2 = iUp;
+    }
+
+    // Le plus haut des petits-enfants reste sous le nœud remonté, l'autre passe sous A
+    int iKeep = m_Nodes[iF].height > m_Nodes[iG].height ? iF : iG;
+    int iMove = iKeep == iF ? iG : iF;
+    up.child2 = iKeep;
+    if (balance > 1) {
+        A.child2 = iMove;
+    } else {
+        A.child1 = iMove;
+    }
+    m_Nodes[iMove].parent = iA;
+
+    const Node& other = m_Nodes[iOther];
+    const Node& moved = m_Nodes[iMove];
+    SetUnion(A, other, moved);
+    A.height = 1 + std::max(other.height, moved.height);
+    SetUnion(up, A, m_Nodes[iKeep]);
+    up.height = 1 + std::max(A.height, m_Nodes[iKeep].height);
+    return iUp;
+}
+
+bool DynamicBVH::SphereOverlaps(const Node& node, const float* center, float radius) {
+    // Distance du centre au point le plus proche de la boîte
+    float distanceSq = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        float clamped = std::min(std::max(center[axis], node.min[axis]), node.max[axis]);
+        float d = center[axis] - clamped;
+        distanceSq += d * d;
+    }
+    return distanceSq <= radius * radius;
+}
+
+bool DynamicBVH::RayOverlaps(const Node& node, const float* origin, const float* inverseDirection, float maxDistance) {
+    // Méthode des tranches ; une direction nulle donne ±inf, géré par min/max
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    for (int axis = 0; axis < 3; ++axis) {
+        float t1 = (node.min[axis] - origin[axis]) * inverseDirection[axis];
+        float t2 = (node.max[axis] - origin[axis]) * inverseDirection[axis];
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+    }
+    return tMin <= tMax;
+}
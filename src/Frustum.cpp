@@ -0,0 +1,152 @@
+#include "../include/Frustum.h"
+#include <cfloat>
+#include <cmath>
+
+// Même sélection que Mat4.cpp (MAT4_NO_SIMD force le scalaire)
+#if !defined(MAT4_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRUSTUM_USE_SSE
+#include <emmintrin.h>
+#endif
+#endif
+
+Frustum::Frustum() {
+    for (int i = 0; i < 8; ++i) {
+        m_X[i] = m_Y[i] = m_Z[i] = 0.0f;
+        m_W[i] = FLT_MAX;
+    }
+}
+
+Frustum::Frustum(const Mat4& viewProjection) : Frustum() {
+    // Ligne r de la matrice column-major : (m[r], m[r + 4], m[r + 8], m[r + 12])
+    const float* m = viewProjection.data();
+    for (int plane = 0; plane < PLANE_COUNT; ++plane) {
+        int row = plane / 2;                        // gauche/droite, bas/haut, near/far
+        float sign = (plane % 2 == 0) ? 1.0f : -1.0f;
+        float x = m[3] + sign * m[row];
+        float y = m[7] + sign * m[row + 4];
+        float z = m[11] + sign * m[row + 8];
+        float w = m[15] + sign * m[row + 12];
+
+        // Normale unitaire : la distance signée se compare au rayon
+        float length = std::sqrt(x * x + y * y + z * z);
+        if (length > 0.0f) {
+            x /= length; y /= length; z /= length; w /= length;
+        }
+        m_X[plane] = x;
+        m_Y[plane] = y;
+        m_Z[plane] = z;
+        m_W[plane] = w;
+    }
+}
+
+bool Frustum::Intersects(const Bounds& bounds) const {
+#if defined(FRUSTUM_USE_SSE)
+    const __m128 cx = _mm_set1_ps(bounds.center[0]);
+    const __m128 cy = _mm_set1_ps(bounds.center[1]);
+    const __m128 cz = _mm_set1_ps(bounds.center[2]);
+    const __m128 negRadius = _mm_set1_ps(-bounds.radius);
+    const __m128 minX = _mm_set1_ps(bounds.min[0]), maxX = _mm_set1_ps(bounds.max[0]);
+    const __m128 minY = _mm_set1_ps(bounds.min[1]), maxY = _mm_set1_ps(bounds.max[1]);
+    const __m128 minZ = _mm_set1_ps(bounds.min[2]), maxZ = _mm_set1_ps(bounds.max[2]);
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 outside = zero;
+    for (int i = 0; i < 8; i += 4) {
+        __m128 px = _mm_load_ps(m_X + i);
+        __m128 py = _mm_load_ps(m_Y + i);
+        __m128 pz = _mm_load_ps(m_Z + i);
+        __m128 pw = _mm_load_ps(m_W + i);
+
+        // Sphère : distance signée du centre < -rayon
+        __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, cx), _mm_mul_ps(py, cy)),
+                              _mm_add_ps(_mm_mul_ps(pz, cz), pw));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negRadius));
+
+        // Boîte : sommet choisi selon le signe de la normale (max si > 0)
+        __m128 sx = _mm_cmpgt_ps(px, zero);
+        __m128 sy = _mm_cmpgt_ps(py, zero);
+        __m128 sz = _mm_cmpgt_ps(pz, zero);
+        __m128 vx = _mm_or_ps(_mm_and_ps(sx, maxX), _mm_andnot_ps(sx, minX));
+        __m128 vy = _mm_or_ps(_mm_and_ps(sy, maxY), _mm_andnot_ps(sy, minY));
+        __m128 vz = _mm_or_ps(_mm_and_ps(sz, maxZ), _mm_andnot_ps(sz, minZ));
+        __m128 dv = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, vx), _mm_mul_ps(py, vy)),
+                               _mm_add_ps(_mm_mul_ps(pz, vz), pw));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(dv, zero));
+    }
+    return _mm_movemask_ps(outside) == 0;
+#else
+    return IntersectsScalar(bounds);
+#endif
+}
+
+Frustum::Containment Frustum::ClassifyBox(const float* boxMin, const float* boxMax) const {
+#if defined(FRUSTUM_USE_SSE)
+    const __m128 minX = _mm_set1_ps(boxMin[0]), maxX = _mm_set1_ps(boxMax[0]);
+    const __m128 minY = _mm_set1_ps(boxMin[1]), maxY = _mm_set1_ps(boxMax[1]);
+    const __m128 minZ = _mm_set1_ps(boxMin[2]), maxZ = _mm_set1_ps(boxMax[2]);
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 outside = zero;
+    __m128 crossing = zero;
+    for (int i = 0; i < 8; i += 4) {
+        __m128 px = _mm_load_ps(m_X + i);
+        __m128 py = _mm_load_ps(m_Y + i);
+        __m128 pz = _mm_load_ps(m_Z + i);
+        __m128 pw = _mm_load_ps(m_W + i);
+
+        // Sommet le plus avancé (p) et le plus en retrait (n) selon chaque plan
+        __m128 sx = _mm_cmpgt_ps(px, zero);
+        __m128 sy = _mm_cmpgt_ps(py, zero);
+        __m128 sz = _mm_cmpgt_ps(pz, zero);
+        __m128 pvx = _mm_or_ps(_mm_and_ps(sx, maxX), _mm_andnot_ps(sx, minX));
+        __m128 pvy = _mm_or_ps(_mm_and_ps(sy, maxY), _mm_andnot_ps(sy, minY));
+        __m128 pvz = _mm_or_ps(_mm_and_ps(sz, maxZ), _mm_andnot_ps(sz, minZ));
+        __m128 nvx = _mm_or_ps(_mm_and_ps(sx, minX), _mm_andnot_ps(sx, maxX));
+        __m128 nvy = _mm_or_ps(_mm_and_ps(sy, minY), _mm_andnot_ps(sy, maxY));
+        __m128 nvz = _mm_or_ps(_mm_and_ps(sz, minZ), _mm_andnot_ps(sz, maxZ));
+        __m128 dp = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, pvx), _mm_mul_ps(py, pvy)),
+                               _mm_add_ps(_mm_mul_ps(pz, pvz), pw));
+        __m128 dn = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, nvx), _mm_mul_ps(py, nvy)),
+                               _mm_add_ps(_mm_mul_ps(pz, nvz), pw));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(dp, zero));
+        crossing = _mm_or_ps(crossing, _mm_cmplt_ps(dn, zero));
+    }
+    if (_mm_movemask_ps(outside) != 0) {
+        return OUTSIDE;
+    }
+    return _mm_movemask_ps(crossing) != 0 ? INTERSECTING : INSIDE;
+#else
+    Containment result = INSIDE;
+    for (int i = 0; i < PLANE_COUNT; ++i) {
+        bool px = m_X[i] > 0.0f, py = m_Y[i] > 0.0f, pz = m_Z[i] > 0.0f;
+        float dp = m_X[i] * (px ? boxMax[0] : boxMin[0]) + m_Y[i] * (py ? boxMax[1] : boxMin[1]) +
+                   m_Z[i] * (pz ? boxMax[2] : boxMin[2]) + m_W[i];
+        if (dp < 0.0f) {
+            return OUTSIDE;
+        }
+        float dn = m_X[i] * (px ? boxMin[0] : boxMax[0]) + m_Y[i] * (py ? boxMin[1] : boxMax[1]) +
+                   m_Z[i] * (pz ? boxMin[2] : boxMax[2]) + m_W[i];
+        if (dn < 0.0f) {
+            result = INTERSECTING;
+        }
+    }
+    return result;
+#endif
+}
+
+bool Frustum::IntersectsScalar(const Bounds& bounds) const {
+    for (int i = 0; i < PLANE_COUNT; ++i) {
+        float distance = m_X[i] * bounds.center[0] + m_Y[i] * bounds.center[1] + m_Z[i] * bounds.center[2] + m_W[i];
+        if (distance < -bounds.radius) {
+            return false;
+        }
+        float vx = m_X[i] > 0.0f ? bounds.max[0] : bounds.min[0];
+        float vy = m_Y[i] > 0.0f ? bounds.max[1] : bounds.min[1];
+        float vz = m_Z[i] > 0.0f ? bounds.max[2] : bounds.min[2];
+        if (m_X[i] * vx + m_Y[i] * vy + m_Z[i] * vz + m_W[i] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -3,172 +3,175 @@
 //#define GLEW_STATIC
 #include "../include/GL/glew.h"
 
+#include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <UBOManager.h>
-
-bool ValidateShader(GLuint shader)
+#include "../include/ProgramRegistry.h"
+#include "../include/RenderStats.h"
+
+uint32_t GLShader::s_ProgramGeneration = 1;
+
+// Noms GLSL des uniforms de l'enum Uniform, dans le même ordre
+static const char* s_UniformNames[] = {
+	"u_projection",
+	"u_view",
+	"u_transform",
+	"u_viewPos",
+	"u_texture",
+	"u_hasTexture",
+	"u_intensity",
+	"u_envmap",
+	"u_skybox",
+	"u_light.direction",
+	"u_light.diffuseColor",
+	"u_light.specularColor",
+	"u_materialIndex",
+	"u_lights",
+	"u_clusterLights",
+	"u_lightIndices",
+	"u_clusterGrid",
+	"u_clusterTileSize",
+	"u_clusterDepth",
+	"u_drawOffset",
+};
+static_assert(sizeof(s_UniformNames) / sizeof(s_UniformNames[0]) == static_cast<size_t>(Uniform::Count),
+	"s_UniformNames doit couvrir tout l'enum Uniform");
+
+// Seul endroit qui interroge le driver : chaque appel est compté
+static GLint QueryUniformLocation(GLuint program, const char* name)
 {
-	GLint compiled;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
-
-	if (!compiled)
-	{
-		GLint infoLen = 0;
-
-		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLen);
-
-		if (infoLen > 1)
-		{
-			char* infoLog = new char[1 + infoLen];
-
-			glGetShaderInfoLog(shader, infoLen, NULL, infoLog);
-			std::cout << "Error compiling shader:" << infoLog << std::endl;
-
-			delete[] infoLog;
-		}
-
-		// on supprime le shader object car il est inutilisable
-		glDeleteShader(shader);
-
-		return false;
-	}
-
-	return true;
+	RenderStats::Get().uniformDriverLookups++;
+	return glGetUniformLocation(program, name);
 }
 
-bool GLShader::LoadVertexShader(const char* filename)
+// Lit un fichier source en entier ; false si le fichier est introuvable
+static bool ReadSource(const char* filename, std::string& source)
 {
-	// 1. Charger le fichier en memoire
 	std::ifstream fin(filename, std::ios::in | std::ios::binary);
+	if (!fin) {
+		std::cerr << "Shader introuvable: " << filename << std::endl;
+		return false;
+	}
 	fin.seekg(0, std::ios::end);
-	uint32_t length = (uint32_t)fin.tellg();
+	std::streamoff length = fin.tellg();
 	fin.seekg(0, std::ios::beg);
-	char* buffer = nullptr;
-	buffer = new char[length + 1];
-	buffer[length] = '\0';
-	fin.read(buffer, length);
+	source.assign(static_cast<size_t>(length > 0 ? length : 0), '\0');
+	fin.read(&source[0], source.size());
+	return true;
+}
 
-	// 2. Creer le shader object
-	m_VertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(m_VertexShader, 1, &buffer, nullptr);
-	// 3. Le compiler
-	glCompileShader(m_VertexShader);
-	// 4. Nettoyer
-	delete[] buffer;
-	fin.close();	// non obligatoire ici
+// La compilation est différée à Create() : si le registre a déjà ce programme
+// (autre scène, même sources), aucun shader n'est recompilé.
+bool GLShader::LoadStage(ShaderStage stage, const char* filename)
+{
+	int index = static_cast<int>(stage);
+	std::error_code ec;
+	std::filesystem::path canonical = std::filesystem::weakly_canonical(filename, ec);
+	m_Sources.paths[index] = ec ? std::string(filename) : canonical.string();
+	return ReadSource(filename, m_Sources.code[index]);
+}
 
-	// 5. 
-	// verifie le status de la compilation
-	return ValidateShader(m_VertexShader);
+bool GLShader::LoadVertexShader(const char* filename)
+{
+	return LoadStage(ShaderStage::Vertex, filename);
 }
 
 bool GLShader::LoadGeometryShader(const char* filename)
 {
-	// 1. Charger le fichier en memoire
-	std::ifstream fin(filename, std::ios::in | std::ios::binary);
-	fin.seekg(0, std::ios::end);
-	uint32_t length = (uint32_t)fin.tellg();
-	fin.seekg(0, std::ios::beg);
-	char* buffer = nullptr;
-	buffer = new char[length + 1];
-	buffer[length] = '\0';
-	fin.read(buffer, length);
-
-	// 2. Creer le shader object
-	m_GeometryShader = glCreateShader(GL_GEOMETRY_SHADER);
-	glShaderSource(m_GeometryShader, 1, &buffer, nullptr);
-	// 3. Le compiler
-	glCompileShader(m_GeometryShader);
-	// 4. Nettoyer
-	delete[] buffer;
-	fin.close();	// non obligatoire ici
-
-	// 5. 
-	// verifie le status de la compilation
-	return ValidateShader(m_GeometryShader);
+	return LoadStage(ShaderStage::Geometry, filename);
 }
 
 bool GLShader::LoadFragmentShader(const char* filename)
 {
-	std::ifstream fin(filename, std::ios::in | std::ios::binary);
-	fin.seekg(0, std::ios::end);
-	uint32_t length = (uint32_t)fin.tellg();
-	fin.seekg(0, std::ios::beg);
-	char* buffer = nullptr;
-	buffer = new char[length + 1];
-	buffer[length] = '\0';
-	fin.read(buffer, length);
-
-	// 2. Creer le shader object
-	m_FragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(m_FragmentShader, 1, &buffer, nullptr);
-	// 3. Le compiler
-	glCompileShader(m_FragmentShader);
-	// 4. Nettoyer
-	delete[] buffer;
-	fin.close();	// non obligatoire ici
-
-	// 5. 
-	// verifie le status de la compilation
-	return ValidateShader(m_FragmentShader);
+	return LoadStage(ShaderStage::Fragment, filename);
 }
 
+// Soumet seulement la compilation ; les erreurs de compilation et de link sont
+// rapportées au premier usage du programme (EnsureLinked)
 bool GLShader::Create() {
-    m_Program = glCreateProgram();
-    glAttachShader(m_Program, m_VertexShader);
-    if (m_GeometryShader)
-        glAttachShader(m_Program, m_GeometryShader);
-    glAttachShader(m_Program, m_FragmentShader);
-    glLinkProgram(m_Program);
-
-    int32_t linked = 0;
-    int32_t infoLen = 0;
-    // verification du statut du linkage
-    glGetProgramiv(m_Program, GL_LINK_STATUS, &linked);
-
-    if (!linked)
-    {
-        glGetProgramiv(m_Program, GL_INFO_LOG_LENGTH, &infoLen);
-
-        if (infoLen > 1)
-        {
-            char* infoLog = new char[infoLen + 1];
-
-            glGetProgramInfoLog(m_Program, infoLen, NULL, infoLog);
-            std::cout << "Erreur de lien du programme: " << infoLog << std::endl;
-
-            delete(infoLog);
-        }
+    Destroy();
+    if (m_Sources.Get(ShaderStage::Vertex).empty() || m_Sources.Get(ShaderStage::Fragment).empty()) {
+        return false;
+    }
 
-        glDeleteProgram(m_Program);
+    m_ProgramKey = ProgramRegistry::HashSources(m_Sources);
+    ProgramRegistry::Get().Acquire(m_ProgramKey, m_Sources);
 
-        return false;
+    // Le registre garde sa copie des sources (pour le rechargement à chaud)
+    m_Sources = ProgramSources();
+    return true;
+}
+
+void GLShader::EnsureLinked() const {
+    m_Generation = s_ProgramGeneration;
+    if (m_ProgramKey == 0) {
+        return;
     }
 
-    // Lier les UBOs aux points de binding appropriés
-    GLuint blockIndex = glGetUniformBlockIndex(m_Program, "ProjectionView");
-    if (blockIndex != GL_INVALID_INDEX) {
-        glUniformBlockBinding(m_Program, blockIndex, UBOManager::PROJECTION_VIEW_BINDING);
+    // Un échec laisse m_Program à 0 : l'objet ne sera simplement pas dessiné
+    const ProgramRegistry::Program* program = ProgramRegistry::Get().Link(m_ProgramKey);
+    if (program) {
+        m_Program = program->id;
+        m_Reflection = program->reflection;
     }
+}
+
+// Location d'un nom déjà réfléchi, -1 s'il n'est pas actif
+static GLint FindLocation(const ProgramReflection& reflection, const char* name)
+{
+    auto it = reflection.uniformLocations.find(name);
+    return it != reflection.uniformLocations.end() ? it->second : -1;
+}
 
-    blockIndex = glGetUniformBlockIndex(m_Program, "Transform");
-    if (blockIndex != GL_INVALID_INDEX) {
-        glUniformBlockBinding(m_Program, blockIndex, UBOManager::TRANSFORM_BINDING);
+void GLShader::ReflectUniforms(GLuint program, ProgramReflection& reflection)
+{
+    reflection.uniformLocations.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(maxLength > 0 ? maxLength : 1, '\0');
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, (GLuint)i, maxLength, &length, &size, &type, &name[0]);
+        std::string uniformName(name.c_str(), length);
+
+        GLint location = QueryUniformLocation(program, uniformName.c_str());
+        if (location < 0) {
+            continue;   // uniform d'un bloc (UBO)
+        }
+        reflection.uniformLocations[uniformName] = location;
+
+        // Tableau "a[0]" : enregistrer aussi "a" et chaque élément "a[i]"
+        size_t bracket = uniformName.rfind("[0]");
+        if (bracket != std::string::npos && bracket + 3 == uniformName.size()) {
+            std::string base = uniformName.substr(0, bracket);
+            reflection.uniformLocations[base] = location;
+            for (GLint element = 1; element < size; ++element) {
+                std::string elementName = base + "[" + std::to_string(element) + "]";
+                reflection.uniformLocations[elementName] = QueryUniformLocation(program, elementName.c_str());
+            }
+        }
     }
 
-    return true;
+    for (int i = 0; i < static_cast<int>(Uniform::Count); ++i) {
+        reflection.locations[i] = FindLocation(reflection, s_UniformNames[i]);
+    }
 }
 
 void GLShader::Destroy()
 {
-	glDetachShader(m_Program, m_VertexShader);
-	glDetachShader(m_Program, m_FragmentShader);
-	glDetachShader(m_Program, m_GeometryShader);
-	glDeleteShader(m_GeometryShader);
-	glDeleteShader(m_VertexShader);
-	glDeleteShader(m_FragmentShader);
-	glDeleteProgram(m_Program);
+	if (m_ProgramKey != 0) {
+		ProgramRegistry::Get().Release(m_ProgramKey);
+	}
+	m_Program = 0;
+	m_Generation = 0;
+	m_ProgramKey = 0;
+	m_Reflection = ProgramReflection();
 }
 
 void GLShader::SetBool(const char* name, bool value) {
@@ -214,6 +217,14 @@ void GLShader::SetMat4(const char* name, const float* value) {
 }
 
 GLint GLShader::GetUniformLocation(const char* name) const {
-    return glGetUniformLocation(m_Program, name);
+    if (m_Generation != s_ProgramGeneration) EnsureLinked();
+    auto it = m_Reflection.uniformLocations.find(name);
+    if (it != m_Reflection.uniformLocations.end()) {
+        return it->second;
+    }
+
+    // Uniform inactif (ou éliminé par le compilateur) : -1, mémorisé pour la suite
+    m_Reflection.uniformLocations[name] = -1;
+    return -1;
 }
 
@@ -0,0 +1,192 @@
+#include "../include/GLStateCache.h"
+#include "../include/RenderStats.h"
+
+namespace {
+    const GLuint UNKNOWN = 0xFFFFFFFFu;
+}
+
+GLStateCache& GLStateCache::Get() {
+    static GLStateCache instance;
+    return instance;
+}
+
+void GLStateCache::Invalidate() {
+    m_Program = UNKNOWN;
+    m_VAO = UNKNOWN;
+    m_ActiveUnit = UNKNOWN;
+    for (auto& unit : m_Textures) {
+        for (GLuint& texture : unit) texture = UNKNOWN;
+    }
+    for (GLuint& buffer : m_Buffers) buffer = UNKNOWN;
+    for (IndexedBinding& binding : m_UniformBindings) binding = { UNKNOWN, 0, 0 };
+    for (int8_t& cap : m_Capabilities) cap = -1;
+}
+
+int GLStateCache::TextureTargetIndex(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D: return TEX_2D;
+        case GL_TEXTURE_CUBE_MAP: return TEX_CUBE_MAP;
+        case GL_TEXTURE_BUFFER: return TEX_BUFFER;
+        default: return -1;
+    }
+}
+
+int GLStateCache::BufferTargetIndex(GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER: return BUF_ARRAY;
+        case GL_UNIFORM_BUFFER: return BUF_UNIFORM;
+        case GL_TEXTURE_BUFFER: return BUF_TEXTURE;
+        case GL_PIXEL_UNPACK_BUFFER: return BUF_PIXEL_UNPACK;
+        case GL_DRAW_INDIRECT_BUFFER: return BUF_DRAW_INDIRECT;
+        default: return -1;
+    }
+}
+
+int GLStateCache::CapabilityIndex(GLenum cap) {
+    switch (cap) {
+        case GL_DEPTH_TEST: return CAP_DEPTH_TEST;
+        case GL_CULL_FACE: return CAP_CULL_FACE;
+        case GL_BLEND: return CAP_BLEND;
+        case GL_SCISSOR_TEST: return CAP_SCISSOR_TEST;
+        case GL_STENCIL_TEST: return CAP_STENCIL_TEST;
+        default: return -1;
+    }
+}
+
+void GLStateCache::Skipped() {
+    RenderStats::Get().stateCallsSkipped++;
+}
+
+void GLStateCache::Issued() {
+    RenderStats::Get().stateCallsIssued++;
+}
+
+void GLStateCache::UseProgram(GLuint program) {
+    if (m_Program == program) { Skipped(); return; }
+    glUseProgram(program);
+    m_Program = program;
+    Issued();
+    RenderStats::Get().programSwitches++;
+}
+
+void GLStateCache::BindVertexArray(GLuint vao) {
+    if (m_VAO == vao) { Skipped(); return; }
+    glBindVertexArray(vao);
+    m_VAO = vao;
+    Issued();
+}
+
+void GLStateCache::ActiveTexture(GLuint unit) {
+    if (m_ActiveUnit == unit) { Skipped(); return; }
+    glActiveTexture(GL_TEXTURE0 + unit);
+    m_ActiveUnit = unit;
+    Issued();
+}
+
+void GLStateCache::BindTexture(GLuint unit, GLenum target, GLuint texture) {
+    int index = TextureTargetIndex(target);
+    if (unit < MAX_TEXTURE_UNITS && index >= 0) {
+        if (m_Textures[unit][index] == texture) { Skipped(); return; }
+        m_Textures[unit][index] = texture;
+    }
+    ActiveTexture(unit);
+    glBindTexture(target, texture);
+    Issued();
+    RenderStats::Get().textureBinds++;
+}
+
+void GLStateCache::BindBuffer(GLenum target, GLuint buffer) {
+    int index = BufferTargetIndex(target);
+    if (index >= 0) {
+        if (m_Buffers[index] == buffer) { Skipped(); return; }
+        m_Buffers[index] = buffer;
+    }
+    glBindBuffer(target, buffer);
+    Issued();
+}
+
+void GLStateCache::BindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    BindBufferRange(target, index, buffer, 0, -1);
+}
+
+void GLStateCache::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    bool tracked = target == GL_UNIFORM_BUFFER && index < MAX_UNIFORM_BINDINGS;
+    if (tracked) {
+        IndexedBinding& binding = m_UniformBindings[index];
+        if (binding.buffer == buffer && binding.offset == offset && binding.size == size) { Skipped(); return; }
+        binding = { buffer, offset, size };
+    }
+    if (size < 0) {
+        glBindBufferBase(target, index, buffer);
+    } else {
+        glBindBufferRange(target, index, buffer, offset, size);
+    }
+    Issued();
+
+    int generic = BufferTargetIndex(target);
+    if (generic >= 0) {
+        m_Buffers[generic] = buffer;
+    }
+}
+
+void GLStateCache::SetEnabled(GLenum cap, bool enabled) {
+    int index = CapabilityIndex(cap);
+    if (index >= 0) {
+        if (m_Capabilities[index] == (enabled ? 1 : 0)) { Skipped(); return; }
+        m_Capabilities[index] = enabled ? 1 : 0;
+    }
+    if (enabled) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+    Issued();
+}
+
+bool GLStateCache::IsEnabled(GLenum cap) {
+    int index = CapabilityIndex(cap);
+    if (index >= 0 && m_Capabilities[index] >= 0) {
+        return m_Capabilities[index] == 1;
+    }
+    bool enabled = glIsEnabled(cap) == GL_TRUE;
+    if (index >= 0) {
+        m_Capabilities[index] = enabled ? 1 : 0;
+    }
+    return enabled;
+}
+
+void GLStateCache::DeleteProgram(GLuint program) {
+    // Un programme actif supprimé reste utilisé jusqu'au prochain glUseProgram
+    if (m_Program == program) m_Program = UNKNOWN;
+    glDeleteProgram(program);
+}
+
+void GLStateCache::DeleteVertexArrays(GLsizei count, const GLuint* vaos) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (m_VAO == vaos[i]) m_VAO = UNKNOWN;
+    }
+    glDeleteVertexArrays(count, vaos);
+}
+
+void GLStateCache::DeleteTextures(GLsizei count, const GLuint* textures) {
+    for (GLsizei i = 0; i < count; ++i) {
+        for (auto& unit : m_Textures) {
+            for (GLuint& texture : unit) {
+                if (texture == textures[i]) texture = UNKNOWN;
+            }
+        }
+    }
+    glDeleteTextures(count, textures);
+}
+
+void GLStateCache::DeleteBuffers(GLsizei count, const GLuint* buffers) {
+    for (GLsizei i = 0; i < count; ++i) {
+        for (GLuint& buffer : m_Buffers) {
+            if (buffer == buffers[i]) buffer = UNKNOWN;
+        }
+        for (IndexedBinding& binding : m_UniformBindings) {
+            if (binding.buffer == buffers[i]) binding.buffer = UNKNOWN;
+        }
+    }
+    glDeleteBuffers(count, buffers);
+}
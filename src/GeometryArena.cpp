@@ -0,0 +1,214 @@
+#include "../include/GeometryArena.h"
+#include "../include/GLStateCache.h"
+#include <algorithm>
+#include <cstddef>
+
+GeometryArena& GeometryArena::Get() {
+    static GeometryArena instance;
+    return instance;
+}
+
+void GeometryArena::Cleanup() {
+    GLStateCache& state = GLStateCache::Get();
+    if (m_VAO) state.DeleteVertexArrays(1, &m_VAO);
+    for (Region* region : { &m_Vertices, &m_Indices }) {
+        if (region->buffer) state.DeleteBuffers(1, &region->buffer);
+        *region = Region();
+    }
+    m_VAO = 0;
+    m_Ranges.clear();
+    m_FreeHandles.clear();
+    m_Generation++;
+}
+
+void GeometryArena::BuffersChanged() {
+    m_Generation++;
+    if (m_VAO) {
+        GLStateCache& state = GLStateCache::Get();
+        state.BindVertexArray(m_VAO);
+        SetupVertexArray();
+        // Plus de VAO actif : un GL_ELEMENT_ARRAY_BUFFER lié ailleurs ne le modifiera pas
+        state.BindVertexArray(0);
+    }
+}
+
+void GeometryArena::Resize(Region& region, size_t capacity) {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+
+    // Les cibles de copie ne touchent ni au VAO lié ni à GL_ARRAY_BUFFER
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, capacity * region.elementSize, nullptr, GL_STATIC_DRAW);
+    if (region.buffer) {
+        state.BindBuffer(GL_COPY_READ_BUFFER, region.buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                            region.allocator.GetEnd() * region.elementSize);
+        state.DeleteBuffers(1, &region.buffer);
+    }
+    region.buffer = buffer;
+    region.allocator.Grow(capacity);
+}
+
+size_t GeometryArena::AllocateIn(Region& region, size_t count) {
+    size_t offset = region.allocator.Allocate(count);
+    if (offset == RangeAllocator::INVALID) {
+        RangeAllocator& allocator = region.allocator;
+        Resize(region, std::max(allocator.GetCapacity() * 2, allocator.GetEnd() + count));
+        BuffersChanged();
+        offset = allocator.Allocate(count);
+    }
+    return offset;
+}
+
+void GeometryArena::Upload(Region& region, size_t offset, const void* data, size_t count) {
+    GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, region.buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset * region.elementSize, count * region.elementSize, data);
+}
+
+ArenaHandle GeometryArena::Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    if (vertices.empty() || indices.empty()) {
+        return INVALID_ARENA_HANDLE;
+    }
+    if (!m_VAO) {
+        m_Vertices.elementSize = sizeof(Vertex);
+        m_Indices.elementSize = sizeof(unsigned int);
+        Resize(m_Vertices, INITIAL_VERTICES);
+        Resize(m_Indices, INITIAL_INDICES);
+        glGenVertexArrays(1, &m_VAO);
+        BuffersChanged();
+    }
+
+    // Les index restent locaux à la géométrie : baseVertex les décale au draw
+    ArenaRange range;
+    range.baseVertex = static_cast<GLint>(AllocateIn(m_Vertices, vertices.size()));
+    range.vertexCount = static_cast<GLuint>(vertices.size());
+    range.firstIndex = static_cast<GLuint>(AllocateIn(m_Indices, indices.size()));
+    range.indexCount = static_cast<GLsizei>(indices.size());
+    Upload(m_Vertices, range.baseVertex, vertices.data(), vertices.size());
+    Upload(m_Indices, range.firstIndex, indices.data(), indices.size());
+
+    ArenaHandle handle;
+    if (!m_FreeHandles.empty()) {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+        m_Ranges[handle] = range;
+    } else {
+        handle = static_cast<ArenaHandle>(m_Ranges.size());
+        m_Ranges.push_back(range);
+    }
+    m_TotalAllocations++;
+    return handle;
+}
+
+void GeometryArena::Free(ArenaHandle handle) {
+    // Poignée d'avant un Cleanup : les buffers sont déjà partis
+    if (handle >= m_Ranges.size() || !m_Ranges[handle].IsValid()) {
+        return;
+    }
+    const ArenaRange& range = m_Ranges[handle];
+    m_Vertices.allocator.Free(range.baseVertex, range.vertexCount);
+    m_Indices.allocator.Free(range.firstIndex, range.indexCount);
+    m_Ranges[handle] = ArenaRange();
+    m_FreeHandles.push_back(handle);
+    m_Frees++;
+}
+
+ArenaRange GeometryArena::GetRange(ArenaHandle handle) const {
+    return handle < m_Ranges.size() ? m_Ranges[handle] : ArenaRange();
+}
+
+void GeometryArena::Compact(Region& region, bool vertices) {
+    // Allocations dans l'ordre du buffer, recopiées bout à bout dans un nouveau buffer
+    std::vector<ArenaHandle> order;
+    order.reserve(m_Ranges.size());
+    for (ArenaHandle handle = 0; handle < m_Ranges.size(); ++handle) {
+        if (m_Ranges[handle].IsValid()) {
+            order.push_back(handle);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](ArenaHandle a, ArenaHandle b) {
+        return vertices ? m_Ranges[a].baseVertex < m_Ranges[b].baseVertex
+                        : m_Ranges[a].firstIndex < m_Ranges[b].firstIndex;
+    });
+
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, region.allocator.GetCapacity() * region.elementSize, nullptr, GL_STATIC_DRAW);
+    state.BindBuffer(GL_COPY_READ_BUFFER, region.buffer);
+
+    // Les allocations déjà contiguës partent en une seule copie
+    size_t packed = 0;
+    size_t runSource = 0, runTarget = 0, runCount = 0;
+    for (ArenaHandle handle : order) {
+        ArenaRange& range = m_Ranges[handle];
+        size_t source = vertices ? range.baseVertex : range.firstIndex;
+        size_t count = vertices ? range.vertexCount : range.indexCount;
+        if (runCount > 0 && source != runSource + runCount) {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, runSource * region.elementSize,
+                                runTarget * region.elementSize, runCount * region.elementSize);
+            runCount = 0;
+        }
+        if (runCount == 0) {
+            runSource = source;
+            runTarget = packed;
+        }
+        runCount += count;
+
+        if (vertices) {
+            range.baseVertex = static_cast<GLint>(packed);
+        } else {
+            range.firstIndex = static_cast<GLuint>(packed);
+        }
+        packed += count;
+    }
+    if (runCount > 0) {
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, runSource * region.elementSize,
+                            runTarget * region.elementSize, runCount * region.elementSize);
+    }
+
+    state.DeleteBuffers(1, &region.buffer);
+    region.buffer = buffer;
+    region.allocator.SetPacked(packed);
+}
+
+void GeometryArena::Defragment() {
+    if (!m_VAO) {
+        return;
+    }
+    Compact(m_Vertices, true);
+    Compact(m_Indices, false);
+    m_Defragmentations++;
+    BuffersChanged();
+}
+
+void GeometryArena::SetupVertexArray() const {
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_Vertices.buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Indices.buffer);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uv));
+}
+
+GeometryArena::Stats GeometryArena::GetStats() const {
+    Stats stats;
+    stats.liveAllocations = m_Ranges.size() - m_FreeHandles.size();
+    stats.totalAllocations = m_TotalAllocations;
+    stats.frees = m_Frees;
+    stats.defragmentations = m_Defragmentations;
+    for (const Region* region : { &m_Vertices, &m_Indices }) {
+        const RangeAllocator& allocator = region->allocator;
+        stats.bytesUsed += allocator.GetLiveCount() * region->elementSize;
+        stats.bytesReserved += allocator.GetCapacity() * region->elementSize;
+        stats.holeBytes += allocator.GetHoleSize() * region->elementSize;
+        stats.holeCount += allocator.GetHoleCount();
+        stats.fragmentation = std::max(stats.fragmentation, allocator.GetFragmentation());
+    }
+    return stats;
+}
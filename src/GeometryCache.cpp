@@ -0,0 +1,491 @@
+#include "../include/GeometryCache.h"
+#include "../include/MeshCacheFile.h"
+#include "../include/MeshSimplifier.h"
+#include "../include/ThreadPool.h"
+#include "../include/tiny_obj_loader.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <algorithm>
+
+// ==================== MeshGeometry ====================
+
+MeshGeometry::~MeshGeometry() {
+    // La construction en cours lit vertices et indices
+    if (m_TriangleBVHBuild.valid()) {
+        m_TriangleBVHBuild.wait();
+    }
+    GeometryArena::Get().Free(arenaHandle);
+}
+
+void MeshGeometry::Upload() {
+    for (const auto& lod : lods) {
+        lod->Upload();
+    }
+    GeometryArena::Get().Free(arenaHandle);
+    arenaHandle = GeometryArena::Get().Allocate(vertices, indices);
+}
+
+void MeshGeometry::ComputeBounds() {
+    if (vertices.empty()) {
+        boundsMin[0] = boundsMin[1] = boundsMin[2] = 0.0f;
+        boundsMax[0] = boundsMax[1] = boundsMax[2] = 0.0f;
+        boundsRadius = 0.0f;
+        return;
+    }
+
+    for (int axis = 0; axis < 3; ++axis) {
+        boundsMin[axis] = boundsMax[axis] = vertices[0].position[axis];
+    }
+    for (const Vertex& vertex : vertices) {
+        for (int axis = 0; axis < 3; ++axis) {
+            boundsMin[axis] = std::min(boundsMin[axis], vertex.position[axis]);
+            boundsMax[axis] = std::max(boundsMax[axis], vertex.position[axis]);
+        }
+    }
+
+    // Sphère centrée sur la boîte : plus serrée que sa demi-diagonale
+    float center[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        center[axis] = 0.5f * (boundsMin[axis] + boundsMax[axis]);
+    }
+    float maxDistanceSq = 0.0f;
+    for (const Vertex& vertex : vertices) {
+        float dx = vertex.position[0] - center[0];
+        float dy = vertex.position[1] - center[1];
+        float dz = vertex.position[2] - center[2];
+        maxDistanceSq = std::max(maxDistanceSq, dx * dx + dy * dy + dz * dz);
+    }
+    boundsRadius = std::sqrt(maxDistanceSq);
+}
+
+void MeshGeometry::RequestTriangleBVH() {
+    if (m_TriangleBVHBuild.valid() || indices.empty()) {
+        return;
+    }
+    // Sommets et indices ne changent plus après le chargement
+    m_TriangleBVHBuild = ThreadPool::Get().Submit([this]() {
+        m_TriangleBVH.Build(vertices, indices);
+        m_TriangleBVHReady.store(true, std::memory_order_release);
+    });
+}
+
+const TriangleBVH* MeshGeometry::GetTriangleBVH() {
+    if (m_TriangleBVHReady.load(std::memory_order_acquire)) {
+        return &m_TriangleBVH;
+    }
+    RequestTriangleBVH();
+    return nullptr;
+}
+
+size_t MeshGeometry::GetByteSize() const {
+    size_t bytes = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int);
+    for (const auto& lod : lods) {
+        bytes += lod->GetByteSize();
+    }
+    return bytes;
+}
+
+const MeshGeometry& MeshGeometry::GetLevel(int level) const {
+    if (level <= 0 || lods.empty()) {
+        return *this;
+    }
+    return *lods[std::min(level, static_cast<int>(lods.size())) - 1];
+}
+
+// ==================== GeometryCache ====================
+
+GeometryCache& GeometryCache::Get() {
+    static GeometryCache instance;
+    return instance;
+}
+
+std::shared_ptr<MeshGeometry> GeometryCache::Find(const std::string& key) {
+    auto it = m_Entries.find(key);
+    if (it == m_Entries.end()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<MeshGeometry> geometry = it->second.lock();
+    if (!geometry) {
+        // Plus aucun mesh ne l'utilise : la géométrie a déjà été libérée
+        m_Entries.erase(it);
+        return nullptr;
+    }
+
+    m_Hits++;
+    m_BytesSaved += geometry->GetByteSize();
+    return geometry;
+}
+
+void GeometryCache::Insert(const std::string& key, const std::shared_ptr<MeshGeometry>& geometry) {
+    m_Misses++;
+    m_Entries[key] = geometry;
+}
+
+std::shared_ptr<MeshGeometry> GeometryCache::GetSphere(float radius, int sectors, int stacks) {
+    char key[64];
+    snprintf(key, sizeof(key), "sphere:%g:%d:%d", radius, sectors, stacks);
+
+    if (auto geometry = Find(key)) {
+        return geometry;
+    }
+
+    auto geometry = std::make_shared<MeshGeometry>();
+    BuildSphere(radius, sectors, stacks, *geometry);
+    geometry->ComputeBounds();
+    BuildSphereLODs(radius, sectors, stacks, *geometry);
+    geometry->Upload();
+    // Modèles importés : l'arbre de picking est prêt bien avant le premier clic
+    geometry->RequestTriangleBVH();
+    Insert(key, geometry);
+    return geometry;
+}
+
+std::string GeometryCache::MakeOBJKey(const std::string& filename, const ObjImportOptions& options) {
+    std::error_code ec;
+    std::filesystem::path absolutePath = std::filesystem::absolute(filename, ec);
+    return (options.weldByValue ? "obj-welded:" : "obj:") +
+        (ec ? filename : absolutePath.lexically_normal().string());
+}
+
+std::shared_ptr<MeshGeometry> GeometryCache::GetOBJ(const std::string& filename, const ObjImportOptions& options) {
+    if (auto geometry = Find(MakeOBJKey(filename, options))) {
+        std::cout << "Geometry cache hit: " << filename << std::endl;
+        return geometry;
+    }
+
+    auto geometry = LoadOBJGeometry(filename, options);
+    if (!geometry) {
+        return nullptr;
+    }
+    return AdoptOBJ(filename, options, geometry);
+}
+
+std::shared_ptr<MeshGeometry> GeometryCache::LoadOBJGeometry(const std::string& filename, const ObjImportOptions& options) {
+    // Le cache binaire évite l'analyse et la déduplication quand il est à jour
+    auto geometry = std::make_shared<MeshGeometry>();
+    uint32_t importFlags = options.weldByValue ? MeshCacheFile::FLAG_WELD_BY_VALUE : 0;
+    if (!MeshCacheFile::Load(filename, importFlags, *geometry)) {
+        if (!ParseOBJ(filename, options, *geometry)) {
+            return nullptr;
+        }
+        geometry->ComputeBounds();
+        BuildSimplifiedLODs(*geometry);
+        MeshCacheFile::Save(filename, importFlags, *geometry);
+    }
+    return geometry;
+}
+
+std::shared_ptr<MeshGeometry> GeometryCache::AdoptOBJ(const std::string& filename, const ObjImportOptions& options,
+                                                      const std::shared_ptr<MeshGeometry>& geometry) {
+    std::string key = MakeOBJKey(filename, options);
+
+    // Le même fichier a pu être chargé pendant l'import : on garde l'existant
+    if (auto existing = Find(key)) {
+        return existing;
+    }
+
+    geometry->Upload();
+    // Modèles importés : l'arbre de picking est prêt bien avant le premier clic
+    geometry->RequestTriangleBVH();
+    Insert(key, geometry);
+    return geometry;
+}
+
+GeometryCache::Stats GeometryCache::GetStats() const {
+    Stats stats;
+    stats.hits = m_Hits;
+    stats.misses = m_Misses;
+    stats.bytesSaved = m_BytesSaved;
+    for (const auto& entry : m_Entries) {
+        if (auto geometry = entry.second.lock()) {
+            stats.liveEntries++;
+            stats.residentBytes += geometry->GetByteSize();
+        }
+    }
+    return stats;
+}
+
+void GeometryCache::ResetStats() {
+    m_Hits = m_Misses = m_BytesSaved = 0;
+}
+
+void GeometryCache::BuildSphere(float radius, int sectors, int stacks, MeshGeometry& geometry) {
+    geometry.vertices.clear();
+    geometry.indices.clear();
+    geometry.vertices.reserve((stacks + 1) * (sectors + 1));
+    geometry.indices.reserve(stacks * sectors * 6);
+
+    float sectorStep = static_cast<float>(2.0 * M_PI / sectors);
+    float stackStep = static_cast<float>(M_PI / stacks);
+
+    // Générer les vertices
+    for(int i = 0; i <= stacks; ++i) {
+        float stackAngle = static_cast<float>(M_PI / 2 - i * stackStep);
+        float xy = radius * std::cos(stackAngle);
+        float z = radius * std::sin(stackAngle);
+
+        for(int j = 0; j <= sectors; ++j) {
+            float sectorAngle = j * sectorStep;
+
+            // Position
+            float x = xy * std::cos(sectorAngle);
+            float y = xy * std::sin(sectorAngle);
+            
+            // Normal
+            float nx = x / radius;
+            float ny = y / radius;
+            float nz = z / radius;
+
+            // UV
+            float u = static_cast<float>(j) / sectors;
+            float v = static_cast<float>(i) / stacks;
+
+            Vertex vertex;
+            vertex.position[0] = x;
+            vertex.position[1] = y;
+            vertex.position[2] = z;
+            vertex.normal[0] = nx;
+            vertex.normal[1] = ny;
+            vertex.normal[2] = nz;
+            vertex.uv[0] = u;
+            vertex.uv[1] = v;
+            geometry.vertices.push_back(vertex);
+        }
+    }
+
+    // Générer les indices
+    for(int i = 0; i < stacks; ++i) {
+        for(int j = 0; j < sectors; ++j) {
+            int k1 = i * (sectors + 1) + j;
+            int k2 = k1 + 1;
+            int k3 = k1 + (sectors + 1);
+            int k4 = k3 + 1;
+
+            geometry.indices.push_back(k1);
+            geometry.indices.push_back(k2);
+            geometry.indices.push_back(k3);
+
+            geometry.indices.push_back(k2);
+            geometry.indices.push_back(k4);
+            geometry.indices.push_back(k3);
+        }
+    }
+
+}
+
+void GeometryCache::BuildSphereLODs(float radius, int sectors, int stacks, MeshGeometry& geometry) {
+    // Tessellation divisée par deux à chaque niveau, jusqu'à 6x4 (32x32 : 16x16, 8x8, 6x4)
+    geometry.lods.clear();
+    int lodSectors = sectors, lodStacks = stacks;
+    for (int level = 1; level <= MAX_LOD_LEVELS; ++level) {
+        int nextSectors = std::max(lodSectors / 2, 6);
+        int nextStacks = std::max(lodStacks / 2, 4);
+        if (nextSectors == lodSectors && nextStacks == lodStacks) {
+            break;
+        }
+        lodSectors = nextSectors;
+        lodStacks = nextStacks;
+
+        auto lod = std::make_shared<MeshGeometry>();
+        BuildSphere(radius, lodSectors, lodStacks, *lod);
+        lod->ComputeBounds();
+        geometry.lods.push_back(lod);
+    }
+}
+
+void GeometryCache::BuildSimplifiedLODs(MeshGeometry& geometry) {
+    // Chaque niveau garde la moitié des triangles du précédent ; on s'arrête quand
+    // le mesh devient trop petit ou que les bords bloquent la réduction
+    geometry.lods.clear();
+    const MeshGeometry* previous = &geometry;
+    for (int level = 1; level <= MAX_LOD_LEVELS; ++level) {
+        size_t triangles = previous->indices.size() / 3;
+        if (triangles < 2 * MIN_LOD_TRIANGLES) {
+            break;
+        }
+        MeshSimplifier::Result result = MeshSimplifier::Simplify(previous->vertices, previous->indices, triangles / 2);
+        if (result.indices.size() / 3 > triangles * 3 / 4) {
+            break;
+        }
+
+        auto lod = std::make_shared<MeshGeometry>();
+        lod->vertices.swap(result.vertices);
+        lod->indices.swap(result.indices);
+        lod->ComputeBounds();
+        geometry.lods.push_back(lod);
+        previous = lod.get();
+    }
+    if (!geometry.lods.empty()) {
+        std::cout << "Built " << geometry.lods.size() << " LOD level(s) down to "
+                  << geometry.lods.back()->indices.size() / 3 << " triangles" << std::endl;
+    }
+}
+
+bool GeometryCache::ParseOBJ(const std::string& filename, const ObjImportOptions& options, MeshGeometry& geometry) {
+    std::cout << "\n=== Loading OBJ: " << filename << " ===" << std::endl;
+
+    std::string baseDir = std::filesystem::path(filename).parent_path().string();
+    std::cout << "Base directory: " << baseDir << std::endl;
+
+    // Analyse parallèle sur le pool ; tinyobj reste le recours pour les OBJ
+    // que le lecteur rapide ne couvre pas
+    ObjParseResult parsed;
+    std::string parseError;
+    if (!ObjImporter::ParseParallel(filename, ThreadPool::Get(), parsed, parseError)) {
+        std::cout << "Parallel OBJ parser fell back to tinyobj: " << parseError << std::endl;
+        parsed = ObjParseResult();
+
+        std::string warn, err;
+        bool ret = tinyobj::LoadObj(
+            &parsed.attrib, &parsed.shapes, &parsed.materials, &warn, &err,
+            filename.c_str(), baseDir.c_str(),
+            true  // triangulate
+        );
+
+        if (!ret || parsed.shapes.empty()) {
+            std::cerr << "Failed to load OBJ file: " << filename << std::endl;
+            if (!err.empty()) std::cerr << err << std::endl;
+            return false;
+        }
+
+        if (!warn.empty()) {
+            std::cout << "OBJ loading warnings: " << warn << std::endl;
+        }
+    }
+
+    geometry.vertices.clear();
+    geometry.indices.clear();
+
+    SelectSourceMaterial(parsed.materials, baseDir, geometry);
+
+    // Soudure des sommets par table de hachage plate (voir ObjImporter)
+    ObjImporter::BuildIndexedMesh(parsed.attrib, parsed.shapes, options, geometry.vertices, geometry.indices);
+
+    // Calculer les normales si elles sont manquantes
+    CalculateNormalsIfNeeded(geometry);
+    
+    std::cout << "Loaded mesh with " << geometry.vertices.size() << " vertices and " 
+              << geometry.indices.size() / 3 << " triangles" << std::endl;
+    return true;
+}
+
+void GeometryCache::SelectSourceMaterial(const std::vector<tinyobj::material_t>& materials, const std::string& baseDir,
+                                         MeshGeometry& geometry) {
+    // Le premier matériau dont la texture existe sur disque est retenu,
+    // sinon le premier matériau du fichier
+    const tinyobj::material_t* selected = materials.empty() ? nullptr : &materials[0];
+    for (const auto& mat : materials) {
+        if (mat.diffuse_texname.empty()) continue;
+        std::cout << "Found material with texture: " << mat.diffuse_texname << std::endl;
+
+        std::vector<std::string> possiblePaths = {
+            (std::filesystem::path(baseDir) / mat.diffuse_texname).string(),
+            mat.diffuse_texname,
+            (std::filesystem::path(baseDir) / std::filesystem::path(mat.diffuse_texname).filename()).string()
+        };
+
+        for (const auto& path : possiblePaths) {
+            std::cout << "Trying path: " << path << std::endl;
+            if (std::filesystem::exists(path)) {
+                geometry.texturePath = path;
+                break;
+            }
+        }
+
+        if (!geometry.texturePath.empty()) {
+            selected = &mat;
+            break;
+        }
+    }
+
+    if (selected) {
+        geometry.hasSourceMaterial = true;
+        geometry.sourceMaterial.diffuse[0] = selected->diffuse[0];
+        geometry.sourceMaterial.diffuse[1] = selected->diffuse[1];
+        geometry.sourceMaterial.diffuse[2] = selected->diffuse[2];
+        geometry.sourceMaterial.specular[0] = selected->specular[0];
+        geometry.sourceMaterial.specular[1] = selected->specular[1];
+        geometry.sourceMaterial.specular[2] = selected->specular[2];
+        geometry.sourceMaterial.shininess = selected->shininess;
+    }
+}
+
+// Fonction helper pour calculer les normales manquantes
+void GeometryCache::CalculateNormalsIfNeeded(MeshGeometry& geometry) {
+    // Vérifier si on a besoin de calculer les normales
+    bool needsNormals = false;
+    for (const auto& vertex : geometry.vertices) {
+        if (vertex.normal[0] == 0.0f && vertex.normal[1] == 0.0f && vertex.normal[2] == 0.0f) {
+            needsNormals = true;
+            break;
+        }
+    }
+    
+    if (!needsNormals) return;
+    
+    // Réinitialiser toutes les normales
+    for (auto& vertex : geometry.vertices) {
+        vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+    }
+    
+    // Calculer les normales par triangle
+    for (size_t i = 0; i < geometry.indices.size(); i += 3) {
+        if (i + 2 >= geometry.indices.size()) break;
+        
+        unsigned int i0 = geometry.indices[i];
+        unsigned int i1 = geometry.indices[i + 1];
+        unsigned int i2 = geometry.indices[i + 2];
+        
+        if (i0 >= geometry.vertices.size() || i1 >= geometry.vertices.size() || i2 >= geometry.vertices.size()) continue;
+        
+        // Calculer les vecteurs des arêtes
+        float v1[3] = {
+            geometry.vertices[i1].position[0] - geometry.vertices[i0].position[0],
+            geometry.vertices[i1].position[1] - geometry.vertices[i0].position[1],
+            geometry.vertices[i1].position[2] - geometry.vertices[i0].position[2]
+        };
+        
+        float v2[3] = {
+            geometry.vertices[i2].position[0] - geometry.vertices[i0].position[0],
+            geometry.vertices[i2].position[1] - geometry.vertices[i0].position[1],
+            geometry.vertices[i2].position[2] - geometry.vertices[i0].position[2]
+        };
+        
+        // Produit vectoriel pour obtenir la normale
+        float normal[3] = {
+            v1[1] * v2[2] - v1[2] * v2[1],
+            v1[2] * v2[0] - v1[0] * v2[2],
+            v1[0] * v2[1] - v1[1] * v2[0]
+        };
+        
+        // Normaliser
+        float length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length > 0.0f) {
+            normal[0] /= length;
+            normal[1] /= length;
+            normal[2] /= length;
+        }
+        
+        // Ajouter aux geometry.vertices du triangle
+        for (int j = 0; j < 3; j++) {
+            geometry.vertices[geometry.indices[i + j]].normal[0] += normal[0];
+            geometry.vertices[geometry.indices[i + j]].normal[1] += normal[1];
+            geometry.vertices[geometry.indices[i + j]].normal[2] += normal[2];
+        }
+    }
+    
+    // Renormaliser les normales finales
+    for (auto& vertex : geometry.vertices) {
+        float length = sqrt(vertex.normal[0] * vertex.normal[0] + 
+                           vertex.normal[1] * vertex.normal[1] + 
+                           vertex.normal[2] * vertex.normal[2]);
+        if (length > 0.0f) {
+            vertex.normal[0] /= length;
+            vertex.normal[1] /= length;
+            vertex.normal[2] /= length;
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include "../include/IndirectRenderer.h"
+#include "../include/GeometryArena.h"
+#include "../include/GLStateCache.h"
+#include "../include/MaterialBuffer.h"
+#include "../include/RenderStats.h"
+#include <iostream>
+
+bool IndirectRenderer::s_Enabled = true;
+
+bool IndirectRenderer::IsSupported() {
+    // glMultiDrawElementsIndirect, SSBO et baseInstance : cœur de GL 4.3
+    return GLEW_VERSION_4_3;
+}
+
+bool IndirectRenderer::Initialize(const std::string& vertexPath, const std::string& fragmentPath) {
+    if (!IsSupported()) {
+        std::cout << "OpenGL 4.3 unavailable: indirect rendering disabled" << std::endl;
+        return false;
+    }
+    if (!m_Shader.LoadVertexShader(vertexPath.c_str()) ||
+        !m_Shader.LoadFragmentShader(fragmentPath.c_str()) ||
+        !m_Shader.Create()) {
+        std::cerr << "Failed to create indirect shader program" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(1, &m_CommandBuffer);
+    glGenBuffers(1, &m_DrawDataBuffer);
+    glGenBuffers(1, &m_DrawIndexBuffer);
+    return true;
+}
+
+void IndirectRenderer::Cleanup() {
+    GLStateCache& state = GLStateCache::Get();
+    if (m_CommandBuffer) {
+        GLuint buffers[] = { m_CommandBuffer, m_DrawDataBuffer, m_DrawIndexBuffer };
+        state.DeleteBuffers(3, buffers);
+        m_Shader.Destroy();
+    }
+    if (m_VAO) {
+        state.DeleteVertexArrays(1, &m_VAO);
+    }
+    m_VAO = m_CommandBuffer = m_DrawDataBuffer = m_DrawIndexBuffer = 0;
+    m_CommandCapacity = m_DrawDataCapacity = m_DrawIndexCount = 0;
+    m_Batches.clear();
+}
+
+void IndirectRenderer::Begin() {
+    for (auto& entry : m_Batches) {
+        entry.second.commands.clear();
+        entry.second.draws.clear();
+    }
+}
+
+bool IndirectRenderer::Submit(Mesh* mesh) {
+    if (!s_Enabled || !IsInitialized() || !mesh) {
+        return false;
+    }
+    ArenaRange range = mesh->getArenaRange();
+    if (!range.IsValid()) {
+        return false;
+    }
+
+    // Même règle que Mesh::draw pour l'affichage de la texture
+    const Material& material = mesh->getMaterial();
+    bool hasTexture = material.diffuseMap.GetID() != 0 && mesh->isTextureEnabled();
+
+    Batch& batch = m_Batches[hasTexture ? material.diffuseMap.GetID() : 0];
+    batch.commands.push_back({ static_cast<GLuint>(range.indexCount), 1, range.firstIndex, range.baseVertex, 0 });
+    batch.draws.emplace_back();
+    IndirectDrawData& draw = batch.draws.back();
+    mesh->calculateModelMatrix(draw.model);
+    draw.material = mesh->getMaterialSlot();
+    draw.hasTexture = hasTexture ? 1u : 0u;
+    return true;
+}
+
+void IndirectRenderer::Upload(GLenum target, GLuint buffer, size_t& capacity, const void* data, size_t bytes) {
+    GLStateCache::Get().BindBuffer(target, buffer);
+    if (bytes > capacity) {
+        capacity = bytes * 2;
+    }
+    // Orphelinage du buffer pour ne pas attendre la frame précédente
+    glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, bytes, data);
+}
+
+void IndirectRenderer::SetupVertexArray() {
+    GLStateCache& state = GLStateCache::Get();
+    if (!m_VAO) {
+        glGenVertexArrays(1, &m_VAO);
+    }
+    state.BindVertexArray(m_VAO);
+    GeometryArena::Get().SetupVertexArray();
+
+    // a_drawIndex : la valeur d'instance 0 décalée de baseInstance donne l'index du draw
+    state.BindBuffer(GL_ARRAY_BUFFER, m_DrawIndexBuffer);
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+    glVertexAttribDivisor(3, 1);
+    m_ArenaGeneration = GeometryArena::Get().GetGeneration();
+}
+
+void IndirectRenderer::Flush() {
+    if (!IsInitialized()) {
+        return;
+    }
+
+    // Toutes les commandes et données de la frame partent en deux transferts
+    m_Commands.clear();
+    m_Draws.clear();
+    for (auto& entry : m_Batches) {
+        Batch& batch = entry.second;
+        for (DrawElementsIndirectCommand& command : batch.commands) {
+            command.baseInstance = static_cast<GLuint>(m_Draws.size() + (&command - batch.commands.data()));
+        }
+        m_Commands.insert(m_Commands.end(), batch.commands.begin(), batch.commands.end());
+        m_Draws.insert(m_Draws.end(), batch.draws.begin(), batch.draws.end());
+    }
+    if (m_Commands.empty()) {
+        return;
+    }
+
+    GLStateCache& state = GLStateCache::Get();
+    if (m_DrawIndexCount < m_Draws.size()) {
+        std::vector<GLuint> drawIndices(m_Draws.size() * 2);
+        for (size_t i = 0; i < drawIndices.size(); ++i) {
+            drawIndices[i] = static_cast<GLuint>(i);
+        }
+        state.BindBuffer(GL_ARRAY_BUFFER, m_DrawIndexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, drawIndices.size() * sizeof(GLuint), drawIndices.data(), GL_STATIC_DRAW);
+        m_DrawIndexCount = drawIndices.size();
+    }
+    if (!m_VAO || m_ArenaGeneration != GeometryArena::Get().GetGeneration()) {
+        SetupVertexArray();
+    }
+
+    Upload(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer, m_CommandCapacity,
+           m_Commands.data(), m_Commands.size() * sizeof(DrawElementsIndirectCommand));
+    Upload(GL_SHADER_STORAGE_BUFFER, m_DrawDataBuffer, m_DrawDataCapacity,
+           m_Draws.data(), m_Draws.size() * sizeof(IndirectDrawData));
+    state.BindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, m_DrawDataBuffer);
+    MaterialBuffer::Get().BindStorage(MATERIAL_STORAGE_BINDING);
+
+    state.BindVertexArray(m_VAO);
+    GLint loc_texture = m_Shader.GetLocation(Uniform::Texture);
+    if (loc_texture >= 0) glUniform1i(loc_texture, 0);
+    GLint loc_drawOffset = m_Shader.GetLocation(Uniform::DrawOffset);
+
+    RenderStats& stats = RenderStats::Get();
+    size_t first = 0;
+    for (auto& entry : m_Batches) {
+        Batch& batch = entry.second;
+        if (batch.commands.empty()) {
+            continue;
+        }
+        state.BindTexture(0, GL_TEXTURE_2D, entry.first);
+        if (loc_drawOffset >= 0) glUniform1ui(loc_drawOffset, static_cast<GLuint>(first));
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+            (const void*)(first * sizeof(DrawElementsIndirectCommand)),
+            static_cast<GLsizei>(batch.commands.size()), 0);
+
+        stats.indirectDrawCalls++;
+        stats.indirectDraws += static_cast<int>(batch.commands.size());
+        for (const DrawElementsIndirectCommand& command : batch.commands) {
+            stats.triangles += static_cast<int>(command.count / 3);
+        }
+        first += batch.commands.size();
+    }
+}
@@ -0,0 +1,189 @@
+#include "../include/InstancedRenderer.h"
+#include "../include/GLStateCache.h"
+#include "../include/RenderStats.h"
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+// Première location d'attribut réservée aux données d'instance
+static const GLuint INSTANCE_ATTRIB_BASE = 3;
+// mat4 (4 colonnes) + diffuse + specular + emissive + params
+static const GLuint INSTANCE_ATTRIB_COUNT = 8;
+
+InstancedRenderer::InstancedRenderer()
+    : m_InstanceVBO(0), m_InstanceCapacity(0) {
+}
+
+InstancedRenderer::~InstancedRenderer() {
+}
+
+bool InstancedRenderer::Initialize(const std::string& vertexPath, const std::string& fragmentPath) {
+    if (!m_Shader.LoadVertexShader(vertexPath.c_str()) ||
+        !m_Shader.LoadFragmentShader(fragmentPath.c_str()) ||
+        !m_Shader.Create()) {
+        std::cerr << "Failed to create instanced shader program" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(1, &m_InstanceVBO);
+    m_InstanceCapacity = 0;
+    return true;
+}
+
+void InstancedRenderer::Cleanup() {
+    if (m_InstanceVBO) {
+        GLStateCache::Get().DeleteBuffers(1, &m_InstanceVBO);
+        m_Shader.Destroy();
+    }
+    m_InstanceVBO = 0;
+    m_InstanceCapacity = 0;
+    m_Groups.clear();
+    m_Upload.clear();
+}
+
+void InstancedRenderer::Begin() {
+    // On garde les groupes (et leur capacité) d'une frame à l'autre
+    for (auto& entry : m_Groups) {
+        entry.second.instances.clear();
+    }
+}
+
+InstancedRenderer::Group& InstancedRenderer::GetGroup(const Mesh* mesh, GLuint texture) {
+    ArenaRange range = mesh->getArenaRange();
+    Group& group = m_Groups[GroupKey(range.firstIndex, texture)];
+    if (group.instances.empty()) {
+        group.range = range;
+        group.texture = texture;
+    }
+    return group;
+}
+
+void InstancedRenderer::FillMaterial(InstanceData& instance, const Material& material, bool hasTexture) {
+    memcpy(instance.diffuse, material.diffuse, 3 * sizeof(float));
+    instance.diffuse[3] = material.shininess;
+    memcpy(instance.specular, material.specular, 3 * sizeof(float));
+    instance.specular[3] = material.specularStrength;
+    memcpy(instance.emissive, material.lightColor, 3 * sizeof(float));
+    instance.emissive[3] = material.emissiveIntensity;
+    instance.params[0] = static_cast<float>(static_cast<int>(material.illuminationModel));
+    instance.params[1] = material.isEmissive ? 1.0f : 0.0f;
+    instance.params[2] = hasTexture ? 1.0f : 0.0f;
+    instance.params[3] = 0.0f;
+}
+
+bool InstancedRenderer::Submit(Mesh* mesh) {
+    if (!IsInitialized() || !mesh || !mesh->isSphere() || !mesh->getVAO()) {
+        return false;
+    }
+
+    // Même règle que Mesh::draw pour l'affichage de la texture
+    const Material& material = mesh->getMaterial();
+    bool hasTexture = material.diffuseMap.GetID() != 0 && mesh->isTextureEnabled();
+
+    Group& group = GetGroup(mesh, hasTexture ? material.diffuseMap.GetID() : 0);
+    group.instances.emplace_back();
+    InstanceData& instance = group.instances.back();
+    mesh->calculateModelMatrix(instance.model);
+    FillMaterial(instance, material, hasTexture);
+    return true;
+}
+
+void InstancedRenderer::SubmitInstances(const Mesh* mesh, const float* transforms, size_t count, const Material& material) {
+    if (!IsInitialized() || !mesh || !mesh->isSphere() || !mesh->getVAO() || count == 0) {
+        return;
+    }
+
+    bool hasTexture = material.diffuseMap.GetID() != 0;
+    Group& group = GetGroup(mesh, material.diffuseMap.GetID());
+
+    InstanceData shared;
+    FillMaterial(shared, material, hasTexture);
+
+    size_t first = group.instances.size();
+    group.instances.resize(first + count, shared);
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(group.instances[first + i].model, transforms + i * 16, 16 * sizeof(float));
+    }
+}
+
+void InstancedRenderer::SetInstancePointers(size_t offset) {
+    // Le buffer d'instances doit être lié sur GL_ARRAY_BUFFER
+    for (GLuint i = 0; i < INSTANCE_ATTRIB_COUNT; ++i) {
+        glVertexAttribPointer(INSTANCE_ATTRIB_BASE + i, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(offset + i * 4 * sizeof(float)));
+    }
+}
+
+void InstancedRenderer::Flush() {
+    if (!m_InstanceVBO) {
+        return;
+    }
+
+    // Toutes les instances de la frame sont envoyées en un seul transfert
+    m_Upload.clear();
+    for (auto& entry : m_Groups) {
+        m_Upload.insert(m_Upload.end(), entry.second.instances.begin(), entry.second.instances.end());
+    }
+    if (m_Upload.empty()) {
+        return;
+    }
+
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+    size_t bytes = m_Upload.size() * sizeof(InstanceData);
+    if (bytes > m_InstanceCapacity) {
+        m_InstanceCapacity = bytes * 2;
+    }
+    // Orphelinage du buffer pour ne pas attendre la frame précédente
+    glBufferData(GL_ARRAY_BUFFER, m_InstanceCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_Upload.data());
+
+    GLint loc_texture = m_Shader.GetLocation(Uniform::Texture);
+    if (loc_texture >= 0) glUniform1i(loc_texture, 0);
+
+    // Tous les groupes partagent le VAO de la GeometryArena
+    state.BindVertexArray(GeometryArena::Get().GetVertexArray());
+    for (GLuint i = 0; i < INSTANCE_ATTRIB_COUNT; ++i) {
+        glEnableVertexAttribArray(INSTANCE_ATTRIB_BASE + i);
+        glVertexAttribDivisor(INSTANCE_ATTRIB_BASE + i, 1);
+    }
+
+    // GL 4.2 : les attributs pointent une fois sur le début du buffer et chaque
+    // groupe démarre à sa première instance (baseInstance). En GL 3.3, ils sont
+    // redirigés sur la tranche de chaque groupe.
+    bool baseInstance = GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+    if (baseInstance) {
+        SetInstancePointers(0);
+    }
+
+    GLuint firstInstance = 0;
+    for (auto& entry : m_Groups) {
+        Group& group = entry.second;
+        if (group.instances.empty()) {
+            continue;
+        }
+
+        GLsizei instanceCount = static_cast<GLsizei>(group.instances.size());
+        void* indexOffset = (void*)(group.range.firstIndex * sizeof(unsigned int));
+        state.BindTexture(0, GL_TEXTURE_2D, group.texture);
+        if (baseInstance) {
+            glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, group.range.indexCount, GL_UNSIGNED_INT,
+                indexOffset, instanceCount, group.range.baseVertex, firstInstance);
+        } else {
+            SetInstancePointers(firstInstance * sizeof(InstanceData));
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, group.range.indexCount, GL_UNSIGNED_INT,
+                indexOffset, instanceCount, group.range.baseVertex);
+        }
+
+        RenderStats::Get().instancedDrawCalls++;
+        RenderStats::Get().instances += instanceCount;
+        RenderStats::Get().triangles += group.range.indexCount / 3 * instanceCount;
+        firstInstance += static_cast<GLuint>(instanceCount);
+    }
+
+    // Le VAO sert aussi au chemin non instancié
+    for (GLuint i = 0; i < INSTANCE_ATTRIB_COUNT; ++i) {
+        glVertexAttribDivisor(INSTANCE_ATTRIB_BASE + i, 0);
+        glDisableVertexAttribArray(INSTANCE_ATTRIB_BASE + i);
+    }
+}
@@ -0,0 +1,242 @@
+#include "../include/KTX2.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const unsigned char IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct Header {
+    unsigned char identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+static_assert(sizeof(Header) == 80, "KTX2 header must be 80 bytes");
+
+struct LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+// Constantes du Khronos Data Format (descripteur de base)
+const uint32_t KHR_DF_MODEL_BC1A = 128;
+const uint32_t KHR_DF_MODEL_BC3 = 130;
+const uint32_t KHR_DF_MODEL_BC7 = 134;
+const uint32_t KHR_DF_PRIMARIES_BT709 = 1;
+const uint32_t KHR_DF_TRANSFER_LINEAR = 1;
+const uint32_t KHR_DF_TRANSFER_SRGB = 2;
+const uint32_t KHR_DF_CHANNEL_BC1A_ALPHAPRESENT = 1;
+const uint32_t KHR_DF_CHANNEL_BC3_ALPHA = 15;
+
+void AppendWord(std::vector<uint32_t>& words, uint32_t value) {
+    words.push_back(value);
+}
+
+void AppendSample(std::vector<uint32_t>& words, uint32_t channel, uint32_t bitOffset, uint32_t bitLength) {
+    words.push_back(bitOffset | ((bitLength - 1) << 16) | (channel << 24));
+    words.push_back(0);            // samplePosition
+    words.push_back(0);            // sampleLower
+    words.push_back(0xFFFFFFFFu);  // sampleUpper
+}
+
+std::vector<uint32_t> BuildDataFormatDescriptor(uint32_t format) {
+    uint32_t model = KHR_DF_MODEL_BC1A;
+    if (format == KTX2::BC3_UNORM || format == KTX2::BC3_SRGB) model = KHR_DF_MODEL_BC3;
+    if (format == KTX2::BC7_UNORM || format == KTX2::BC7_SRGB) model = KHR_DF_MODEL_BC7;
+    uint32_t blockBytes = static_cast<uint32_t>(KTX2::GetBlockBytes(format));
+    uint32_t transfer = KTX2::IsSRGB(format) ? KHR_DF_TRANSFER_SRGB : KHR_DF_TRANSFER_LINEAR;
+    uint32_t sampleCount = (model == KHR_DF_MODEL_BC3) ? 2 : 1;
+
+    std::vector<uint32_t> words;
+    AppendWord(words, 0);  // taille totale, remplie à la fin
+    AppendWord(words, 0);  // vendorId = Khronos, descriptorType = basique
+    AppendWord(words, 2 | ((24 + 16 * sampleCount) << 16));  // version 2, taille du bloc
+    AppendWord(words, model | (KHR_DF_PRIMARIES_BT709 << 8) | (transfer << 16));
+    AppendWord(words, 3 | (3 << 8));  // blocs 4x4x1x1 (dimensions - 1)
+    AppendWord(words, blockBytes);    // bytesPlane0
+    AppendWord(words, 0);
+
+    if (model == KHR_DF_MODEL_BC3) {
+        AppendSample(words, KHR_DF_CHANNEL_BC3_ALPHA, 0, 64);
+        AppendSample(words, 0, 64, 64);
+    } else if (format == KTX2::BC1_RGBA_UNORM || format == KTX2::BC1_RGBA_SRGB) {
+        AppendSample(words, KHR_DF_CHANNEL_BC1A_ALPHAPRESENT, 0, 64);
+    } else {
+        AppendSample(words, 0, 0, blockBytes * 8);
+    }
+    words[0] = static_cast<uint32_t>(words.size() * sizeof(uint32_t));
+    return words;
+}
+
+bool ReadHeaderFrom(std::ifstream& file, Header& header) {
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (memcmp(header.identifier, IDENTIFIER, sizeof(IDENTIFIER)) != 0) return false;
+    return true;
+}
+
+}
+
+namespace KTX2 {
+
+uint32_t Image::GetLevelWidth(size_t level) const {
+    return std::max(1u, width >> level);
+}
+
+uint32_t Image::GetLevelHeight(size_t level) const {
+    return std::max(1u, height >> level);
+}
+
+size_t Image::GetByteSize() const {
+    size_t total = 0;
+    for (const auto& level : levels) total += level.size();
+    return total;
+}
+
+size_t GetBlockBytes(uint32_t format) {
+    switch (format) {
+        case BC1_RGB_UNORM: case BC1_RGB_SRGB:
+        case BC1_RGBA_UNORM: case BC1_RGBA_SRGB:
+            return 8;
+        case BC3_UNORM: case BC3_SRGB:
+        case BC7_UNORM: case BC7_SRGB:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+bool IsSRGB(uint32_t format) {
+    return format == BC1_RGB_SRGB || format == BC1_RGBA_SRGB || format == BC3_SRGB || format == BC7_SRGB;
+}
+
+size_t GetLevelByteSize(uint32_t format, uint32_t width, uint32_t height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockBytes(format);
+}
+
+bool ReadHeader(const std::string& path, Image& header) {
+    std::ifstream file(path, std::ios::binary);
+    Header raw;
+    if (!file || !ReadHeaderFrom(file, raw)) return false;
+    header.format = raw.vkFormat;
+    header.width = raw.pixelWidth;
+    header.height = raw.pixelHeight;
+    header.faceCount = raw.faceCount;
+    header.levels.clear();
+    header.levels.resize(std::max(1u, raw.levelCount));
+    return true;
+}
+
+bool Load(const std::string& path, Image& image, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    Header header;
+    if (!file || !ReadHeaderFrom(file, header)) {
+        error = "not a KTX2 file: " + path;
+        return false;
+    }
+    if (GetBlockBytes(header.vkFormat) == 0 || header.supercompressionScheme != 0 ||
+        header.pixelDepth > 1 || header.layerCount > 1 ||
+        (header.faceCount != 1 && header.faceCount != 6) || header.pixelWidth == 0 || header.pixelHeight == 0) {
+        error = "unsupported KTX2 layout: " + path;
+        return false;
+    }
+
+    uint32_t levelCount = std::max(1u, header.levelCount);
+    std::vector<LevelIndex> index(levelCount);
+    if (!file.read(reinterpret_cast<char*>(index.data()), index.size() * sizeof(LevelIndex))) {
+        error = "truncated KTX2 level index: " + path;
+        return false;
+    }
+
+    image.format = header.vkFormat;
+    image.width = header.pixelWidth;
+    image.height = header.pixelHeight;
+    image.faceCount = header.faceCount;
+    image.levels.assign(levelCount, {});
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        size_t expected = header.faceCount * GetLevelByteSize(header.vkFormat,
+            image.GetLevelWidth(level), image.GetLevelHeight(level));
+        if (index[level].byteLength != expected) {
+            error = "unexpected KTX2 level size: " + path;
+            return false;
+        }
+        image.levels[level].resize(expected);
+        file.seekg(static_cast<std::streamoff>(index[level].byteOffset));
+        if (!file.read(reinterpret_cast<char*>(image.levels[level].data()), expected)) {
+            error = "truncated KTX2 level data: " + path;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Save(const std::string& path, const Image& image, std::string& error) {
+    if (GetBlockBytes(image.format) == 0 || image.levels.empty()) {
+        error = "invalid KTX2 image";
+        return false;
+    }
+
+    const uint32_t levelCount = static_cast<uint32_t>(image.levels.size());
+    std::vector<uint32_t> dfd = BuildDataFormatDescriptor(image.format);
+
+    Header header = {};
+    memcpy(header.identifier, IDENTIFIER, sizeof(IDENTIFIER));
+    header.vkFormat = image.format;
+    header.typeSize = 1;
+    header.pixelWidth = image.width;
+    header.pixelHeight = image.height;
+    header.faceCount = image.faceCount;
+    header.levelCount = levelCount;
+    header.dfdByteOffset = static_cast<uint32_t>(sizeof(Header) + levelCount * sizeof(LevelIndex));
+    header.dfdByteLength = static_cast<uint32_t>(dfd.size() * sizeof(uint32_t));
+
+    // Les niveaux sont stockés du plus petit au plus grand, alignés sur 16 octets
+    std::vector<LevelIndex> index(levelCount);
+    uint64_t offset = header.dfdByteOffset + header.dfdByteLength;
+    for (uint32_t i = levelCount; i-- > 0;) {
+        offset = (offset + 15) & ~uint64_t(15);
+        index[i].byteOffset = offset;
+        index[i].byteLength = image.levels[i].size();
+        index[i].uncompressedByteLength = image.levels[i].size();
+        offset += image.levels[i].size();
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        error = "cannot write " + path;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(LevelIndex));
+    file.write(reinterpret_cast<const char*>(dfd.data()), dfd.size() * sizeof(uint32_t));
+
+    uint64_t position = header.dfdByteOffset + header.dfdByteLength;
+    const char padding[16] = {};
+    for (uint32_t i = levelCount; i-- > 0;) {
+        file.write(padding, static_cast<std::streamsize>(index[i].byteOffset - position));
+        file.write(reinterpret_cast<const char*>(image.levels[i].data()), image.levels[i].size());
+        position = index[i].byteOffset + index[i].byteLength;
+    }
+    if (!file) {
+        error = "write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+}
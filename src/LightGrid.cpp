@@ -0,0 +1,107 @@
+#include "../include/LightGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Atténuation des shaders : 1 / (1 + LINEAR * d + QUADRATIC * d²)
+    const float ATTENUATION_LINEAR = 0.045f;
+    const float ATTENUATION_QUADRATIC = 0.0075f;
+    // Contribution (avant correction gamma) sous laquelle une lumière est ignorée ;
+    // le fondu des shaders l'amène ensuite à 0 au rayon
+    const float LIGHT_CUTOFF = 1.0f / 256.0f;
+}
+
+float LightGrid::ComputeRadius(const float* color, float intensity) {
+    float brightness = intensity * std::max(color[0], std::max(color[1], color[2]));
+    // 1 + L d + Q d² = brightness / cutoff
+    float c = 1.0f - brightness / LIGHT_CUTOFF;
+    if (c >= 0.0f) {
+        return 0.0f;
+    }
+    float delta = ATTENUATION_LINEAR * ATTENUATION_LINEAR - 4.0f * ATTENUATION_QUADRATIC * c;
+    return (-ATTENUATION_LINEAR + std::sqrt(delta)) / (2.0f * ATTENUATION_QUADRATIC);
+}
+
+int LightGrid::DepthToSlice(float depth) const {
+    int slice = (int)std::floor(std::log(depth) * m_SliceScale + m_SliceBias);
+    return std::min(std::max(slice, 0), SLICES - 1);
+}
+
+void LightGrid::Build(const std::vector<PointLight>& lights, const Mat4& view, const Mat4& projection) {
+    // Plans near/far retrouvés depuis la perspective (colonne-major)
+    float p10 = projection[10];
+    float p14 = projection[14];
+    float nearPlane = p14 / (p10 - 1.0f);
+    float farPlane = p14 / (p10 + 1.0f);
+    m_SliceScale = SLICES / std::log(farPlane / nearPlane);
+    m_SliceBias = -std::log(nearPlane) * m_SliceScale;
+
+    // Passe 1 : clusters couverts par chaque lumière, comptés par cluster
+    m_Clusters.assign(CLUSTER_COUNT * 2, 0);
+    m_Ranges.resize(lights.size());
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const PointLight& light = lights[i];
+        Range& range = m_Ranges[i];
+        range.x0 = 1;
+        range.x1 = 0;   // vide par défaut
+
+        float center[3];
+        view.transformPoint(light.position, center);
+        float depth = -center[2];
+        float r = light.radius;
+        float dMin = std::max(depth - r, nearPlane);
+        float dMax = std::min(depth + r, farPlane);
+        if (r <= 0.0f || dMin > dMax) {
+            continue;
+        }
+
+        // Boîte de la sphère projetée : les extrêmes de x/d sont aux coins
+        float xMin = 1e30f, xMax = -1e30f, yMin = 1e30f, yMax = -1e30f;
+        const float depths[2] = { dMin, dMax };
+        for (float d : depths) {
+            for (float sign = -1.0f; sign <= 1.0f; sign += 2.0f) {
+                float x = projection[0] * (center[0] + sign * r) / d;
+                float y = projection[5] * (center[1] + sign * r) / d;
+                xMin = std::min(xMin, x); xMax = std::max(xMax, x);
+                yMin = std::min(yMin, y); yMax = std::max(yMax, y);
+            }
+        }
+        if (xMax < -1.0f || xMin > 1.0f || yMax < -1.0f || yMin > 1.0f) {
+            continue;   // hors de l'écran
+        }
+
+        range.x0 = std::max(0, (int)std::floor((xMin * 0.5f + 0.5f) * TILES_X));
+        range.x1 = std::min(TILES_X - 1, (int)std::floor((xMax * 0.5f + 0.5f) * TILES_X));
+        range.y0 = std::max(0, (int)std::floor((yMin * 0.5f + 0.5f) * TILES_Y));
+        range.y1 = std::min(TILES_Y - 1, (int)std::floor((yMax * 0.5f + 0.5f) * TILES_Y));
+        range.z0 = DepthToSlice(dMin);
+        range.z1 = DepthToSlice(dMax);
+
+        for (int z = range.z0; z <= range.z1; ++z)
+            for (int y = range.y0; y <= range.y1; ++y)
+                for (int x = range.x0; x <= range.x1; ++x)
+                    m_Clusters[((z * TILES_Y + y) * TILES_X + x) * 2 + 1]++;
+    }
+
+    // Débuts des listes (somme préfixe)
+    uint32_t total = 0;
+    m_MaxPerCluster = 0;
+    for (int c = 0; c < CLUSTER_COUNT; ++c) {
+        m_Clusters[c * 2] = total;
+        total += m_Clusters[c * 2 + 1];
+        m_MaxPerCluster = std::max(m_MaxPerCluster, m_Clusters[c * 2 + 1]);
+    }
+
+    // Passe 2 : remplissage des listes, lumières dans l'ordre d'entrée
+    m_Indices.resize(total);
+    m_Cursor.assign(CLUSTER_COUNT, 0);
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const Range& range = m_Ranges[i];
+        for (int z = range.z0; z <= range.z1 && range.x0 <= range.x1; ++z)
+            for (int y = range.y0; y <= range.y1; ++y)
+                for (int x = range.x0; x <= range.x1; ++x) {
+                    int c = (z * TILES_Y + y) * TILES_X + x;
+                    m_Indices[m_Clusters[c * 2] + m_Cursor[c]++] = (uint32_t)i;
+                }
+    }
+}
@@ -0,0 +1,123 @@
+#include "../include/LightManager.h"
+#include "../include/GLStateCache.h"
+#include "../include/GLShader.h"
+#include "../include/Mesh.h"
+#include "../include/RenderStats.h"
+#include <cstring>
+
+LightManager& LightManager::Get() {
+    static LightManager instance;
+    return instance;
+}
+
+void LightManager::Cleanup() {
+    Release(m_LightBuffer);
+    Release(m_ClusterBuffer);
+    Release(m_IndexBuffer);
+    m_Lights.clear();
+}
+
+void LightManager::BeginFrame() {
+    m_Lights.clear();
+}
+
+void LightManager::AddLight(const float* position, const float* color, float intensity) {
+    PointLight light;
+    memcpy(light.position, position, 3 * sizeof(float));
+    memcpy(light.color, color, 3 * sizeof(float));
+    light.intensity = intensity;
+    light.radius = LightGrid::ComputeRadius(color, intensity);
+    if (light.radius > 0.0f) {
+        m_Lights.push_back(light);
+    }
+}
+
+void LightManager::AddEmissiveMeshes(const std::vector<Mesh*>& meshes) {
+    for (const Mesh* mesh : meshes) {
+        const Material& material = mesh->getMaterial();
+        if (material.isEmissive) {
+            AddLight(mesh->getPosition(), material.lightColor, material.emissiveIntensity);
+        }
+    }
+}
+
+void LightManager::Build(const Mat4& view, const Mat4& projection) {
+    m_Grid.Build(m_Lights, view, projection);
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    m_TileSize[0] = (float)viewport[2] / LightGrid::TILES_X;
+    m_TileSize[1] = (float)viewport[3] / LightGrid::TILES_Y;
+
+    // Un buffer vide n'est pas un texture buffer valide : au moins un élément
+    static const PointLight noLight = {};
+    static const uint32_t noIndex = 0;
+    if (m_Lights.empty()) {
+        Upload(m_LightBuffer, LIGHTS_UNIT, GL_RGBA32F, &noLight, sizeof(noLight));
+    } else {
+        Upload(m_LightBuffer, LIGHTS_UNIT, GL_RGBA32F, m_Lights.data(), m_Lights.size() * sizeof(PointLight));
+    }
+    const std::vector<uint32_t>& clusters = m_Grid.GetClusters();
+    Upload(m_ClusterBuffer, CLUSTERS_UNIT, GL_RG32UI, clusters.data(), clusters.size() * sizeof(uint32_t));
+    const std::vector<uint32_t>& indices = m_Grid.GetIndices();
+    if (indices.empty()) {
+        Upload(m_IndexBuffer, INDICES_UNIT, GL_R32UI, &noIndex, sizeof(noIndex));
+    } else {
+        Upload(m_IndexBuffer, INDICES_UNIT, GL_R32UI, indices.data(), indices.size() * sizeof(uint32_t));
+    }
+
+    RenderStats& stats = RenderStats::Get();
+    stats.lights = (int)m_Lights.size();
+    stats.lightIndices = (int)indices.size();
+}
+
+void LightManager::Apply(const GLShader& shader) const {
+    GLint loc_lights = shader.GetLocation(Uniform::Lights);
+    if (loc_lights < 0) {
+        return;     // programme sans éclairage par clusters
+    }
+    glUniform1i(loc_lights, LIGHTS_UNIT);
+    GLint loc_clusters = shader.GetLocation(Uniform::ClusterLights);
+    if (loc_clusters >= 0) glUniform1i(loc_clusters, CLUSTERS_UNIT);
+    GLint loc_indices = shader.GetLocation(Uniform::LightIndices);
+    if (loc_indices >= 0) glUniform1i(loc_indices, INDICES_UNIT);
+
+    GLint loc_grid = shader.GetLocation(Uniform::ClusterGrid);
+    if (loc_grid >= 0) glUniform3i(loc_grid, LightGrid::TILES_X, LightGrid::TILES_Y, LightGrid::SLICES);
+    GLint loc_tile = shader.GetLocation(Uniform::ClusterTileSize);
+    if (loc_tile >= 0) glUniform2fv(loc_tile, 1, m_TileSize);
+    GLint loc_depth = shader.GetLocation(Uniform::ClusterDepth);
+    if (loc_depth >= 0) glUniform2f(loc_depth, m_Grid.GetSliceScale(), m_Grid.GetSliceBias());
+
+    // Déjà liés par Build() sur leurs unités : évités par le cache
+    GLStateCache& state = GLStateCache::Get();
+    state.BindTexture(LIGHTS_UNIT, GL_TEXTURE_BUFFER, m_LightBuffer.texture);
+    state.BindTexture(CLUSTERS_UNIT, GL_TEXTURE_BUFFER, m_ClusterBuffer.texture);
+    state.BindTexture(INDICES_UNIT, GL_TEXTURE_BUFFER, m_IndexBuffer.texture);
+}
+
+void LightManager::Upload(TextureBuffer& target, GLuint unit, GLenum format, const void* data, size_t bytes) {
+    if (!target.buffer) {
+        glGenBuffers(1, &target.buffer);
+        glGenTextures(1, &target.texture);
+    }
+
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+    if (bytes > target.capacity) {
+        target.capacity = bytes * 2;
+    }
+    // Orphelinage : la frame précédente peut encore lire l'ancien contenu
+    glBufferData(GL_TEXTURE_BUFFER, target.capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, data);
+
+    // Liée directement sur l'unité lue par les shaders
+    state.BindTexture(unit, GL_TEXTURE_BUFFER, target.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, target.buffer);
+}
+
+void LightManager::Release(TextureBuffer& target) {
+    if (target.texture) GLStateCache::Get().DeleteTextures(1, &target.texture);
+    if (target.buffer) GLStateCache::Get().DeleteBuffers(1, &target.buffer);
+    target = TextureBuffer();
+}
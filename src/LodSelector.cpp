@@ -0,0 +1,39 @@
+#include "../include/LodSelector.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+LodSelector& LodSelector::Get() {
+    static LodSelector instance;
+    return instance;
+}
+
+int LodSelector::Select(int currentLevel, int levelCount, float screenDiameter) const {
+    if (!enabled || levelCount <= 1) {
+        return 0;
+    }
+
+    int maxLevel = std::min(levelCount - 1, MAX_SWITCHES);
+    int level = std::min(std::max(currentLevel, 0), maxLevel);
+
+    // Vers le grossier : l'objet doit passer nettement sous le seuil
+    while (level < maxLevel && screenDiameter < switchDiameters[level] * (1.0f - hysteresis)) {
+        level++;
+    }
+    // Vers le détaillé : nettement au-dessus du seuil du niveau précédent
+    while (level > 0 && screenDiameter > switchDiameters[level - 1] * (1.0f + hysteresis)) {
+        level--;
+    }
+    return level;
+}
+
+float LodSelector::ScreenDiameter(const Bounds& bounds, const float* cameraPos, float pixelScale) {
+    float dx = bounds.center[0] - cameraPos[0];
+    float dy = bounds.center[1] - cameraPos[1];
+    float dz = bounds.center[2] - cameraPos[2];
+    float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (distance <= bounds.radius) {
+        return FLT_MAX;     // caméra dans la sphère : plein détail
+    }
+    return 2.0f * bounds.radius * pixelScale / distance;
+}
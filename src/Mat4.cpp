@@ -1,4 +1,17 @@
 #include "../include/Mat4.h"
+#include <algorithm>
+
+// Sélection du chemin SIMD à la compilation (MAT4_NO_SIMD force le scalaire)
+#if !defined(MAT4_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAT4_USE_SSE
+#include <emmintrin.h>
+#endif
+#if defined(MAT4_USE_SSE) && defined(__AVX__)
+#define MAT4_USE_AVX
+#include <immintrin.h>
+#endif
+#endif
 
 Mat4::Mat4() {
     std::fill(m_data.begin(), m_data.end(), 0.0f);
@@ -26,12 +39,54 @@ Mat4& Mat4::operator=(const Mat4& other) {
 }
 
 Mat4 Mat4::operator*(const Mat4& other) const {
+#if defined(MAT4_USE_AVX)
+    // Deux colonnes du résultat par itération : chaque voie de 128 bits
+    // reçoit une colonne de B diffusée composante par composante
+    Mat4 result;
+    const float* a = m_data.data();
+    const float* b = other.m_data.data();
+    __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 0));
+    __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+    __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+    __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+    for (int j = 0; j < 16; j += 8) {
+        __m256 bj = _mm256_loadu_ps(b + j);
+        __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(bj, bj, 0x00));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(bj, bj, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(bj, bj, 0xAA)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(bj, bj, 0xFF)));
+        _mm256_storeu_ps(result.m_data.data() + j, r);
+    }
+    return result;
+#elif defined(MAT4_USE_SSE)
+    // Colonne j du résultat = somme des colonnes de A pondérées par B[k + 4j]
+    Mat4 result;
+    const float* a = m_data.data();
+    const float* b = other.m_data.data();
+    __m128 a0 = _mm_load_ps(a + 0);
+    __m128 a1 = _mm_load_ps(a + 4);
+    __m128 a2 = _mm_load_ps(a + 8);
+    __m128 a3 = _mm_load_ps(a + 12);
+    for (int j = 0; j < 16; j += 4) {
+        __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[j + 0]));
+        r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[j + 1])));
+        r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[j + 2])));
+        r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[j + 3])));
+        _mm_store_ps(result.m_data.data() + j, r);
+    }
+    return result;
+#else
+    return multiplyScalar(*this, other);
+#endif
+}
+
+Mat4 Mat4::multiplyScalar(const Mat4& a, const Mat4& b) {
     Mat4 result;
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 4; j++) {
             float sum = 0.0f;
             for (int k = 0; k < 4; k++) {
-                sum += m_data[i + k * 4] * other.m_data[k + j * 4];
+                sum += a.m_data[i + k * 4] * b.m_data[k + j * 4];
             }
             result.m_data[i + j * 4] = sum;
         }
@@ -39,6 +94,175 @@ Mat4 Mat4::operator*(const Mat4& other) const {
     return result;
 }
 
+void Mat4::transformPoint(const float* in, float* out) const {
+#if defined(MAT4_USE_SSE)
+    const float* m = m_data.data();
+    __m128 r = _mm_mul_ps(_mm_load_ps(m + 0), _mm_set1_ps(in[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 4), _mm_set1_ps(in[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 8), _mm_set1_ps(in[2])));
+    r = _mm_add_ps(r, _mm_load_ps(m + 12));
+    alignas(16) float tmp[4];
+    _mm_store_ps(tmp, r);
+    out[0] = tmp[0];
+    out[1] = tmp[1];
+    out[2] = tmp[2];
+#else
+    transformPointScalar(*this, in, out);
+#endif
+}
+
+void Mat4::transformPointScalar(const Mat4& m, const float* in, float* out) {
+    for (int i = 0; i < 3; i++) {
+        out[i] = m.m_data[i] * in[0] + m.m_data[i + 4] * in[1] + m.m_data[i + 8] * in[2] + m.m_data[i + 12];
+    }
+}
+
+#if defined(MAT4_USE_SSE)
+// Helpers pour l'inverse par blocs 2x2 (chaque __m128 contient un bloc 2x2)
+#define MAT4_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+#define MAT4_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), MAT4_SHUFFLE_MASK(x, y, z, w))
+#define MAT4_SHUFFLE(v1, v2, x, y, z, w) _mm_shuffle_ps((v1), (v2), MAT4_SHUFFLE_MASK(x, y, z, w))
+
+// A * B
+static inline __m128 Mat2Mul(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, MAT4_SWIZZLE(b, 0, 3, 0, 3)),
+                      _mm_mul_ps(MAT4_SWIZZLE(a, 1, 0, 3, 2), MAT4_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// adj(A) * B
+static inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(MAT4_SWIZZLE(a, 3, 3, 0, 0), b),
+                      _mm_mul_ps(MAT4_SWIZZLE(a, 1, 1, 2, 2), MAT4_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+// A * adj(B)
+static inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, MAT4_SWIZZLE(b, 3, 0, 3, 0)),
+                      _mm_mul_ps(MAT4_SWIZZLE(a, 1, 0, 3, 2), MAT4_SWIZZLE(b, 2, 1, 2, 1)));
+}
+#endif
+
+Mat4 Mat4::inverse() const {
+#if defined(MAT4_USE_SSE)
+    // Méthode par blocs : la transposée étant inversée de la même façon,
+    // on peut traiter les colonnes comme des lignes sans réordonner
+    const float* m = m_data.data();
+    __m128 c0 = _mm_load_ps(m + 0);
+    __m128 c1 = _mm_load_ps(m + 4);
+    __m128 c2 = _mm_load_ps(m + 8);
+    __m128 c3 = _mm_load_ps(m + 12);
+
+    __m128 A = _mm_movelh_ps(c0, c1);
+    __m128 B = _mm_movehl_ps(c1, c0);
+    __m128 C = _mm_movelh_ps(c2, c3);
+    __m128 D = _mm_movehl_ps(c3, c2);
+
+    // Déterminants (|A| |B| |C| |D|)
+    __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(MAT4_SHUFFLE(c0, c2, 0, 2, 0, 2), MAT4_SHUFFLE(c1, c3, 1, 3, 1, 3)),
+        _mm_mul_ps(MAT4_SHUFFLE(c0, c2, 1, 3, 1, 3), MAT4_SHUFFLE(c1, c3, 0, 2, 0, 2)));
+    __m128 detA = MAT4_SWIZZLE(detSub, 0, 0, 0, 0);
+    __m128 detB = MAT4_SWIZZLE(detSub, 1, 1, 1, 1);
+    __m128 detC = MAT4_SWIZZLE(detSub, 2, 2, 2, 2);
+    __m128 detD = MAT4_SWIZZLE(detSub, 3, 3, 3, 3);
+
+    __m128 D_C = Mat2AdjMul(D, C);
+    __m128 A_B = Mat2AdjMul(A, B);
+    __m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+    __m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+    __m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+    __m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+    __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+    __m128 tr = _mm_mul_ps(A_B, MAT4_SWIZZLE(D_C, 0, 2, 1, 3));
+    tr = _mm_add_ps(tr, MAT4_SWIZZLE(tr, 2, 3, 0, 1));
+    tr = _mm_add_ps(tr, MAT4_SWIZZLE(tr, 1, 0, 3, 2));
+    detM = _mm_sub_ps(detM, tr);
+
+    if (_mm_cvtss_f32(detM) == 0.0f) {
+        return identity();
+    }
+
+    __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    X_ = _mm_mul_ps(X_, rDetM);
+    Y_ = _mm_mul_ps(Y_, rDetM);
+    Z_ = _mm_mul_ps(Z_, rDetM);
+    W_ = _mm_mul_ps(W_, rDetM);
+
+    Mat4 result;
+    float* r = result.m_data.data();
+    _mm_store_ps(r + 0, MAT4_SHUFFLE(X_, Y_, 3, 1, 3, 1));
+    _mm_store_ps(r + 4, MAT4_SHUFFLE(X_, Y_, 2, 0, 2, 0));
+    _mm_store_ps(r + 8, MAT4_SHUFFLE(Z_, W_, 3, 1, 3, 1));
+    _mm_store_ps(r + 12, MAT4_SHUFFLE(Z_, W_, 2, 0, 2, 0));
+    return result;
+#else
+    return inverseScalar(*this);
+#endif
+}
+
+Mat4 Mat4::inverseScalar(const Mat4& mat) {
+    // Développement par cofacteurs
+    const float* m = mat.m_data.data();
+    float inv[16];
+
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15]
+           + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15]
+           - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15]
+           + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14]
+            - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15]
+           - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15]
+           + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15]
+           - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14]
+            + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15]
+           + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15]
+           - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15]
+            + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14]
+            - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11]
+           - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11]
+           + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11]
+            - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10]
+            + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    if (det == 0.0f) {
+        return identity();
+    }
+
+    Mat4 result;
+    float invDet = 1.0f / det;
+    for (int i = 0; i < 16; i++) {
+        result.m_data[i] = inv[i] * invDet;
+    }
+    return result;
+}
+
+const char* Mat4::simdPath() {
+#if defined(MAT4_USE_AVX)
+    return "AVX";
+#elif defined(MAT4_USE_SSE)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
 bool Mat4::operator==(const Mat4& other) const {
     for (size_t i = 0; i < 16; ++i) {
         if (m_data[i] != other.m_data[i]) {
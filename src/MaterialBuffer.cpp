@@ -0,0 +1,107 @@
+#include "../include/MaterialBuffer.h"
+#include "../include/GLStateCache.h"
+#include "../include/Mesh.h"
+#include "../include/UBOManager.h"
+#include "../include/RenderStats.h"
+#include <algorithm>
+#include <cstring>
+
+MaterialBuffer& MaterialBuffer::Get() {
+    static MaterialBuffer instance;
+    return instance;
+}
+
+void MaterialBuffer::Cleanup() {
+    if (m_Buffer) {
+        GLStateCache::Get().DeleteBuffers(1, &m_Buffer);
+        m_Buffer = 0;
+    }
+    m_BufferSize = 0;
+    // Tout sera renvoyé si un nouveau contexte reprend les mêmes slots
+    m_DirtyBegin = 0;
+    m_DirtyEnd = m_SlotCount;
+}
+
+uint32_t MaterialBuffer::Allocate() {
+    uint32_t slot;
+    if (!m_FreeSlots.empty()) {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    } else {
+        slot = m_SlotCount++;
+        if (m_Materials.size() < m_SlotCount) {
+            m_Materials.resize(m_Materials.size() + MATERIALS_PER_PAGE);
+        }
+    }
+    Update(slot, Material());
+    return slot;
+}
+
+void MaterialBuffer::Free(uint32_t slot) {
+    if (slot < m_SlotCount) {
+        m_FreeSlots.push_back(slot);
+    }
+}
+
+void MaterialBuffer::Update(uint32_t slot, const Material& material) {
+    GPUMaterial& gpu = m_Materials[slot];
+    memcpy(gpu.diffuse, material.diffuse, 3 * sizeof(float));
+    gpu.diffuse[3] = material.shininess;
+    memcpy(gpu.specular, material.specular, 3 * sizeof(float));
+    gpu.specular[3] = material.specularStrength;
+    memcpy(gpu.emissive, material.lightColor, 3 * sizeof(float));
+    gpu.emissive[3] = material.emissiveIntensity;
+    gpu.params[0] = static_cast<int32_t>(material.illuminationModel);
+    gpu.params[1] = material.isEmissive ? 1 : 0;
+    gpu.params[2] = (material.useTextureInBasicShader ? TEXTURE_IN_BASIC : 0) |
+                    (material.useTextureInColorShader ? TEXTURE_IN_COLOR : 0) |
+                    (material.useTextureInEnvMapShader ? TEXTURE_IN_ENVMAP : 0);
+    gpu.params[3] = material.ignoreObjectMaterialInEnvMap ? 1 : 0;
+
+    m_DirtyBegin = std::min(m_DirtyBegin, slot);
+    m_DirtyEnd = std::max(m_DirtyEnd, slot + 1);
+}
+
+void MaterialBuffer::Flush() {
+    size_t required = m_Materials.size() * sizeof(GPUMaterial);
+    if (!m_Buffer) {
+        glGenBuffers(1, &m_Buffer);
+    }
+    GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_Buffer);
+    if (m_BufferSize < required) {
+        // Nouveau buffer (ou plus grand) : tout renvoyer
+        m_BufferSize = required;
+        glBufferData(GL_UNIFORM_BUFFER, m_BufferSize, m_Materials.data(), GL_DYNAMIC_DRAW);
+    } else if (m_DirtyEnd > m_DirtyBegin) {
+        glBufferSubData(GL_UNIFORM_BUFFER, m_DirtyBegin * sizeof(GPUMaterial),
+                        (m_DirtyEnd - m_DirtyBegin) * sizeof(GPUMaterial), &m_Materials[m_DirtyBegin]);
+    }
+    RenderStats::Get().materialUploads++;
+
+    m_DirtyBegin = UINT32_MAX;
+    m_DirtyEnd = 0;
+}
+
+void MaterialBuffer::BindStorage(GLuint binding) {
+    if (m_DirtyEnd > m_DirtyBegin || !m_Buffer) {
+        Flush();
+    }
+    GLStateCache::Get().BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_Buffer);
+}
+
+GLint MaterialBuffer::Bind(uint32_t slot) {
+    if (m_PerDrawUpload) {
+        // Chemin de comparaison : le matériau repart vers le GPU à chaque draw
+        m_DirtyBegin = std::min(m_DirtyBegin, slot);
+        m_DirtyEnd = std::max(m_DirtyEnd, slot + 1);
+    }
+    if (m_DirtyEnd > m_DirtyBegin || !m_Buffer) {
+        Flush();
+    }
+
+    // Même page que le draw précédent : liaison évitée par le cache
+    uint32_t page = slot / MATERIALS_PER_PAGE;
+    GLStateCache::Get().BindBufferRange(GL_UNIFORM_BUFFER, UBOManager::MATERIAL_BINDING, m_Buffer,
+                                        page * PAGE_SIZE, PAGE_SIZE);
+    return static_cast<GLint>(slot % MATERIALS_PER_PAGE);
+}
@@ -0,0 +1,257 @@
+#include "../include/MeshCacheFile.h"
+#include "../include/GeometryCache.h"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// ==================== MeshCacheFile ====================
+
+namespace {
+
+const char MAGIC[8] = { 'M', 'E', 'S', 'H', 'C', 'A', 'C', 'H' };
+
+// En-tête du fichier, suivi des Vertex, des indices, du chemin de texture puis
+// des niveaux de détail (LodHeader + Vertex + indices chacun)
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t vertexStride;        // sizeof(Vertex) à l'écriture
+    uint64_t sourceSize;
+    int64_t sourceTime;           // last_write_time de l'OBJ
+    uint64_t sourceHash;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t texturePathLength;
+    uint32_t hasMaterial;
+    float boundsMin[3];
+    float boundsMax[3];
+    float diffuse[3];
+    float specular[3];
+    float shininess;
+    uint32_t importFlags;         // MeshCacheFile::FLAG_*
+    float boundsRadius;
+    uint32_t lodCount;
+};
+
+struct LodHeader {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+};
+
+bool GetSourceInfo(const std::string& objPath, uint64_t& size, int64_t& time) {
+    std::error_code ec;
+    size = static_cast<uint64_t>(std::filesystem::file_size(objPath, ec));
+    if (ec) return false;
+    time = static_cast<int64_t>(std::filesystem::last_write_time(objPath, ec).time_since_epoch().count());
+    return !ec;
+}
+
+bool HashSource(const std::string& objPath, uint64_t& hash) {
+    MappedFile source;
+    if (!source.Open(objPath)) return false;
+    hash = MeshCacheFile::HashBytes(source.Data(), source.Size());
+    return true;
+}
+
+// Un index hors des sommets ferait lire TriangleBVH et le GPU hors du tableau
+bool IndicesInRange(const unsigned int* indices, size_t count, uint32_t vertexCount) {
+    for (size_t i = 0; i < count; ++i) {
+        if (indices[i] >= vertexCount) return false;
+    }
+    return true;
+}
+
+// OBJ touché mais identique : la nouvelle date évite de rehacher à chaque chargement
+void RefreshSourceTime(const std::string& cachePath, int64_t sourceTime) {
+    std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+    if (file) {
+        file.seekp(offsetof(CacheHeader, sourceTime));
+        file.write(reinterpret_cast<const char*>(&sourceTime), sizeof(sourceTime));
+    }
+}
+
+}
+
+namespace MeshCacheFile {
+
+std::string GetCachePath(const std::string& objPath) {
+    return objPath + ".meshcache";
+}
+
+uint64_t HashBytes(const unsigned char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool Load(const std::string& objPath, uint32_t importFlags, MeshGeometry& geometry) {
+    std::string cachePath = GetCachePath(objPath);
+    MappedFile file;
+    if (!file.Open(cachePath) || file.Size() < sizeof(CacheHeader)) {
+        return false;
+    }
+
+    CacheHeader header;
+    memcpy(&header, file.Data(), sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.vertexStride != sizeof(Vertex)) {
+        std::cout << "Mesh cache outdated (format): " << cachePath << std::endl;
+        return false;
+    }
+    if (header.importFlags != importFlags) {
+        return false;
+    }
+
+    size_t vertexBytes = (size_t)header.vertexCount * sizeof(Vertex);
+    size_t indexBytes = (size_t)header.indexCount * sizeof(unsigned int);
+    if (file.Size() < sizeof(CacheHeader) + vertexBytes + indexBytes + header.texturePathLength) {
+        std::cerr << "Mesh cache truncated: " << cachePath << std::endl;
+        return false;
+    }
+
+    // Même taille et même date : rien à vérifier. Sinon on compare le contenu.
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (!GetSourceInfo(objPath, sourceSize, sourceTime)) {
+        return false;
+    }
+    bool refreshTime = false;
+    if (sourceSize != header.sourceSize || sourceTime != header.sourceTime) {
+        uint64_t hash = 0;
+        if (sourceSize != header.sourceSize || !HashSource(objPath, hash) || hash != header.sourceHash) {
+            std::cout << "Mesh cache stale: " << cachePath << std::endl;
+            return false;
+        }
+        refreshTime = true;
+    }
+
+    const unsigned char* data = file.Data() + sizeof(CacheHeader);
+    const Vertex* vertices = reinterpret_cast<const Vertex*>(data);
+    const unsigned int* indices = reinterpret_cast<const unsigned int*>(data + vertexBytes);
+    const char* texturePath = reinterpret_cast<const char*>(data + vertexBytes + indexBytes);
+    if (!IndicesInRange(indices, header.indexCount, header.vertexCount)) {
+        std::cerr << "Mesh cache corrupt (index out of range): " << cachePath << std::endl;
+        return false;
+    }
+
+    // Copie CPU depuis la projection : TriangleBVH (picking) la garde, et l'envoi
+    // dans la GeometryArena se fait plus tard, sur le thread de rendu
+    geometry.vertices.assign(vertices, vertices + header.vertexCount);
+    geometry.indices.assign(indices, indices + header.indexCount);
+    memcpy(geometry.boundsMin, header.boundsMin, sizeof(header.boundsMin));
+    memcpy(geometry.boundsMax, header.boundsMax, sizeof(header.boundsMax));
+    geometry.boundsRadius = header.boundsRadius;
+
+    geometry.hasSourceMaterial = header.hasMaterial != 0;
+    memcpy(geometry.sourceMaterial.diffuse, header.diffuse, sizeof(header.diffuse));
+    memcpy(geometry.sourceMaterial.specular, header.specular, sizeof(header.specular));
+    geometry.sourceMaterial.shininess = header.shininess;
+    geometry.texturePath.assign(texturePath, header.texturePathLength);
+
+    geometry.lods.clear();
+    size_t offset = sizeof(CacheHeader) + vertexBytes + indexBytes + header.texturePathLength;
+    for (uint32_t level = 0; level < header.lodCount; ++level) {
+        LodHeader lodHeader;
+        if (file.Size() < offset + sizeof(LodHeader)) {
+            std::cerr << "Mesh cache truncated: " << cachePath << std::endl;
+            return false;
+        }
+        memcpy(&lodHeader, file.Data() + offset, sizeof(lodHeader));
+        offset += sizeof(LodHeader);
+        size_t lodVertexBytes = (size_t)lodHeader.vertexCount * sizeof(Vertex);
+        size_t lodIndexBytes = (size_t)lodHeader.indexCount * sizeof(unsigned int);
+        if (file.Size() < offset + lodVertexBytes + lodIndexBytes) {
+            std::cerr << "Mesh cache truncated: " << cachePath << std::endl;
+            return false;
+        }
+
+        auto lod = std::make_shared<MeshGeometry>();
+        const Vertex* lodVertices = reinterpret_cast<const Vertex*>(file.Data() + offset);
+        const unsigned int* lodIndices = reinterpret_cast<const unsigned int*>(file.Data() + offset + lodVertexBytes);
+        if (!IndicesInRange(lodIndices, lodHeader.indexCount, lodHeader.vertexCount)) {
+            std::cerr << "Mesh cache corrupt (index out of range): " << cachePath << std::endl;
+            return false;
+        }
+        lod->vertices.assign(lodVertices, lodVertices + lodHeader.vertexCount);
+        lod->indices.assign(lodIndices, lodIndices + lodHeader.indexCount);
+        lod->ComputeBounds();
+        geometry.lods.push_back(lod);
+        offset += lodVertexBytes + lodIndexBytes;
+    }
+
+    // La projection empêche l'écriture (Win32) : fermée avant de mettre l'en-tête à jour
+    if (refreshTime) {
+        file.Close();
+        RefreshSourceTime(cachePath, sourceTime);
+    }
+
+    std::cout << "Loaded mesh cache " << cachePath << " (" << header.vertexCount
+              << " vertices, " << header.indexCount / 3 << " triangles)" << std::endl;
+    return true;
+}
+
+bool Save(const std::string& objPath, uint32_t importFlags, const MeshGeometry& geometry) {
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.vertexStride = sizeof(Vertex);
+    if (!GetSourceInfo(objPath, header.sourceSize, header.sourceTime) ||
+        !HashSource(objPath, header.sourceHash)) {
+        return false;
+    }
+    header.vertexCount = static_cast<uint32_t>(geometry.vertices.size());
+    header.indexCount = static_cast<uint32_t>(geometry.indices.size());
+    header.texturePathLength = static_cast<uint32_t>(geometry.texturePath.size());
+    header.hasMaterial = geometry.hasSourceMaterial ? 1 : 0;
+    memcpy(header.boundsMin, geometry.boundsMin, sizeof(header.boundsMin));
+    memcpy(header.boundsMax, geometry.boundsMax, sizeof(header.boundsMax));
+    header.boundsRadius = geometry.boundsRadius;
+    memcpy(header.diffuse, geometry.sourceMaterial.diffuse, sizeof(header.diffuse));
+    memcpy(header.specular, geometry.sourceMaterial.specular, sizeof(header.specular));
+    header.shininess = geometry.sourceMaterial.shininess;
+    header.importFlags = importFlags;
+    header.lodCount = static_cast<uint32_t>(geometry.lods.size());
+
+    // Écriture dans un fichier temporaire puis renommage : jamais de cache à moitié écrit
+    std::string cachePath = GetCachePath(objPath);
+    std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Cannot write mesh cache: " << cachePath << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(geometry.vertices.data()), geometry.vertices.size() * sizeof(Vertex));
+        out.write(reinterpret_cast<const char*>(geometry.indices.data()), geometry.indices.size() * sizeof(unsigned int));
+        out.write(geometry.texturePath.data(), geometry.texturePath.size());
+        for (const auto& lod : geometry.lods) {
+            LodHeader lodHeader = { static_cast<uint32_t>(lod->vertices.size()), static_cast<uint32_t>(lod->indices.size()) };
+            out.write(reinterpret_cast<const char*>(&lodHeader), sizeof(lodHeader));
+            out.write(reinterpret_cast<const char*>(lod->vertices.data()), lod->vertices.size() * sizeof(Vertex));
+            out.write(reinterpret_cast<const char*>(lod->indices.data()), lod->indices.size() * sizeof(unsigned int));
+        }
+        if (!out) {
+            std::cerr << "Failed to write mesh cache: " << cachePath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    std::cout << "Wrote mesh cache " << cachePath << std::endl;
+    return true;
+}
+
+}
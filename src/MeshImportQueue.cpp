@@ -0,0 +1,72 @@
+#include "../include/MeshImportQueue.h"
+#include "../include/GeometryCache.h"
+#include <filesystem>
+#include <iostream>
+
+MeshImportQueue& MeshImportQueue::Get() {
+    static MeshImportQueue instance;
+    return instance;
+}
+
+void MeshImportQueue::Request(const std::string& filename, const ObjImportOptions& options, Callback callback) {
+    Job job;
+    job.filename = filename;
+    job.options = options;
+    job.callback = std::move(callback);
+    job.start = std::chrono::steady_clock::now();
+
+    std::error_code ec;
+    job.bytes = static_cast<size_t>(std::filesystem::file_size(filename, ec));
+    if (ec) job.bytes = 0;
+
+    // Thread coordinateur dédié (et non une tâche du pool) : il attend les
+    // blocs d'analyse soumis au pool sans jamais bloquer un de ses threads
+    job.result = std::async(std::launch::async, [filename, options]() {
+        return GeometryCache::LoadOBJGeometry(filename, options);
+    });
+
+    std::cout << "Queued OBJ import: " << filename << std::endl;
+    m_Jobs.push_back(std::move(job));
+}
+
+void MeshImportQueue::ProcessCompleted() {
+    for (auto it = m_Jobs.begin(); it != m_Jobs.end(); ++it) {
+        if (it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continue;
+        }
+
+        Job job = std::move(*it);
+        m_Jobs.erase(it);
+
+        std::shared_ptr<MeshGeometry> geometry = job.result.get();
+        if (geometry) {
+            // Seule étape sur le thread de rendu : création des buffers GL
+            geometry = GeometryCache::Get().AdoptOBJ(job.filename, job.options, geometry);
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - job.start).count();
+            double megabytes = job.bytes / (1024.0 * 1024.0);
+            m_LastThroughputMBs = seconds > 0.0 ? megabytes / seconds : 0.0;
+            m_LastImportName = std::filesystem::path(job.filename).filename().string();
+            std::cout << "Imported " << job.filename << " (" << megabytes << " MB) in "
+                      << seconds << " s: " << m_LastThroughputMBs << " MB/s" << std::endl;
+        } else {
+            std::cerr << "Async OBJ import failed: " << job.filename << std::endl;
+        }
+
+        if (job.callback) {
+            job.callback(geometry);
+        }
+
+        // Un seul envoi GPU par frame pour ne pas créer de pic
+        return;
+    }
+}
+
+void MeshImportQueue::Shutdown() {
+    for (Job& job : m_Jobs) {
+        if (job.result.valid()) {
+            job.result.wait();
+        }
+    }
+    m_Jobs.clear();
+}
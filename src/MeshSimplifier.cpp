@@ -0,0 +1,448 @@
+#include "../include/MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const int MAX_ITERATIONS = 100;
+// Les arêtes sont fusionnées quand leur erreur passe sous BASE * (iteration + 3)^AGGRESSIVENESS
+const double THRESHOLD_BASE = 1e-9;
+const double AGGRESSIVENESS = 7.0;
+// Une face dont la normale tourne au-delà (cosinus) bloque la fusion
+const double MIN_NORMAL_COSINE = 0.2;
+
+// Quadrique symétrique 4x4 : aa ab ac ad bb bc bd cc cd dd
+struct Quadric {
+    double m[10] = {};
+
+    static Quadric Plane(double a, double b, double c, double d, double weight) {
+        Quadric q;
+        q.m[0] = a * a; q.m[1] = a * b; q.m[2] = a * c; q.m[3] = a * d;
+        q.m[4] = b * b; q.m[5] = b * c; q.m[6] = b * d;
+        q.m[7] = c * c; q.m[8] = c * d;
+        q.m[9] = d * d;
+        for (double& v : q.m) v *= weight;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+        for (int i = 0; i < 10; ++i) m[i] += other.m[i];
+        return *this;
+    }
+
+    double Evaluate(const double* p) const {
+        double x = p[0], y = p[1], z = p[2];
+        return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x +
+               m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y +
+               m[7] * z * z + 2.0 * m[8] * z + m[9];
+    }
+
+    // Point qui minimise l'erreur (système 3x3 par Cramer), faux si singulier
+    bool Optimum(double* p) const {
+        double a = m[0], b = m[1], c = m[2], e = m[4], f = m[5], i = m[7];
+        double det = a * (e * i - f * f) - b * (b * i - f * c) + c * (b * f - e * c);
+        if (std::fabs(det) < 1e-15) {
+            return false;
+        }
+        double rx = -m[3], ry = -m[6], rz = -m[8];
+        p[0] = (rx * (e * i - f * f) - b * (ry * i - f * rz) + c * (ry * f - e * rz)) / det;
+        p[1] = (a * (ry * i - f * rz) - rx * (b * i - f * c) + c * (b * rz - ry * c)) / det;
+        p[2] = (a * (e * rz - ry * f) - b * (b * rz - ry * c) + rx * (b * f - e * c)) / det;
+        return true;
+    }
+};
+
+struct Triangle {
+    unsigned int v[3];
+    double error[4];    // par arête (v[j], v[j+1]), puis minimum
+    double normal[3];
+    bool deleted = false;
+    bool dirty = false;
+};
+
+struct SimplifyVertex {
+    double p[3];
+    Quadric q;
+    unsigned int refStart = 0;
+    unsigned int refCount = 0;
+    bool border = false;
+};
+
+// Triangle voisin d'un sommet, et place du sommet dans ce triangle
+struct Ref {
+    unsigned int triangle;
+    unsigned int corner;
+};
+
+void Normalize(double* v) {
+    double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length > 0.0) {
+        v[0] /= length; v[1] /= length; v[2] /= length;
+    }
+}
+
+void Cross(const double* a, const double* b, double* out) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+double Dot(const double* a, const double* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+class Simplifier {
+public:
+    Simplifier(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    void Run(size_t targetTriangles);
+    MeshSimplifier::Result Output() const;
+
+private:
+    double EdgeError(unsigned int a, unsigned int b, double* position) const;
+    void UpdateErrors(Triangle& t) const;
+    bool Flipped(const double* p, unsigned int self, unsigned int other, std::vector<char>& removed) const;
+    void Reattach(unsigned int target, unsigned int source, const std::vector<char>& removed, size_t& deletedCount);
+    void Compact();
+    void BuildRefs();
+
+    const std::vector<Vertex>& m_Source;
+    std::vector<SimplifyVertex> m_Vertices;
+    std::vector<Triangle> m_Triangles;
+    std::vector<Ref> m_Refs;
+    // Positions ramenées à une diagonale unité : les seuils ne dépendent pas de l'échelle
+    double m_Center[3] = {};
+    double m_Scale = 1.0;
+};
+
+Simplifier::Simplifier(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+    : m_Source(vertices) {
+    double boxMin[3] = { 1e300, 1e300, 1e300 }, boxMax[3] = { -1e300, -1e300, -1e300 };
+    for (const Vertex& v : vertices) {
+        for (int axis = 0; axis < 3; ++axis) {
+            boxMin[axis] = std::min(boxMin[axis], (double)v.position[axis]);
+            boxMax[axis] = std::max(boxMax[axis], (double)v.position[axis]);
+        }
+    }
+    double diagonal = 0.0;
+    for (int axis = 0; axis < 3; ++axis) {
+        m_Center[axis] = 0.5 * (boxMin[axis] + boxMax[axis]);
+        diagonal += (boxMax[axis] - boxMin[axis]) * (boxMax[axis] - boxMin[axis]);
+    }
+    m_Scale = diagonal > 0.0 ? std::sqrt(diagonal) : 1.0;
+
+    m_Vertices.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            m_Vertices[i].p[axis] = (vertices[i].position[axis] - m_Center[axis]) / m_Scale;
+        }
+    }
+
+    m_Triangles.reserve(indices.size() / 3);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        Triangle t;
+        t.v[0] = indices[i];
+        t.v[1] = indices[i + 1];
+        t.v[2] = indices[i + 2];
+        if (t.v[0] == t.v[1] || t.v[1] == t.v[2] || t.v[2] == t.v[0]) {
+            continue;   // pôles des sphères UV
+        }
+        m_Triangles.push_back(t);
+    }
+
+    // Quadrique de chaque face, pondérée par son aire, sur ses trois sommets
+    for (Triangle& t : m_Triangles) {
+        const double* p0 = m_Vertices[t.v[0]].p;
+        const double* p1 = m_Vertices[t.v[1]].p;
+        const double* p2 = m_Vertices[t.v[2]].p;
+        double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        Cross(e1, e2, t.normal);
+        double area = 0.5 * std::sqrt(Dot(t.normal, t.normal));
+        Normalize(t.normal);
+        Quadric q = Quadric::Plane(t.normal[0], t.normal[1], t.normal[2], -Dot(t.normal, p0), area);
+        for (unsigned int v : t.v) {
+            m_Vertices[v].q += q;
+        }
+    }
+
+    BuildRefs();
+
+    // Bord : arête portée par un seul triangle (voisin vu une seule fois autour du sommet)
+    std::vector<unsigned int> neighbors, counts;
+    for (size_t i = 0; i < m_Vertices.size(); ++i) {
+        SimplifyVertex& vertex = m_Vertices[i];
+        neighbors.clear();
+        counts.clear();
+        for (unsigned int r = 0; r < vertex.refCount; ++r) {
+            const Triangle& t = m_Triangles[m_Refs[vertex.refStart + r].triangle];
+            for (unsigned int v : t.v) {
+                if (v == i) continue;
+                auto it = std::find(neighbors.begin(), neighbors.end(), v);
+                if (it == neighbors.end()) {
+                    neighbors.push_back(v);
+                    counts.push_back(1);
+                } else {
+                    counts[it - neighbors.begin()]++;
+                }
+            }
+        }
+        for (size_t n = 0; n < neighbors.size(); ++n) {
+            if (counts[n] == 1) {
+                vertex.border = true;
+                m_Vertices[neighbors[n]].border = true;
+            }
+        }
+    }
+
+    for (Triangle& t : m_Triangles) {
+        UpdateErrors(t);
+    }
+}
+
+void Simplifier::BuildRefs() {
+    for (SimplifyVertex& v : m_Vertices) {
+        v.refCount = 0;
+    }
+    for (const Triangle& t : m_Triangles) {
+        for (unsigned int v : t.v) {
+            m_Vertices[v].refCount++;
+        }
+    }
+    unsigned int start = 0;
+    for (SimplifyVertex& v : m_Vertices) {
+        v.refStart = start;
+        start += v.refCount;
+        v.refCount = 0;
+    }
+    m_Refs.resize(start);
+    for (unsigned int i = 0; i < m_Triangles.size(); ++i) {
+        const Triangle& t = m_Triangles[i];
+        for (unsigned int corner = 0; corner < 3; ++corner) {
+            SimplifyVertex& v = m_Vertices[t.v[corner]];
+            m_Refs[v.refStart + v.refCount++] = { i, corner };
+        }
+    }
+}
+
+double Simplifier::EdgeError(unsigned int a, unsigned int b, double* position) const {
+    Quadric q = m_Vertices[a].q;
+    q += m_Vertices[b].q;
+
+    // Optimum du système, sinon le meilleur des extrémités et du milieu
+    const double* pa = m_Vertices[a].p;
+    const double* pb = m_Vertices[b].p;
+    double candidates[4][3];
+    int candidateCount = 0;
+    if (q.Optimum(candidates[0])) {
+        // Système mal conditionné (zone plane) : l'optimum peut glisser loin de l'arête
+        double edgeSq = 0.0, offsetSq = 0.0;
+        for (int axis = 0; axis < 3; ++axis) {
+            double edge = pb[axis] - pa[axis];
+            double offset = candidates[0][axis] - 0.5 * (pa[axis] + pb[axis]);
+            edgeSq += edge * edge;
+            offsetSq += offset * offset;
+        }
+        candidateCount = offsetSq <= edgeSq ? 1 : 0;
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        candidates[candidateCount][axis] = pa[axis];
+        candidates[candidateCount + 1][axis] = pb[axis];
+        candidates[candidateCount + 2][axis] = 0.5 * (pa[axis] + pb[axis]);
+    }
+    candidateCount += 3;
+
+    double best = 1e300;
+    for (int i = 0; i < candidateCount; ++i) {
+        double error = q.Evaluate(candidates[i]);
+        if (error < best) {
+            best = error;
+            memcpy(position, candidates[i], sizeof(double) * 3);
+        }
+    }
+    return std::max(best, 0.0);
+}
+
+void Simplifier::UpdateErrors(Triangle& t) const {
+    double position[3];
+    for (int j = 0; j < 3; ++j) {
+        t.error[j] = EdgeError(t.v[j], t.v[(j + 1) % 3], position);
+    }
+    t.error[3] = std::min(t.error[0], std::min(t.error[1], t.error[2]));
+}
+
+bool Simplifier::Flipped(const double* p, unsigned int self, unsigned int other, std::vector<char>& removed) const {
+    const SimplifyVertex& vertex = m_Vertices[self];
+    for (unsigned int r = 0; r < vertex.refCount; ++r) {
+        const Ref& ref = m_Refs[vertex.refStart + r];
+        const Triangle& t = m_Triangles[ref.triangle];
+        if (t.deleted) {
+            continue;
+        }
+        unsigned int id1 = t.v[(ref.corner + 1) % 3];
+        unsigned int id2 = t.v[(ref.corner + 2) % 3];
+        // Triangle portant l'arête fusionnée : il disparaît
+        if (id1 == other || id2 == other) {
+            removed[r] = 1;
+            continue;
+        }
+        removed[r] = 0;
+
+        double d1[3], d2[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            d1[axis] = m_Vertices[id1].p[axis] - p[axis];
+            d2[axis] = m_Vertices[id2].p[axis] - p[axis];
+        }
+        Normalize(d1);
+        Normalize(d2);
+        if (std::fabs(Dot(d1, d2)) > 0.999) {
+            return true;    // triangle dégénéré
+        }
+        double n[3];
+        Cross(d1, d2, n);
+        Normalize(n);
+        if (Dot(n, t.normal) < MIN_NORMAL_COSINE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Simplifier::Reattach(unsigned int target, unsigned int source, const std::vector<char>& removed,
+                          size_t& deletedCount) {
+    const SimplifyVertex& vertex = m_Vertices[source];
+    for (unsigned int r = 0; r < vertex.refCount; ++r) {
+        Ref ref = m_Refs[vertex.refStart + r];
+        Triangle& t = m_Triangles[ref.triangle];
+        if (t.deleted) {
+            continue;
+        }
+        if (removed[r]) {
+            t.deleted = true;
+            deletedCount++;
+            continue;
+        }
+        t.v[ref.corner] = target;
+        t.dirty = true;
+        UpdateErrors(t);
+        m_Refs.push_back(ref);
+    }
+}
+
+void Simplifier::Compact() {
+    size_t kept = 0;
+    for (size_t i = 0; i < m_Triangles.size(); ++i) {
+        if (!m_Triangles[i].deleted) {
+            m_Triangles[kept++] = m_Triangles[i];
+        }
+    }
+    m_Triangles.resize(kept);
+    BuildRefs();
+}
+
+void Simplifier::Run(size_t targetTriangles) {
+    size_t deletedCount = 0;
+    size_t triangleCount = m_Triangles.size();
+    std::vector<char> removed0, removed1;
+
+    for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+        if (triangleCount - deletedCount <= targetTriangles) {
+            break;
+        }
+        // Les listes de voisins grossissent à chaque fusion : on les reconstruit régulièrement
+        if (iteration > 0 && iteration % 5 == 0) {
+            Compact();
+            triangleCount = m_Triangles.size();
+            deletedCount = 0;
+        }
+        for (Triangle& t : m_Triangles) {
+            t.dirty = false;
+        }
+
+        double threshold = THRESHOLD_BASE * std::pow(iteration + 3.0, AGGRESSIVENESS);
+        for (size_t i = 0; i < m_Triangles.size(); ++i) {
+            if (triangleCount - deletedCount <= targetTriangles) {
+                break;
+            }
+            // Référence stable : seule m_Refs grandit pendant une passe
+            Triangle& t = m_Triangles[i];
+            if (t.deleted || t.dirty || t.error[3] > threshold) {
+                continue;
+            }
+            for (int j = 0; j < 3; ++j) {
+                if (t.error[j] > threshold) {
+                    continue;
+                }
+                unsigned int i0 = t.v[j];
+                unsigned int i1 = t.v[(j + 1) % 3];
+                SimplifyVertex& v0 = m_Vertices[i0];
+                SimplifyVertex& v1 = m_Vertices[i1];
+                if (v0.border || v1.border) {
+                    continue;
+                }
+
+                double p[3];
+                EdgeError(i0, i1, p);
+                removed0.assign(v0.refCount, 0);
+                removed1.assign(v1.refCount, 0);
+                if (Flipped(p, i0, i1, removed0) || Flipped(p, i1, i0, removed1)) {
+                    continue;
+                }
+
+                // i1 disparaît dans i0, qui garde ses attributs (normale, uv)
+                memcpy(v0.p, p, sizeof(p));
+                v0.q += v1.q;
+                unsigned int refStart = static_cast<unsigned int>(m_Refs.size());
+                Reattach(i0, i0, removed0, deletedCount);
+                Reattach(i0, i1, removed1, deletedCount);
+                unsigned int refCount = static_cast<unsigned int>(m_Refs.size()) - refStart;
+                SimplifyVertex& merged = m_Vertices[i0];
+                if (refCount <= merged.refCount) {
+                    // La nouvelle liste tient dans l'ancienne place
+                    if (refCount) {
+                        memcpy(&m_Refs[merged.refStart], &m_Refs[refStart], refCount * sizeof(Ref));
+                    }
+                    m_Refs.resize(refStart);
+                } else {
+                    merged.refStart = refStart;
+                }
+                merged.refCount = refCount;
+                break;
+            }
+        }
+    }
+    Compact();
+}
+
+MeshSimplifier::Result Simplifier::Output() const {
+    MeshSimplifier::Result result;
+    std::vector<unsigned int> remap(m_Vertices.size(), ~0u);
+    result.indices.reserve(m_Triangles.size() * 3);
+    for (const Triangle& t : m_Triangles) {
+        for (unsigned int v : t.v) {
+            if (remap[v] == ~0u) {
+                remap[v] = static_cast<unsigned int>(result.vertices.size());
+                Vertex out = m_Source[v];
+                for (int axis = 0; axis < 3; ++axis) {
+                    out.position[axis] = static_cast<float>(m_Vertices[v].p[axis] * m_Scale + m_Center[axis]);
+                }
+                result.vertices.push_back(out);
+            }
+            result.indices.push_back(remap[v]);
+        }
+    }
+    return result;
+}
+
+}
+
+namespace MeshSimplifier {
+
+Result Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                size_t targetTriangles) {
+    Simplifier simplifier(vertices, indices);
+    simplifier.Run(targetTriangles);
+    return simplifier.Output();
+}
+
+}
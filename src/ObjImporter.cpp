@@ -0,0 +1,588 @@
+#include "../include/ObjImporter.h"
+#include "../include/MappedFile.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <map>
+
+namespace {
+
+const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+inline uint64_t MixHash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Clé historique : triplet d'indices OBJ
+struct IndexKey {
+    int vertex, normal, texcoord;
+
+    bool operator==(const IndexKey& other) const {
+        return vertex == other.vertex && normal == other.normal && texcoord == other.texcoord;
+    }
+    uint64_t Hash() const {
+        uint64_t h = MixHash((uint64_t)(uint32_t)vertex | ((uint64_t)(uint32_t)normal << 32));
+        return MixHash(h ^ (uint32_t)texcoord);
+    }
+};
+
+// Clé par valeur : motif binaire des 8 flottants (-0.0 ramené à 0.0)
+struct ValueKey {
+    uint32_t bits[8];
+
+    explicit ValueKey(const Vertex& vertex) {
+        memcpy(bits, &vertex, sizeof(bits));
+        for (uint32_t& b : bits) {
+            if (b == 0x80000000u) b = 0;
+        }
+    }
+    bool operator==(const ValueKey& other) const {
+        return memcmp(bits, other.bits, sizeof(bits)) == 0;
+    }
+    uint64_t Hash() const {
+        uint64_t h = 0;
+        for (int i = 0; i < 8; i += 2) {
+            h = MixHash(h ^ (bits[i] | ((uint64_t)bits[i + 1] << 32)));
+        }
+        return h;
+    }
+};
+
+// Table à adressage ouvert (sondage linéaire) qui ne stocke que l'index du sommet ;
+// la clé d'un index déjà inséré est reconstruite par KeyOf lors des comparaisons
+template <typename Key, typename KeyOf>
+class FlatWeldTable {
+public:
+    FlatWeldTable(size_t expected, KeyOf keyOf) : m_KeyOf(keyOf) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity <<= 1;
+        m_Slots.assign(capacity, EMPTY_SLOT);
+        m_Mask = capacity - 1;
+    }
+
+    // Retourne l'index déjà associé à la clé, ou insère newIndex et renvoie EMPTY_SLOT
+    uint32_t FindOrInsert(const Key& key, uint32_t newIndex) {
+        if ((m_Count + 1) * 10 > m_Slots.size() * 7) {
+            Grow();
+        }
+
+        size_t slot = key.Hash() & m_Mask;
+        while (m_Slots[slot] != EMPTY_SLOT) {
+            if (m_KeyOf(m_Slots[slot]) == key) {
+                return m_Slots[slot];
+            }
+            slot = (slot + 1) & m_Mask;
+        }
+        m_Slots[slot] = newIndex;
+        m_Count++;
+        return EMPTY_SLOT;
+    }
+
+private:
+    void Grow() {
+        std::vector<uint32_t> old;
+        old.swap(m_Slots);
+        m_Slots.assign(old.size() * 2, EMPTY_SLOT);
+        m_Mask = m_Slots.size() - 1;
+        for (uint32_t index : old) {
+            if (index == EMPTY_SLOT) continue;
+            size_t slot = m_KeyOf(index).Hash() & m_Mask;
+            while (m_Slots[slot] != EMPTY_SLOT) {
+                slot = (slot + 1) & m_Mask;
+            }
+            m_Slots[slot] = index;
+        }
+    }
+
+    std::vector<uint32_t> m_Slots;
+    size_t m_Mask = 0;
+    size_t m_Count = 0;
+    KeyOf m_KeyOf;
+};
+
+template <typename Key, typename KeyOf>
+FlatWeldTable<Key, KeyOf> MakeWeldTable(size_t expected, KeyOf keyOf) {
+    return FlatWeldTable<Key, KeyOf>(expected, keyOf);
+}
+
+
+// ==================== Lecture parallèle ====================
+
+// Résultat de l'analyse d'un bloc de lignes. Les indices positifs sont déjà
+// globaux (base 0) ; les indices négatifs sont relatifs au début du bloc et
+// listés dans les fixups pour être décalés une fois les bases connues.
+struct ObjChunk {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texcoords;
+    std::vector<tinyobj::index_t> indices;
+    std::vector<size_t> positionFixups;
+    std::vector<size_t> normalFixups;
+    std::vector<size_t> texcoordFixups;
+    std::vector<size_t> quadStarts;  // quads émis en [0,1,2][0,2,3], diagonale choisie à la fusion
+    std::vector<std::string> mtllibs;
+    bool ok = true;
+    std::string error;
+};
+
+const size_t CHUNK_TARGET_BYTES = 1 << 20;
+
+inline bool IsSpace(char c) { return c == ' ' || c == '\t'; }
+inline bool IsEndOfLine(char c) { return c == '\n' || c == '\r'; }
+
+inline void SkipSpaces(const char*& p, const char* end) {
+    while (p < end && IsSpace(*p)) ++p;
+}
+
+// strtod est lent et dépend de la locale : conversion maison, suffisante pour
+// les flottants décimaux des OBJ (signe, partie fractionnaire, exposant)
+bool ParseFloat(const char*& p, const char* end, float& value) {
+    static const double POW10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+    SkipSpaces(p, end);
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits < 18) { mantissa = mantissa * 10 + (*p - '0'); ++digits; }
+        else { ++exponent; }
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digits < 18) { mantissa = mantissa * 10 + (*p - '0'); ++digits; --exponent; }
+            ++p;
+        }
+    }
+    if (p == start || (p == start + 1 && (*start == '-' || *start == '+'))) {
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExp = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExp = (*p == '-');
+            ++p;
+        }
+        int e = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (e < 1000) e = e * 10 + (*p - '0');
+            ++p;
+        }
+        exponent += negativeExp ? -e : e;
+    }
+
+    double result = static_cast<double>(mantissa);
+    while (exponent > 0) {
+        int step = std::min(exponent, 18);
+        result *= POW10[step];
+        exponent -= step;
+    }
+    while (exponent < 0) {
+        int step = std::min(-exponent, 18);
+        result /= POW10[step];
+        exponent += step;
+    }
+    value = static_cast<float>(negative ? -result : result);
+    return true;
+}
+
+inline bool ParseInt(const char*& p, const char* end, int& value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (p >= end || *p < '0' || *p > '9') return false;
+    int result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p - '0');
+        ++p;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+// Convertit un indice OBJ (base 1, ou négatif = relatif à la fin) en indice
+// base 0. Un indice négatif reste local au bloc et est signalé via isLocal.
+inline int ResolveIndex(int raw, size_t localCount, bool& isLocal) {
+    isLocal = raw < 0;
+    return raw > 0 ? raw - 1 : static_cast<int>(localCount) + raw;
+}
+
+bool ParseFaceVertex(const char*& p, const char* end, ObjChunk& chunk,
+                     tinyobj::index_t& idx, bool local[3]) {
+    int raw = 0;
+    idx.vertex_index = idx.normal_index = idx.texcoord_index = -1;
+    local[0] = local[1] = local[2] = false;
+
+    if (!ParseInt(p, end, raw) || raw == 0) return false;
+    idx.vertex_index = ResolveIndex(raw, chunk.positions.size() / 3, local[0]);
+
+    if (p < end && *p == '/') {
+        ++p;
+        if (p < end && *p != '/') {
+            if (!ParseInt(p, end, raw) || raw == 0) return false;
+            idx.texcoord_index = ResolveIndex(raw, chunk.texcoords.size() / 2, local[1]);
+        }
+        if (p < end && *p == '/') {
+            ++p;
+            if (!ParseInt(p, end, raw) || raw == 0) return false;
+            idx.normal_index = ResolveIndex(raw, chunk.normals.size() / 3, local[2]);
+        }
+    }
+    return true;
+}
+
+void PushFaceVertex(ObjChunk& chunk, const tinyobj::index_t& idx, const bool local[3]) {
+    size_t slot = chunk.indices.size();
+    if (local[0]) chunk.positionFixups.push_back(slot);
+    if (local[1]) chunk.texcoordFixups.push_back(slot);
+    if (local[2]) chunk.normalFixups.push_back(slot);
+    chunk.indices.push_back(idx);
+}
+
+void ParseChunk(const char* begin, const char* end, ObjChunk& chunk) {
+    // Estimation grossière : ~30 octets par ligne
+    size_t expectedLines = static_cast<size_t>(end - begin) / 30 + 1;
+    chunk.positions.reserve(expectedLines * 3 / 2);
+    chunk.indices.reserve(expectedLines * 3);
+
+    std::vector<tinyobj::index_t> face;
+    std::vector<uint8_t> faceLocal;
+    const char* p = begin;
+
+    while (p < end) {
+        SkipSpaces(p, end);
+        const char* lineStart = p;
+        const char* lineEnd = p;
+        while (lineEnd < end && !IsEndOfLine(*lineEnd)) ++lineEnd;
+
+        if (p + 1 < lineEnd && p[0] == 'v' && IsSpace(p[1])) {
+            p += 2;
+            float xyz[3];
+            if (!ParseFloat(p, lineEnd, xyz[0]) || !ParseFloat(p, lineEnd, xyz[1]) || !ParseFloat(p, lineEnd, xyz[2])) {
+                chunk.ok = false;
+                chunk.error = "invalid vertex: " + std::string(lineStart, lineEnd);
+                return;
+            }
+            chunk.positions.insert(chunk.positions.end(), xyz, xyz + 3);
+        } else if (p + 2 < lineEnd && p[0] == 'v' && p[1] == 'n' && IsSpace(p[2])) {
+            p += 3;
+            float xyz[3];
+            if (!ParseFloat(p, lineEnd, xyz[0]) || !ParseFloat(p, lineEnd, xyz[1]) || !ParseFloat(p, lineEnd, xyz[2])) {
+                chunk.ok = false;
+                chunk.error = "invalid normal: " + std::string(lineStart, lineEnd);
+                return;
+            }
+            chunk.normals.insert(chunk.normals.end(), xyz, xyz + 3);
+        } else if (p + 2 < lineEnd && p[0] == 'v' && p[1] == 't' && IsSpace(p[2])) {
+            p += 3;
+            float uv[2] = { 0.0f, 0.0f };
+            if (!ParseFloat(p, lineEnd, uv[0])) {
+                chunk.ok = false;
+                chunk.error = "invalid texcoord: " + std::string(lineStart, lineEnd);
+                return;
+            }
+            ParseFloat(p, lineEnd, uv[1]);  // v optionnel
+            chunk.texcoords.insert(chunk.texcoords.end(), uv, uv + 2);
+        } else if (p + 1 < lineEnd && p[0] == 'f' && IsSpace(p[1])) {
+            p += 2;
+            face.clear();
+            faceLocal.clear();
+            for (;;) {
+                SkipSpaces(p, lineEnd);
+                if (p >= lineEnd || *p == '#') break;
+                tinyobj::index_t idx;
+                bool local[3];
+                if (!ParseFaceVertex(p, lineEnd, chunk, idx, local)) {
+                    chunk.ok = false;
+                    chunk.error = "invalid face: " + std::string(lineStart, lineEnd);
+                    return;
+                }
+                face.push_back(idx);
+                faceLocal.push_back(static_cast<uint8_t>(local[0] | (local[1] << 1) | (local[2] << 2)));
+            }
+            // Triangulation en éventail (polygones convexes). Pour un quad, tinyobj
+            // coupe selon la diagonale la plus courte : les positions pouvant être
+            // dans un autre bloc, ce choix est fait après la fusion
+            if (face.size() == 4) {
+                chunk.quadStarts.push_back(chunk.indices.size());
+            }
+            for (size_t i = 2; i < face.size(); ++i) {
+                const size_t corners[3] = { 0, i - 1, i };
+                for (size_t corner : corners) {
+                    bool local[3] = { (faceLocal[corner] & 1) != 0, (faceLocal[corner] & 2) != 0, (faceLocal[corner] & 4) != 0 };
+                    PushFaceVertex(chunk, face[corner], local);
+                }
+            }
+        } else if (static_cast<size_t>(lineEnd - p) > 7 && strncmp(p, "mtllib", 6) == 0 && IsSpace(p[6])) {
+            p += 7;
+            while (p < lineEnd) {
+                SkipSpaces(p, lineEnd);
+                const char* nameStart = p;
+                while (p < lineEnd && !IsSpace(*p)) ++p;
+                if (p > nameStart) chunk.mtllibs.emplace_back(nameStart, p);
+            }
+        }
+        // Le reste (o, g, s, usemtl, commentaires...) n'influence pas la géométrie fusionnée
+
+        p = lineEnd;
+        while (p < end && IsEndOfLine(*p)) ++p;
+    }
+}
+
+}
+
+namespace ObjImporter {
+
+Vertex MakeVertex(const tinyobj::attrib_t& attrib, const tinyobj::index_t& idx) {
+    Vertex vertex;
+
+    // Position
+    if (idx.vertex_index >= 0 && idx.vertex_index < static_cast<int>(attrib.vertices.size() / 3)) {
+        vertex.position[0] = attrib.vertices[3 * idx.vertex_index + 0];
+        vertex.position[1] = attrib.vertices[3 * idx.vertex_index + 1];
+        vertex.position[2] = attrib.vertices[3 * idx.vertex_index + 2];
+    } else {
+        vertex.position[0] = vertex.position[1] = vertex.position[2] = 0.0f;
+    }
+
+    // Normal
+    if (idx.normal_index >= 0 && idx.normal_index < static_cast<int>(attrib.normals.size() / 3)) {
+        vertex.normal[0] = attrib.normals[3 * idx.normal_index + 0];
+        vertex.normal[1] = attrib.normals[3 * idx.normal_index + 1];
+        vertex.normal[2] = attrib.normals[3 * idx.normal_index + 2];
+    } else {
+        // Si pas de normale, on la calculera plus tard ou on met une valeur par défaut
+        vertex.normal[0] = 0.0f;
+        vertex.normal[1] = 0.0f;
+        vertex.normal[2] = 1.0f;  // Normal pointant vers Z+
+    }
+
+    // Texture coordinates
+    if (idx.texcoord_index >= 0 && idx.texcoord_index < static_cast<int>(attrib.texcoords.size() / 2)) {
+        vertex.uv[0] = attrib.texcoords[2 * idx.texcoord_index + 0];
+        // INVERSION DE LA COORDONNÉE V POUR CORRIGER L'ORIENTATION
+        vertex.uv[1] = 1.0f - attrib.texcoords[2 * idx.texcoord_index + 1];
+    } else {
+        vertex.uv[0] = vertex.uv[1] = 0.0f;
+    }
+
+    return vertex;
+}
+
+void BuildIndexedMesh(const tinyobj::attrib_t& attrib,
+                      const std::vector<tinyobj::shape_t>& shapes,
+                      const ObjImportOptions& options,
+                      std::vector<Vertex>& vertices,
+                      std::vector<unsigned int>& indices) {
+    vertices.clear();
+    indices.clear();
+
+    // Dimensionnement depuis les compteurs tinyobj : pas de réallocation en général
+    size_t totalIndices = 0;
+    for (const auto& shape : shapes) {
+        totalIndices += shape.mesh.indices.size();
+    }
+    size_t expected = std::max(attrib.vertices.size() / 3,
+                      std::max(attrib.normals.size() / 3, attrib.texcoords.size() / 2));
+    expected = std::min(std::max(expected, (size_t)1), std::max(totalIndices, (size_t)1));
+    vertices.reserve(expected);
+    indices.reserve(totalIndices);
+
+    if (options.weldByValue) {
+        auto keyOf = [&vertices](uint32_t index) { return ValueKey(vertices[index]); };
+        auto table = MakeWeldTable<ValueKey>(expected, keyOf);
+
+        for (const auto& shape : shapes) {
+            for (const tinyobj::index_t& idx : shape.mesh.indices) {
+                Vertex vertex = MakeVertex(attrib, idx);
+                uint32_t next = static_cast<uint32_t>(vertices.size());
+                uint32_t found = table.FindOrInsert(ValueKey(vertex), next);
+                if (found == EMPTY_SLOT) {
+                    vertices.push_back(vertex);
+                    indices.push_back(next);
+                } else {
+                    indices.push_back(found);
+                }
+            }
+        }
+    } else {
+        // Triplet d'indices de chaque sommet émis, pour reconstruire les clés
+        std::vector<IndexKey> keys;
+        keys.reserve(expected);
+        auto keyOf = [&keys](uint32_t index) { return keys[index]; };
+        auto table = MakeWeldTable<IndexKey>(expected, keyOf);
+
+        for (const auto& shape : shapes) {
+            for (const tinyobj::index_t& idx : shape.mesh.indices) {
+                IndexKey key = { idx.vertex_index, idx.normal_index, idx.texcoord_index };
+                uint32_t next = static_cast<uint32_t>(vertices.size());
+                uint32_t found = table.FindOrInsert(key, next);
+                if (found == EMPTY_SLOT) {
+                    keys.push_back(key);
+                    vertices.push_back(MakeVertex(attrib, idx));
+                    indices.push_back(next);
+                } else {
+                    indices.push_back(found);
+                }
+            }
+        }
+    }
+}
+
+bool ParseParallel(const std::string& filename, ThreadPool& pool,
+                   ObjParseResult& result, std::string& error) {
+    MappedFile file;
+    if (!file.Open(filename)) {
+        error = "cannot map " + filename;
+        return false;
+    }
+    const char* data = reinterpret_cast<const char*>(file.Data());
+    const size_t size = file.Size();
+    result.bytes = size;
+
+    // Découpage en blocs sur des fins de ligne ; plusieurs blocs par thread
+    // pour équilibrer la charge entre lignes de sommets et lignes de faces
+    size_t chunkCount = std::max<size_t>(1, std::min(size / CHUNK_TARGET_BYTES + 1, pool.GetThreadCount() * 4));
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t start = 0;
+    for (size_t i = 0; i < chunkCount && start < size; ++i) {
+        size_t stop = (i + 1 == chunkCount) ? size : std::max(start, size * (i + 1) / chunkCount);
+        while (stop < size && data[stop] != '\n') ++stop;
+        if (stop < size) ++stop;
+        ranges.emplace_back(start, stop);
+        start = stop;
+    }
+
+    std::vector<ObjChunk> chunks(ranges.size());
+    std::vector<std::future<void>> pending;
+    pending.reserve(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        ObjChunk* chunk = &chunks[i];
+        const char* begin = data + ranges[i].first;
+        const char* end = data + ranges[i].second;
+        pending.push_back(pool.Submit([begin, end, chunk]() { ParseChunk(begin, end, *chunk); }));
+    }
+    for (auto& task : pending) task.get();
+    pending.clear();
+
+    for (const ObjChunk& chunk : chunks) {
+        if (!chunk.ok) {
+            error = chunk.error;
+            return false;
+        }
+    }
+
+    // Bases globales de chaque bloc (sommes préfixes)
+    std::vector<size_t> positionBase(chunks.size()), normalBase(chunks.size());
+    std::vector<size_t> texcoordBase(chunks.size()), indexBase(chunks.size());
+    size_t positionCount = 0, normalCount = 0, texcoordCount = 0, indexCount = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        positionBase[i] = positionCount;  positionCount += chunks[i].positions.size();
+        normalBase[i] = normalCount;      normalCount += chunks[i].normals.size();
+        texcoordBase[i] = texcoordCount;  texcoordCount += chunks[i].texcoords.size();
+        indexBase[i] = indexCount;        indexCount += chunks[i].indices.size();
+    }
+    if (indexCount == 0) {
+        error = "no faces in " + filename;
+        return false;
+    }
+
+    result.attrib.vertices.resize(positionCount);
+    result.attrib.normals.resize(normalCount);
+    result.attrib.texcoords.resize(texcoordCount);
+    result.shapes.assign(1, tinyobj::shape_t());
+    result.shapes[0].name = std::filesystem::path(filename).stem().string();
+    std::vector<tinyobj::index_t>& indices = result.shapes[0].mesh.indices;
+    indices.resize(indexCount);
+
+    // Recopie parallèle à la place définitive, avec correction des indices relatifs
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        pending.push_back(pool.Submit([&, i]() {
+            ObjChunk& chunk = chunks[i];
+            std::copy(chunk.positions.begin(), chunk.positions.end(), result.attrib.vertices.begin() + positionBase[i]);
+            std::copy(chunk.normals.begin(), chunk.normals.end(), result.attrib.normals.begin() + normalBase[i]);
+            std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), result.attrib.texcoords.begin() + texcoordBase[i]);
+
+            const int positionOffset = static_cast<int>(positionBase[i] / 3);
+            const int normalOffset = static_cast<int>(normalBase[i] / 3);
+            const int texcoordOffset = static_cast<int>(texcoordBase[i] / 2);
+            for (size_t slot : chunk.positionFixups) chunk.indices[slot].vertex_index += positionOffset;
+            for (size_t slot : chunk.normalFixups) chunk.indices[slot].normal_index += normalOffset;
+            for (size_t slot : chunk.texcoordFixups) chunk.indices[slot].texcoord_index += texcoordOffset;
+            std::copy(chunk.indices.begin(), chunk.indices.end(), indices.begin() + indexBase[i]);
+
+            // Libère la mémoire du bloc au plus tôt
+            std::vector<float>().swap(chunk.positions);
+            std::vector<float>().swap(chunk.normals);
+            std::vector<float>().swap(chunk.texcoords);
+            std::vector<tinyobj::index_t>().swap(chunk.indices);
+        }));
+    }
+    for (auto& task : pending) task.get();
+    pending.clear();
+
+    // Quads : [0,1,2][0,2,3] devient [0,1,3][1,2,3] si la diagonale 1-3 est plus courte
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (chunks[i].quadStarts.empty()) continue;
+        pending.push_back(pool.Submit([&, i]() {
+            const std::vector<float>& positions = result.attrib.vertices;
+            const int positionTotal = static_cast<int>(positions.size() / 3);
+            auto distance2 = [&](int a, int b) {
+                float dx = positions[3 * b + 0] - positions[3 * a + 0];
+                float dy = positions[3 * b + 1] - positions[3 * a + 1];
+                float dz = positions[3 * b + 2] - positions[3 * a + 2];
+                return dx * dx + dy * dy + dz * dz;
+            };
+            for (size_t quadStart : chunks[i].quadStarts) {
+                tinyobj::index_t* tri = &indices[indexBase[i] + quadStart];
+                const tinyobj::index_t corner[4] = { tri[0], tri[1], tri[2], tri[5] };
+                bool valid = true;
+                for (const tinyobj::index_t& c : corner) {
+                    valid = valid && c.vertex_index >= 0 && c.vertex_index < positionTotal;
+                }
+                if (!valid || distance2(corner[0].vertex_index, corner[2].vertex_index) <
+                              distance2(corner[1].vertex_index, corner[3].vertex_index)) {
+                    continue;
+                }
+                tri[0] = corner[0]; tri[1] = corner[1]; tri[2] = corner[3];
+                tri[3] = corner[1]; tri[4] = corner[2]; tri[5] = corner[3];
+            }
+        }));
+    }
+    for (auto& task : pending) task.get();
+
+    // Matériaux : tous les mtllib référencés, relatifs au dossier de l'OBJ
+    std::filesystem::path baseDir = std::filesystem::path(filename).parent_path();
+    std::map<std::string, int> materialMap;
+    for (const ObjChunk& chunk : chunks) {
+        for (const std::string& mtllib : chunk.mtllibs) {
+            std::ifstream mtlFile(baseDir / mtllib);
+            if (!mtlFile) continue;
+            std::string warn, err;
+            tinyobj::LoadMtl(&materialMap, &result.materials, &mtlFile, &warn, &err);
+        }
+    }
+    return true;
+}
+
+}
@@ -9,6 +9,8 @@ Planet::Planet()
     , m_Size(1.0f)
     , m_SelfRotation(0.0f)
     , m_CurrentAngle(0.0f)
+    , m_System(nullptr)
+    , m_SystemIndex(0)
 {
     CreateMesh();
 }
@@ -28,6 +30,8 @@ Planet::Planet(Planet&& other) noexcept
     , m_Size(other.m_Size)
     , m_SelfRotation(other.m_SelfRotation)
     , m_CurrentAngle(other.m_CurrentAngle)
+    , m_System(other.m_System)
+    , m_SystemIndex(other.m_SystemIndex)
 {
     other.m_Mesh = nullptr;
     other.m_Texture = 0;
@@ -44,6 +48,8 @@ Planet& Planet::operator=(Planet&& other) noexcept {
         m_Size = other.m_Size;
         m_SelfRotation = other.m_SelfRotation;
         m_CurrentAngle = other.m_CurrentAngle;
+        m_System = other.m_System;
+        m_SystemIndex = other.m_SystemIndex;
 
         other.m_Mesh = nullptr;
         other.m_Texture = 0;
@@ -69,6 +75,11 @@ void Planet::Initialize(float orbitRadius, float rotationSpeed, float size) {
 }
 
 void Planet::Update(float deltaTime) {
+    // Rattachée à un système, l'orbite est avancée par PlanetSystem::Update
+    if (m_System) {
+        SyncFromSystem();
+        return;
+    }
     m_CurrentAngle += m_RotationSpeed * deltaTime;
     m_SelfRotation += deltaTime * 0.5f;
     UpdateTransform();
@@ -82,6 +93,25 @@ void Planet::SetSize(float size) {
     UpdateTransform();
 }
 
+void Planet::SetRotationSpeed(float speed) {
+    m_RotationSpeed = speed;
+    if (m_System) {
+        m_System->SetAngularSpeed(m_SystemIndex, speed);
+    }
+}
+
+void Planet::AttachToSystem(PlanetSystem* system, size_t index) {
+    m_System = system;
+    m_SystemIndex = index;
+    UpdateTransform();
+}
+
+void Planet::SyncFromSystem() {
+    if (m_System && m_Mesh) {
+        m_Mesh->setTransform(Mat4(m_System->GetTransform(m_SystemIndex)));
+    }
+}
+
 void Planet::SetMaterial(const Material& material) {
     if (m_Mesh) {
         m_Mesh->setMaterial(material);
@@ -90,13 +120,19 @@ void Planet::SetMaterial(const Material& material) {
 
 bool Planet::LoadTexture(const char* texturePath) {
     if (m_Mesh && m_Mesh->loadTexture(texturePath)) {
-        m_Texture = m_Mesh->getMaterial().diffuseMap;
+        m_Texture = m_Mesh->getMaterial().diffuseMap.GetID();
         return true;
     }
     return false;
 }
 
 void Planet::UpdateTransform() {
+    if (m_System) {
+        m_System->SetBodyParameters(m_SystemIndex, m_OrbitRadius, m_RotationSpeed, m_Size);
+        SyncFromSystem();
+        return;
+    }
+
     float x = cos(m_CurrentAngle) * m_OrbitRadius;
     float z = sin(m_CurrentAngle) * m_OrbitRadius;
     
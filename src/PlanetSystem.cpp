@@ -0,0 +1,232 @@
+#include "../include/PlanetSystem.h"
+#include <cmath>
+
+#if !defined(MAT4_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PLANETSYSTEM_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const float TWO_PI = 6.28318530717958647692f;
+const float INV_TWO_PI = 0.15915494309189533577f;
+const float TWO_OVER_PI = 0.63661977236758134308f;
+
+// Réduction de Cody-Waite en trois termes pour pi/2
+const float PIO2_HI = 1.5703125f;
+const float PIO2_MID = 4.837512969970703125e-4f;
+const float PIO2_LO = 7.54978995489188216e-8f;
+
+// Polynômes minimax sur [-pi/4, pi/4] (cephes sinf/cosf)
+const float SIN_C1 = -1.6666654611e-1f;
+const float SIN_C2 = 8.3321608736e-3f;
+const float SIN_C3 = -1.9515295891e-4f;
+const float COS_C1 = 4.166664568298827e-2f;
+const float COS_C2 = -1.388731625493765e-3f;
+const float COS_C3 = 2.443315711809948e-5f;
+
+// Ramène un angle dans [-pi, pi] pour garder la réduction précise
+inline float WrapAngle(float a) {
+    return a - TWO_PI * (float)std::lrint(a * INV_TWO_PI);
+}
+
+// Même algorithme que SinCos4, pour que les deux chemins donnent
+// exactement les mêmes matrices
+inline void SinCos(float x, float& s, float& c) {
+    int j = (int)std::lrint(x * TWO_OVER_PI);
+    float jf = (float)j;
+    float r = x - jf * PIO2_HI;
+    r = r - jf * PIO2_MID;
+    r = r - jf * PIO2_LO;
+    float r2 = r * r;
+    float ps = r + r * r2 * (SIN_C1 + r2 * (SIN_C2 + r2 * SIN_C3));
+    float pc = 1.0f - 0.5f * r2 + r2 * r2 * (COS_C1 + r2 * (COS_C2 + r2 * COS_C3));
+    s = (j & 1) ? pc : ps;
+    c = (j & 1) ? ps : pc;
+    if (j & 2) s = -s;
+    if ((j + 1) & 2) c = -c;
+}
+
+inline void WriteBody(float* m, float orbitRadius, float angle, float selfRotation, float size) {
+    float so, co, sr, cr;
+    SinCos(angle, so, co);
+    SinCos(selfRotation, sr, cr);
+
+    // translate(x, 0, z) * rotate(selfRotation, Y) * scale(size)
+    m[0] = cr * size;  m[1] = 0.0f; m[2] = -sr * size; m[3] = 0.0f;
+    m[4] = 0.0f;       m[5] = size; m[6] = 0.0f;       m[7] = 0.0f;
+    m[8] = sr * size;  m[9] = 0.0f; m[10] = cr * size; m[11] = 0.0f;
+    m[12] = co * orbitRadius; m[13] = 0.0f; m[14] = so * orbitRadius; m[15] = 1.0f;
+}
+
+#if defined(PLANETSYSTEM_USE_SSE)
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 WrapAngle4(__m128 a) {
+    __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(a, _mm_set1_ps(INV_TWO_PI))));
+    return _mm_sub_ps(a, _mm_mul_ps(turns, _mm_set1_ps(TWO_PI)));
+}
+
+inline void SinCos4(__m128 x, __m128& s, __m128& c) {
+    __m128i j = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI)));
+    __m128 jf = _mm_cvtepi32_ps(j);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(jf, _mm_set1_ps(PIO2_HI)));
+    r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(PIO2_MID)));
+    r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(PIO2_LO)));
+    __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 ps = _mm_add_ps(_mm_set1_ps(SIN_C2), _mm_mul_ps(r2, _mm_set1_ps(SIN_C3)));
+    ps = _mm_add_ps(_mm_set1_ps(SIN_C1), _mm_mul_ps(r2, ps));
+    ps = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), ps));
+
+    __m128 pc = _mm_add_ps(_mm_set1_ps(COS_C2), _mm_mul_ps(r2, _mm_set1_ps(COS_C3)));
+    pc = _mm_add_ps(_mm_set1_ps(COS_C1), _mm_mul_ps(r2, pc));
+    pc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)),
+                    _mm_mul_ps(_mm_mul_ps(r2, r2), pc));
+
+    // Quadrant : échange sin/cos si j impair, puis signes
+    __m128i one = _mm_set1_epi32(1);
+    __m128i two = _mm_set1_epi32(2);
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+    __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, two), 30));
+    __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30));
+    s = _mm_xor_ps(Select(swap, pc, ps), sinSign);
+    c = _mm_xor_ps(Select(swap, ps, pc), cosSign);
+}
+#endif
+
+} // namespace
+
+size_t PlanetSystem::AddBody(float orbitRadius, float angularSpeed, float size) {
+    m_OrbitRadius.push_back(orbitRadius);
+    m_AngularSpeed.push_back(angularSpeed);
+    m_Angle.push_back(0.0f);
+    m_SelfRotation.push_back(0.0f);
+    m_Size.push_back(size);
+    m_Transforms.resize(m_Transforms.size() + 16);
+
+    size_t index = m_OrbitRadius.size() - 1;
+    WriteTransforms(index, index + 1);
+    return index;
+}
+
+void PlanetSystem::Reserve(size_t count) {
+    m_OrbitRadius.reserve(count);
+    m_AngularSpeed.reserve(count);
+    m_Angle.reserve(count);
+    m_SelfRotation.reserve(count);
+    m_Size.reserve(count);
+    m_Transforms.reserve(count * 16);
+}
+
+void PlanetSystem::Clear() {
+    m_OrbitRadius.clear();
+    m_AngularSpeed.clear();
+    m_Angle.clear();
+    m_SelfRotation.clear();
+    m_Size.clear();
+    m_Transforms.clear();
+}
+
+void PlanetSystem::SetBodyParameters(size_t index, float orbitRadius, float angularSpeed, float size) {
+    m_OrbitRadius[index] = orbitRadius;
+    m_AngularSpeed[index] = angularSpeed;
+    m_Size[index] = size;
+    WriteTransforms(index, index + 1);
+}
+
+void PlanetSystem::SetOrbitRadius(size_t index, float radius) {
+    m_OrbitRadius[index] = radius;
+    WriteTransforms(index, index + 1);
+}
+
+void PlanetSystem::SetSize(size_t index, float size) {
+    m_Size[index] = size;
+    WriteTransforms(index, index + 1);
+}
+
+void PlanetSystem::SetAngle(size_t index, float angle) {
+    m_Angle[index] = WrapAngle(angle);
+    WriteTransforms(index, index + 1);
+}
+
+void PlanetSystem::Update(float deltaTime) {
+    const size_t count = GetCount();
+    float* radius = m_OrbitRadius.data();
+    float* speed = m_AngularSpeed.data();
+    float* angle = m_Angle.data();
+    float* self = m_SelfRotation.data();
+    float* size = m_Size.data();
+    float* out = m_Transforms.data();
+    const float selfStep = deltaTime * SELF_ROTATION_SPEED;
+
+    size_t i = 0;
+#if defined(PLANETSYSTEM_USE_SSE)
+    // 4 corps par itération : avance des angles, sin/cos, puis transposition
+    // des colonnes SoA vers une matrice par corps
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 selfDt = _mm_set1_ps(selfStep);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 a = WrapAngle4(_mm_add_ps(_mm_loadu_ps(angle + i), _mm_mul_ps(_mm_loadu_ps(speed + i), dt)));
+        __m128 r = WrapAngle4(_mm_add_ps(_mm_loadu_ps(self + i), selfDt));
+        _mm_storeu_ps(angle + i, a);
+        _mm_storeu_ps(self + i, r);
+
+        __m128 so, co, sr, cr;
+        SinCos4(a, so, co);
+        SinCos4(r, sr, cr);
+
+        __m128 sz = _mm_loadu_ps(size + i);
+        __m128 rad = _mm_loadu_ps(radius + i);
+        __m128 cs = _mm_mul_ps(cr, sz);
+        __m128 ss = _mm_mul_ps(sr, sz);
+        __m128 x = _mm_mul_ps(co, rad);
+        __m128 z = _mm_mul_ps(so, rad);
+        __m128 negSs = _mm_sub_ps(zero, ss);
+
+        float* m = out + i * 16;
+        __m128 c0 = cs, c1 = zero, c2 = negSs, c3 = zero;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_storeu_ps(m + 0, c0);
+        _mm_storeu_ps(m + 16, c1);
+        _mm_storeu_ps(m + 32, c2);
+        _mm_storeu_ps(m + 48, c3);
+
+        c0 = zero; c1 = sz; c2 = zero; c3 = zero;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_storeu_ps(m + 4, c0);
+        _mm_storeu_ps(m + 20, c1);
+        _mm_storeu_ps(m + 36, c2);
+        _mm_storeu_ps(m + 52, c3);
+
+        c0 = ss; c1 = zero; c2 = cs; c3 = zero;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_storeu_ps(m + 8, c0);
+        _mm_storeu_ps(m + 24, c1);
+        _mm_storeu_ps(m + 40, c2);
+        _mm_storeu_ps(m + 56, c3);
+
+        c0 = x; c1 = zero; c2 = z; c3 = one;
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_storeu_ps(m + 12, c0);
+        _mm_storeu_ps(m + 28, c1);
+        _mm_storeu_ps(m + 44, c2);
+        _mm_storeu_ps(m + 60, c3);
+    }
+#endif
+    for (; i < count; i++) {
+        angle[i] = WrapAngle(angle[i] + speed[i] * deltaTime);
+        self[i] = WrapAngle(self[i] + selfStep);
+        WriteBody(out + i * 16, radius[i], angle[i], self[i], size[i]);
+    }
+}
+
+void PlanetSystem::WriteTransforms(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        WriteBody(&m_Transforms[i * 16], m_OrbitRadius[i], m_Angle[i], m_SelfRotation[i], m_Size[i]);
+    }
+}
@@ -0,0 +1,589 @@
+#include "../include/ProgramRegistry.h"
+#include "../include/GLStateCache.h"
+#include "../include/UBOManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+namespace {
+    const char BINARY_MAGIC[8] = { 'G', 'L', 'P', 'R', 'O', 'G', 'B', 'N' };
+    const uint32_t BINARY_VERSION = 1;
+
+    // En-tête d'un fichier du cache binaire
+    struct BinaryHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t binaryFormat;
+        uint64_t sourceHash;
+        uint64_t driverHash;
+        uint32_t length;
+        uint32_t reserved;
+    };
+
+    uint64_t HashAppend(uint64_t hash, const std::string& text) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        // Séparateur : "ab"+"c" et "a"+"bc" ne donnent pas le même hash
+        hash ^= 0xff;
+        hash *= 1099511628211ull;
+        return hash;
+    }
+
+    const uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+    std::string GetGLString(GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+}
+
+// Vérifie le status de compilation ; supprime le shader s'il est inutilisable
+static bool ValidateShader(GLuint shader)
+{
+    GLint compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+
+    if (!compiled)
+    {
+        GLint infoLen = 0;
+
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLen);
+
+        if (infoLen > 1)
+        {
+            char* infoLog = new char[1 + infoLen];
+
+            glGetShaderInfoLog(shader, infoLen, NULL, infoLog);
+            std::cout << "Error compiling shader:" << infoLog << std::endl;
+
+            delete[] infoLog;
+        }
+
+        glDeleteShader(shader);
+
+        return false;
+    }
+
+    return true;
+}
+
+// Soumet la compilation sans interroger GL_COMPILE_STATUS (qui attendrait le résultat)
+static GLuint SubmitStage(GLenum type, const std::string& source)
+{
+    GLuint shader = glCreateShader(type);
+    const char* text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+ProgramRegistry& ProgramRegistry::Get() {
+    static ProgramRegistry instance;
+    return instance;
+}
+
+ProgramRegistry::ProgramRegistry() : m_Epoch(std::chrono::steady_clock::now()) {
+    // Chemin absolu figé au premier usage : les scènes changent de répertoire courant
+    std::error_code ec;
+    m_CacheDirectory = std::filesystem::absolute("shadercache", ec).string();
+}
+
+double ProgramRegistry::Now() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Epoch).count();
+}
+
+uint64_t ProgramRegistry::HashSources(const ProgramSources& sources) {
+    uint64_t hash = FNV_OFFSET;
+    for (const std::string& code : sources.code) {
+        hash = HashAppend(hash, code);
+    }
+    return hash != 0 ? hash : 1;    // 0 est réservé à "pas de programme"
+}
+
+// "basic.vs + basic.fs"
+static std::string MakeLabel(const ProgramSources& sources)
+{
+    std::string label;
+    for (const std::string& path : sources.paths) {
+        if (path.empty()) continue;
+        if (!label.empty()) label += " + ";
+        label += std::filesystem::path(path).filename().string();
+    }
+    return label;
+}
+
+uint64_t ProgramRegistry::Resolve(uint64_t key) const {
+    if (m_Programs.count(key)) {
+        return key;
+    }
+    auto alias = m_Aliases.find(key);
+    return alias != m_Aliases.end() ? alias->second : key;
+}
+
+void ProgramRegistry::UpdateAlias(uint64_t key, uint64_t previousHash, uint64_t currentHash) {
+    auto alias = m_Aliases.find(previousHash);
+    if (alias != m_Aliases.end() && alias->second == key) {
+        m_Aliases.erase(alias);
+    }
+    if (currentHash != key) {
+        m_Aliases[currentHash] = key;
+    }
+}
+
+void ProgramRegistry::Acquire(uint64_t key, const ProgramSources& sources) {
+    // Sources déjà rechargées dans une entrée existante : partagée, pas de doublon
+    auto it = m_Programs.find(Resolve(key));
+    if (it != m_Programs.end()) {
+        it->second.refCount++;
+        m_Stats.shared++;
+        return;
+    }
+
+    Program& program = m_Programs[key];
+    program.refCount = 1;
+    program.sources = sources;
+    program.label = MakeLabel(sources);
+    program.submitTime = Now();
+    m_PathsRevision++;
+
+    // Un binaire valide évite toute compilation ; il est chargé tout de suite
+    // car glProgramBinary ne fait qu'une copie côté driver
+    GLuint id = LoadBinary(key);
+    if (id) {
+        BindUniformBlocks(id);
+        GLShader::ReflectUniforms(id, program.reflection);
+        program.id = id;
+        program.state = Program::State::Linked;
+        program.fromBinary = true;
+        program.compileMs = 0.0;
+        program.linkMs = Now() - program.submitTime;
+        m_Stats.binaryHits++;
+        m_Stats.blockingMs += program.linkMs;
+        return;
+    }
+
+    SubmitCompile(program);
+}
+
+void ProgramRegistry::SubmitCompile(Program& program) {
+    IsParallelCompileSupported();
+
+    const std::string& geometry = program.sources.Get(ShaderStage::Geometry);
+    program.stages[0] = SubmitStage(GL_VERTEX_SHADER, program.sources.Get(ShaderStage::Vertex));
+    program.stages[1] = geometry.empty() ? 0 : SubmitStage(GL_GEOMETRY_SHADER, geometry);
+    program.stages[2] = SubmitStage(GL_FRAGMENT_SHADER, program.sources.Get(ShaderStage::Fragment));
+    program.state = Program::State::Compiling;
+    program.compileMs = -1.0;
+}
+
+void ProgramRegistry::Release(uint64_t key) {
+    key = Resolve(key);
+    auto it = m_Programs.find(key);
+    if (it == m_Programs.end()) {
+        return;
+    }
+    if (--it->second.refCount <= 0) {
+        DeleteStages(it->second);
+        if (it->second.id) {
+            GLStateCache::Get().DeleteProgram(it->second.id);
+        }
+        m_Programs.erase(it);
+        for (auto alias = m_Aliases.begin(); alias != m_Aliases.end();) {
+            alias = alias->second == key ? m_Aliases.erase(alias) : std::next(alias);
+        }
+        m_PathsRevision++;
+    }
+}
+
+const ProgramRegistry::Program* ProgramRegistry::Link(uint64_t key) {
+    key = Resolve(key);
+    auto it = m_Programs.find(key);
+    if (it == m_Programs.end()) {
+        return nullptr;
+    }
+
+    Program& program = it->second;
+    if (program.state == Program::State::Compiling) {
+        double start = Now();
+        bool linked = LinkStages(program);
+        program.linkMs = Now() - start;
+        m_Stats.blockingMs += program.linkMs;
+
+        if (linked) {
+            BindUniformBlocks(program.id);
+            GLShader::ReflectUniforms(program.id, program.reflection);
+            SaveBinary(HashSources(program.sources), program.id);
+            program.state = Program::State::Linked;
+            m_Stats.compiled++;
+        } else {
+            std::cerr << "Programme inutilisable: " << program.label << std::endl;
+            program.state = Program::State::Failed;
+        }
+    }
+    return program.state == Program::State::Linked ? &program : nullptr;
+}
+
+void ProgramRegistry::Poll() {
+    if (!IsParallelCompileSupported()) {
+        return;     // sans l'extension, la fin de compilation n'est observée qu'au link
+    }
+
+    for (auto& entry : m_Programs) {
+        Program& program = entry.second;
+        if (program.state != Program::State::Compiling || program.compileMs >= 0.0) {
+            continue;
+        }
+
+        bool done = true;
+        for (GLuint stage : program.stages) {
+            GLint complete = GL_TRUE;
+            if (stage) {
+                glGetShaderiv(stage, GL_COMPLETION_STATUS_KHR, &complete);
+            }
+            done = done && complete == GL_TRUE;
+        }
+        if (done) {
+            program.compileMs = Now() - program.submitTime;
+        }
+    }
+}
+
+int ProgramRegistry::Reload(const std::string& path, const std::string& source) {
+    int replaced = 0;
+    for (auto& entry : m_Programs) {
+        Program& program = entry.second;
+
+        ProgramSources sources = program.sources;
+        bool uses = false;
+        for (int i = 0; i < static_cast<int>(ShaderStage::Count); ++i) {
+            if (sources.paths[i] == path) {
+                sources.code[i] = source;
+                uses = true;
+            }
+        }
+        uint64_t previousHash = HashSources(program.sources);
+        uint64_t currentHash = HashSources(sources);
+        if (!uses || currentHash == previousHash) {
+            continue;
+        }
+
+        // Jamais lié (ou en échec) : il suffit de resoumettre les nouvelles sources
+        if (program.state != Program::State::Linked) {
+            DeleteStages(program);
+            program.sources = std::move(sources);
+            program.submitTime = Now();
+            SubmitCompile(program);
+            UpdateAlias(entry.first, previousHash, currentHash);
+            replaced++;
+            continue;
+        }
+
+        // Le nouveau programme est compilé à côté ; l'ancien reste en service s'il échoue
+        Program candidate;
+        candidate.sources = std::move(sources);
+        candidate.submitTime = Now();
+        SubmitCompile(candidate);
+        if (!LinkStages(candidate)) {
+            std::cerr << "Rechargement de " << program.label << " échoué, ancien programme conservé" << std::endl;
+            m_Stats.reloadFailures++;
+            continue;
+        }
+        BindUniformBlocks(candidate.id);
+        GLShader::ReflectUniforms(candidate.id, candidate.reflection);
+        SaveBinary(currentHash, candidate.id);
+
+        GLStateCache::Get().DeleteProgram(program.id);
+        program.id = candidate.id;
+        program.reflection = std::move(candidate.reflection);
+        program.sources = std::move(candidate.sources);
+        program.compileMs = candidate.compileMs;
+        program.linkMs = Now() - candidate.submitTime;
+        program.fromBinary = false;
+        UpdateAlias(entry.first, previousHash, currentHash);
+        replaced++;
+        std::cout << "Shader rechargé: " << program.label << " (" << program.linkMs << " ms)" << std::endl;
+    }
+
+    if (replaced > 0) {
+        m_Stats.reloads += replaced;
+        // Les GLShader relisent id et locations au prochain usage
+        GLShader::s_ProgramGeneration++;
+    }
+    return replaced;
+}
+
+std::vector<std::string> ProgramRegistry::GetSourcePaths() const {
+    std::vector<std::string> paths;
+    for (const auto& entry : m_Programs) {
+        for (const std::string& path : entry.second.sources.paths) {
+            if (!path.empty() && std::find(paths.begin(), paths.end(), path) == paths.end()) {
+                paths.push_back(path);
+            }
+        }
+    }
+    return paths;
+}
+
+ProgramRegistry::Stats ProgramRegistry::GetStats() const {
+    Stats stats = m_Stats;
+    stats.livePrograms = m_Programs.size();
+    for (const auto& entry : m_Programs) {
+        if (entry.second.state == Program::State::Compiling) {
+            stats.pending++;
+        }
+    }
+    return stats;
+}
+
+void ProgramRegistry::PrintReport() const {
+    std::vector<const Program*> programs;
+    for (const auto& entry : m_Programs) {
+        programs.push_back(&entry.second);
+    }
+    std::sort(programs.begin(), programs.end(), [](const Program* a, const Program* b) {
+        return a->submitTime < b->submitTime;
+    });
+
+    std::cout << "=== Shader programs ===" << std::endl;
+    for (const Program* program : programs) {
+        const char* origin = "compilé";
+        switch (program->state) {
+            case Program::State::Compiling: origin = "en attente (jamais utilisé)"; break;
+            case Program::State::Failed:    origin = "ECHEC"; break;
+            case Program::State::Linked:    origin = program->fromBinary ? "cache binaire" : "compilé"; break;
+        }
+
+        char line[256];
+        if (program->compileMs >= 0.0) {
+            snprintf(line, sizeof(line), "%-40s %-28s compile %7.2f ms, link %7.2f ms, %d ref(s)",
+                program->label.c_str(), origin, program->compileMs, program->linkMs, program->refCount);
+        } else {
+            snprintf(line, sizeof(line), "%-40s %-28s compile      -    , link %7.2f ms, %d ref(s)",
+                program->label.c_str(), origin, program->linkMs, program->refCount);
+        }
+        std::cout << line << std::endl;
+    }
+
+    Stats stats = GetStats();
+    std::cout << stats.livePrograms << " programmes : " << stats.compiled << " compilés, "
+              << stats.binaryHits << " depuis le cache binaire, " << stats.shared << " partagés, "
+              << stats.pending << " en attente ; " << stats.blockingMs << " ms bloqués" << std::endl;
+}
+
+void ProgramRegistry::DeleteStages(Program& program) {
+    for (GLuint& stage : program.stages) {
+        if (stage) {
+            if (program.id) {
+                glDetachShader(program.id, stage);
+            }
+            glDeleteShader(stage);
+            stage = 0;
+        }
+    }
+}
+
+bool ProgramRegistry::LinkStages(Program& program) {
+    // Attend la fin des compilations (immédiat si Poll() les a déjà vues finir)
+    bool compiled = true;
+    for (GLuint& stage : program.stages) {
+        if (stage && !ValidateShader(stage)) {
+            stage = 0;      // déjà supprimé par ValidateShader
+            compiled = false;
+        }
+    }
+    if (program.compileMs < 0.0) {
+        program.compileMs = Now() - program.submitTime;
+    }
+    if (!compiled || !program.stages[0] || !program.stages[2]) {
+        DeleteStages(program);
+        return false;
+    }
+
+    program.id = glCreateProgram();
+    for (GLuint stage : program.stages) {
+        if (stage) {
+            glAttachShader(program.id, stage);
+        }
+    }
+    if (IsBinaryCacheSupported()) {
+        glProgramParameteri(program.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program.id);
+
+    // Les shader objects ne servent plus une fois le programme lié
+    DeleteStages(program);
+
+    GLint linked = 0;
+    glGetProgramiv(program.id, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        GLint infoLen = 0;
+        glGetProgramiv(program.id, GL_INFO_LOG_LENGTH, &infoLen);
+
+        if (infoLen > 1)
+        {
+            std::string infoLog(infoLen, '\0');
+            glGetProgramInfoLog(program.id, infoLen, NULL, &infoLog[0]);
+            std::cout << "Erreur de lien du programme: " << infoLog.c_str() << std::endl;
+        }
+
+        GLStateCache::Get().DeleteProgram(program.id);
+        program.id = 0;
+        return false;
+    }
+    return true;
+}
+
+void ProgramRegistry::BindUniformBlocks(GLuint program) {
+    // Lier les UBOs aux points de binding appropriés
+    GLuint blockIndex = glGetUniformBlockIndex(program, "ProjectionView");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, UBOManager::PROJECTION_VIEW_BINDING);
+    }
+
+    blockIndex = glGetUniformBlockIndex(program, "Transform");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, UBOManager::TRANSFORM_BINDING);
+    }
+
+    blockIndex = glGetUniformBlockIndex(program, "Materials");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, UBOManager::MATERIAL_BINDING);
+    }
+}
+
+bool ProgramRegistry::IsParallelCompileSupported() {
+    if (m_ParallelSupport < 0) {
+        m_ParallelSupport = (GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile) ? 1 : 0;
+        // Laisser le driver choisir son nombre de threads de compilation
+        if (GLEW_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+        } else if (GLEW_ARB_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+        }
+    }
+    return m_ParallelSupport > 0;
+}
+
+bool ProgramRegistry::IsBinaryCacheSupported() {
+    if (m_BinarySupport < 0) {
+        GLint formats = 0;
+        if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        }
+        m_BinarySupport = formats > 0 ? 1 : 0;
+        // Un binaire n'est valable que pour le driver qui l'a produit
+        m_DriverString = GetGLString(GL_VENDOR) + "|" + GetGLString(GL_RENDERER) + "|" + GetGLString(GL_VERSION);
+    }
+    return m_BinarySupport == 1;
+}
+
+std::string ProgramRegistry::GetBinaryPath(uint64_t key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(m_CacheDirectory) / name).string();
+}
+
+GLuint ProgramRegistry::LoadBinary(uint64_t key) {
+    if (!IsBinaryCacheSupported()) {
+        return 0;
+    }
+
+    std::string path = GetBinaryPath(key);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return 0;
+    }
+
+    BinaryHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 ||
+        header.version != BINARY_VERSION ||
+        header.sourceHash != key ||
+        header.driverHash != HashAppend(FNV_OFFSET, m_DriverString) ||
+        header.length == 0) {
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    if (!in.read(binary.data(), binary.size())) {
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // Driver mis à jour sans changer de chaîne de version : on recompile
+        GLStateCache::Get().DeleteProgram(program);
+        in.close();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return 0;
+    }
+    return program;
+}
+
+void ProgramRegistry::SaveBinary(uint64_t key, GLuint program) {
+    if (!IsBinaryCacheSupported()) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return;
+    }
+
+    BinaryHeader header;
+    memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.binaryFormat = format;
+    header.sourceHash = key;
+    header.driverHash = HashAppend(FNV_OFFSET, m_DriverString);
+    header.length = static_cast<uint32_t>(written);
+    header.reserved = 0;
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_CacheDirectory, ec);
+
+    // Écriture dans un fichier temporaire puis renommage : jamais de cache à moitié écrit
+    std::string path = GetBinaryPath(key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), written);
+        if (!out) {
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
@@ -0,0 +1,91 @@
+#include "../include/RangeAllocator.h"
+#include <algorithm>
+
+size_t RangeAllocator::Allocate(size_t count) {
+    if (count == 0) {
+        return INVALID;
+    }
+
+    // Plus petit trou suffisant : les grands restent pour les grosses géométries
+    auto best = m_Holes.end();
+    for (auto it = m_Holes.begin(); it != m_Holes.end(); ++it) {
+        if (it->second >= count && (best == m_Holes.end() || it->second < best->second)) {
+            best = it;
+            if (it->second == count) break;
+        }
+    }
+    if (best != m_Holes.end()) {
+        size_t offset = best->first;
+        size_t remaining = best->second - count;
+        m_Holes.erase(best);
+        if (remaining > 0) {
+            m_Holes[offset + count] = remaining;
+        }
+        m_Live += count;
+        return offset;
+    }
+
+    if (m_End + count > m_Capacity) {
+        return INVALID;
+    }
+    size_t offset = m_End;
+    m_End += count;
+    m_Live += count;
+    return offset;
+}
+
+void RangeAllocator::Free(size_t offset, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    m_Live -= count;
+
+    // Fusion avec le trou suivant puis le précédent
+    auto next = m_Holes.lower_bound(offset);
+    if (next != m_Holes.end() && offset + count == next->first) {
+        count += next->second;
+        next = m_Holes.erase(next);
+    }
+    if (next != m_Holes.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            count += previous->second;
+            m_Holes.erase(previous);
+        }
+    }
+
+    // Trou en fin de zone occupée : la fin recule
+    if (offset + count == m_End) {
+        m_End = offset;
+    } else {
+        m_Holes[offset] = count;
+    }
+}
+
+void RangeAllocator::Grow(size_t capacity) {
+    m_Capacity = std::max(m_Capacity, capacity);
+}
+
+void RangeAllocator::SetPacked(size_t count) {
+    m_Holes.clear();
+    m_End = count;
+    m_Live = count;
+    m_Capacity = std::max(m_Capacity, count);
+}
+
+size_t RangeAllocator::GetLargestFree() const {
+    size_t largest = m_Capacity - m_End;
+    for (const auto& hole : m_Holes) {
+        largest = std::max(largest, hole.second);
+    }
+    return largest;
+}
+
+float RangeAllocator::GetFragmentation() const {
+    size_t totalFree = m_Capacity - m_Live;
+    if (totalFree == 0) {
+        return 0.0f;
+    }
+    return 1.0f - static_cast<float>(GetLargestFree()) / static_cast<float>(totalFree);
+}
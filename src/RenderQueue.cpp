@@ -0,0 +1,113 @@
+#include "../include/RenderQueue.h"
+#include "../include/GLStateCache.h"
+#include "../include/GLShader.h"
+#include "../include/Mesh.h"
+#include "../include/MaterialBuffer.h"
+#include "../include/UBOManager.h"
+#include "../include/RenderStats.h"
+#include <algorithm>
+
+uint64_t RenderQueue::MakeKey(GLuint program, uint32_t materialPage, GLuint texture, GLuint vao, float depth) {
+    uint64_t quantizedDepth = static_cast<uint64_t>(std::min(std::max(depth, 0.0f), 1.0f) * 65535.0f);
+    return (static_cast<uint64_t>(program & 0xFF) << 56) |
+           (static_cast<uint64_t>(materialPage & 0xFF) << 48) |
+           (static_cast<uint64_t>(texture & 0xFFFF) << 32) |
+           (static_cast<uint64_t>(vao & 0xFFFF) << 16) |
+           quantizedDepth;
+}
+
+void RenderQueue::Begin(const Mat4& view, const Mat4& projection) {
+    m_Packets.clear();
+    m_View = view;
+    // Plan far de la perspective (voir Mat4::perspective)
+    m_FarPlane = projection[14] / (projection[10] + 1.0f);
+}
+
+void RenderQueue::Submit(Mesh* mesh, GLShader& shader, GLuint textureUnit) {
+    GLuint vao = mesh->getVAO();
+    if (vao == 0) {
+        return;     // géométrie pas encore chargée
+    }
+
+    DrawPacket packet;
+    packet.mesh = mesh;
+    packet.shader = &shader;
+    packet.program = shader.GetProgram();
+    const Material& material = mesh->getMaterial();
+    packet.texture = mesh->isTextureEnabled() ? material.diffuseMap.GetID() : 0;
+    packet.textureUnit = std::min(textureUnit, GLStateCache::MAX_TEXTURE_UNITS - 1);
+    packet.vao = vao;
+
+    // Profondeur en espace vue : d'avant en arrière à état égal
+    float viewPos[3];
+    m_View.transformPoint(mesh->getPosition(), viewPos);
+    uint32_t page = mesh->getMaterialSlot() / MaterialBuffer::MATERIALS_PER_PAGE;
+    packet.key = MakeKey(packet.program, page, packet.texture, vao, -viewPos[2] / m_FarPlane);
+    m_Packets.push_back(packet);
+}
+
+void RenderQueue::Flush() {
+    if (m_Packets.empty()) {
+        return;
+    }
+
+    std::sort(m_Packets.begin(), m_Packets.end(),
+        [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+
+    // Les liaisons passent par GLStateCache ; seuls les uniforms par programme
+    // sont suivis ici, oubliés à chaque changement de programme
+    const GLShader* currentShader = nullptr;
+    GLint currentMaterialIndex = -1;
+    GLint currentHasTexture = -1;
+    GLint loc_materialIndex = -1;
+    GLint loc_hasTexture = -1;
+
+    GLStateCache& state = GLStateCache::Get();
+    MaterialBuffer& materials = MaterialBuffer::Get();
+    UBOManager& ubo = UBOManager::Get();
+
+    for (const DrawPacket& packet : m_Packets) {
+        if (packet.shader != currentShader) {
+            state.UseProgram(packet.program);
+            currentShader = packet.shader;
+
+            loc_materialIndex = packet.shader->GetLocation(Uniform::MaterialIndex);
+            loc_hasTexture = packet.shader->GetLocation(Uniform::HasTexture);
+            GLint loc_texture = packet.shader->GetLocation(Uniform::Texture);
+            if (loc_texture >= 0) glUniform1i(loc_texture, static_cast<GLint>(packet.textureUnit));
+            currentMaterialIndex = -1;
+            currentHasTexture = -1;
+        }
+
+        float modelMatrix[16];
+        packet.mesh->calculateModelMatrix(modelMatrix);
+        ubo.UpdateTransform(modelMatrix);
+
+        GLint materialIndex = materials.Bind(packet.mesh->getMaterialSlot());
+        if (materialIndex != currentMaterialIndex && loc_materialIndex >= 0) {
+            glUniform1i(loc_materialIndex, materialIndex);
+            currentMaterialIndex = materialIndex;
+        }
+
+        // Sans texture, u_hasTexture à 0 suffit : l'unité garde sa liaison
+        if (packet.texture != 0) {
+            state.BindTexture(packet.textureUnit, GL_TEXTURE_2D, packet.texture);
+        }
+
+        GLint hasTexture = packet.texture != 0 ? 1 : 0;
+        if (hasTexture != currentHasTexture && loc_hasTexture >= 0) {
+            glUniform1i(loc_hasTexture, hasTexture);
+            currentHasTexture = hasTexture;
+        }
+
+        // VAO de la GeometryArena, commun à tous les packets : le cache évite la liaison
+        state.BindVertexArray(packet.vao);
+        ArenaRange range = packet.mesh->getArenaRange();
+        glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+            (void*)(range.firstIndex * sizeof(unsigned int)), range.baseVertex);
+        RenderStats::Get().draws++;
+        RenderStats::Get().triangles += range.indexCount / 3;
+    }
+
+    m_Packets.clear();
+}
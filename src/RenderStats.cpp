@@ -0,0 +1,10 @@
+#include "../include/RenderStats.h"
+
+RenderStats& RenderStats::Get() {
+    static RenderStats instance;
+    return instance;
+}
+
+void RenderStats::Reset() {
+    *this = RenderStats();
+}
@@ -1,13 +1,13 @@
 #include "../include/SceneManager.h"
 #include <iostream>
 #include <algorithm>
-#include <cstdio>  // Pour sprintf
 #include "../include/CameraController.h" // Ajouté pour CameraController
 #include <UBOManager.h>
 #include <filesystem> // Pour vérifier l'existence des fichiers
-
-// Définir MAX_LIGHTS en haut du fichier
-#define MAX_LIGHTS 10
+#include <iterator>
+#include <random>
+#include "../include/LightManager.h"
+#include "../include/RenderStats.h"
 
 // ==================== Scene Implementation ====================
 
@@ -53,6 +53,45 @@ bool Scene::InitializeCubeMap() {
     return false;
 }
 
+void Scene::RefitBVH() {
+    m_bvh.Refit([](void* userData) -> const Bounds& {
+        return static_cast<Mesh*>(userData)->getWorldBounds();
+    });
+}
+
+const std::vector<Mesh*>& Scene::GatherVisible() {
+    RefitBVH();
+
+    // Boîtes élargies dans l'arbre, volumes exacts pour les feuilles retenues
+    m_visibleObjects.clear();
+    m_bvh.Query(m_frustum, [this](void* userData) {
+        Mesh* object = static_cast<Mesh*>(userData);
+        if (m_frustum.Intersects(object->getWorldBounds())) {
+            object->updateLOD(m_lodCameraPos, m_lodPixelScale);
+            m_visibleObjects.push_back(object);
+        }
+    });
+
+    RenderStats& stats = RenderStats::Get();
+    stats.visibleObjects += static_cast<int>(m_visibleObjects.size());
+    stats.culledObjects += static_cast<int>(m_objects.size() - m_visibleObjects.size());
+    return m_visibleObjects;
+}
+
+Mesh* Scene::Pick(const float* origin, const float* direction, float maxDistance) {
+    RefitBVH();
+
+    // Chaque impact raccourcit le rayon : les boîtes plus lointaines sont ignorées
+    Mesh* picked = nullptr;
+    m_bvh.Raycast(origin, direction, maxDistance, [&](void* userData, float& distance) {
+        Mesh* object = static_cast<Mesh*>(userData);
+        if (object->raycast(origin, direction, distance)) {
+            picked = object;
+        }
+    });
+    return picked;
+}
+
 bool Scene::InitializeShaders() {
     std::cout << "Loading Basic shader..." << std::endl;
     
@@ -153,10 +192,37 @@ void Scene::CleanupShaders() {
     m_basicShader.Destroy();
     m_colorShader.Destroy();
     m_envMapShader.Destroy();
+    m_indirectRenderer.Cleanup();
+}
+
+bool Scene::InitializeIndirect() {
+    if (!IndirectRenderer::IsSupported()) {
+        return false;
+    }
+    if (!m_indirectRenderer.Initialize(GetShaderPath("BasicIndirect.vs"), GetShaderPath("BasicInstanced.fs")) ||
+        !m_indirectRenderer.IsInitialized()) {
+        std::cerr << "Indirect rendering disabled, falling back to per-object draws" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Scene::FlushIndirect(const float* viewPos) {
+    if (!m_indirectRenderer.IsInitialized()) {
+        return;
+    }
+    GLShader& shader = m_indirectRenderer.GetShader();
+    shader.Use();
+    GLint loc_viewPos = shader.GetLocation(Uniform::ViewPos);
+    if (loc_viewPos >= 0) glUniform3fv(loc_viewPos, 1, viewPos);
+    LightManager::Get().Apply(shader);
+    m_indirectRenderer.Flush();
 }
 
 // ==================== SolarSystemScene Implementation ====================
 
+bool SolarSystemScene::s_AsteroidBeltEnabled = false;
+
 SolarSystemScene::~SolarSystemScene() {
     Cleanup();
 }
@@ -166,10 +232,17 @@ bool SolarSystemScene::Initialize() {
         return false;
     }
     
+    // IsInitialized force le link différé : un programme cassé est vu dès maintenant
+    if (!m_instancedRenderer.Initialize(GetShaderPath("BasicInstanced.vs"), GetShaderPath("BasicInstanced.fs")) ||
+        !m_instancedRenderer.IsInitialized()) {
+        std::cerr << "Instanced rendering disabled, falling back to per-object draws" << std::endl;
+    }
+    
     try {
         createSun();
         createPlanets();
         loadPlanetTextures();
+        createAsteroidBelt();
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Error initializing Solar System Scene: " << e.what() << std::endl;
@@ -186,50 +259,50 @@ void SolarSystemScene::Render(const Mat4& projection, const Mat4& view) {
     extern CameraController* g_Camera;
     const float* cameraPos = g_Camera->GetPosition();
 
-    for (Mesh* obj : m_objects) {
-        GLShader* shader = nullptr;
-        if (obj == m_sun) {
-            shader = &GetBasicShader();
-        } else {
-            shader = &GetBasicShader();  // Par défaut
-        }
-        
-        GLuint program = shader->GetProgram();
-        glUseProgram(program);
+    // Lumières émissives rassemblées une fois par frame et réparties en clusters
+    LightManager& lights = LightManager::Get();
+    lights.BeginFrame();
+    lights.AddEmissiveMeshes(m_objects);
+    lights.Build(view, projection);
 
-        // Matrices communes à tous les shaders
-        GLint loc_proj = glGetUniformLocation(program, "u_projection");
-        if (loc_proj >= 0) glUniformMatrix4fv(loc_proj, 1, GL_FALSE, projection.data());
-        
-        GLint loc_view = glGetUniformLocation(program, "u_view");
-        if (loc_view >= 0) glUniformMatrix4fv(loc_view, 1, GL_FALSE, view.data());
-
-        // Matrice de transformation de l'objet
-        float modelMatrix[16];
-        obj->calculateModelMatrix(modelMatrix);
-        GLint loc_transform = glGetUniformLocation(program, "u_transform");
-        if (loc_transform >= 0) glUniformMatrix4fv(loc_transform, 1, GL_FALSE, modelMatrix);
-
-        // Configuration spécifique selon le type de shader
-        if (shader == &GetBasicShader()) {
-            setupBasicShader(program, obj, m_lightColor, m_lightIntensity, cameraPos);
-        }
-        else if (shader == &GetColorShader()) {
-            setupColorShader(program, obj);
+    // L'éclairage ne dépend pas de l'objet : réglé une fois pour le shader Basic
+    GLShader& basicShader = GetBasicShader();
+    basicShader.Use();
+    setupLighting(basicShader, m_lightColor, m_lightIntensity, cameraPos);
+
+    bool instancing = m_instancedRenderer.IsInitialized();
+    if (instancing) {
+        m_instancedRenderer.Begin();
+    }
+
+    // Tous les objets du système solaire passent par le shader Basic
+    m_renderQueue.Begin(view, projection);
+    for (Mesh* obj : GatherVisible()) {
+        // Les sphères sont regroupées et dessinées plus bas en une fois
+        if (instancing && m_instancedRenderer.Submit(obj)) {
+            continue;
         }
-        else if (shader == &GetEnvMapShader()) {
-            setupEnvMapShader(program, obj, cameraPos);
+        m_renderQueue.Submit(obj, basicShader);
+    }
+    m_renderQueue.Flush();
+
+    if (instancing) {
+        if (s_AsteroidBeltEnabled) {
+            submitAsteroidBelt();
         }
 
-        obj->draw(*shader);
+        GLShader& instancedShader = m_instancedRenderer.GetShader();
+        instancedShader.Use();
+        setupLighting(instancedShader, m_lightColor, m_lightIntensity, cameraPos);
+        m_instancedRenderer.Flush();
     }
 }
 
-void SolarSystemScene::setupBasicShader(GLuint program, Mesh* obj, float* light_color, float light_intensity, const float* cameraPos) {
+void SolarSystemScene::setupLighting(GLShader& shader, float* light_color, float light_intensity, const float* cameraPos) {
     // Configuration de l'éclairage principal (le soleil)
     if (m_sun) {
         const float* sunPos = m_sun->getPosition();
-        GLint loc_lightDir = glGetUniformLocation(program, "u_light.direction");
+        GLint loc_lightDir = shader.GetLocation(Uniform::LightDirection);
         if (loc_lightDir >= 0) glUniform3f(loc_lightDir, sunPos[0], sunPos[1], sunPos[2]);
     }
     
@@ -239,179 +312,20 @@ void SolarSystemScene::setupBasicShader(GLuint program, Mesh* obj, float* light_
         light_color[2] * light_intensity * 2.0f
     };
 
-    GLint loc_lightDiffuse = glGetUniformLocation(program, "u_light.diffuseColor");
-    GLint loc_lightSpecular = glGetUniformLocation(program, "u_light.specularColor");
-    GLint loc_intensity = glGetUniformLocation(program, "u_intensity");
+    GLint loc_lightDiffuse = shader.GetLocation(Uniform::LightDiffuseColor);
+    GLint loc_lightSpecular = shader.GetLocation(Uniform::LightSpecularColor);
+    GLint loc_intensity = shader.GetLocation(Uniform::Intensity);
     
     if (loc_intensity >= 0) glUniform1f(loc_intensity, light_intensity);
     if (loc_lightDiffuse >= 0) glUniform3fv(loc_lightDiffuse, 1, lightDiffuse);
     if (loc_lightSpecular >= 0) glUniform3fv(loc_lightSpecular, 1, lightDiffuse);
 
     // Position de la caméra pour les calculs de spécularité
-    GLint loc_viewPos = glGetUniformLocation(program, "u_viewPos");
+    GLint loc_viewPos = shader.GetLocation(Uniform::ViewPos);
     if (loc_viewPos >= 0) glUniform3fv(loc_viewPos, 1, cameraPos);
 
-    // Configuration des lumières émissives multiples
-    std::vector<Mesh*> emissiveLights;
-    if (m_sun && m_sun->getMaterial().isEmissive) {
-        emissiveLights.push_back(m_sun);
-    }
-    
-    // Ajouter d'autres objets émissifs de la scène
-    for (Mesh* meshObj : m_objects) {
-        if (meshObj != m_sun && meshObj->getMaterial().isEmissive) {
-            emissiveLights.push_back(meshObj);
-        }
-    }
-
-    int numLights = std::min((int)emissiveLights.size(), (int)MAX_LIGHTS);
-    GLint loc_numLights = glGetUniformLocation(program, "u_numEmissiveLights");
-    if (loc_numLights >= 0) glUniform1i(loc_numLights, numLights);
-    
-    for (size_t i = 0; i < emissiveLights.size() && i < MAX_LIGHTS; i++) {
-        const auto& light = emissiveLights[i];
-        const auto& mat = light->getMaterial();
-        const float* pos = light->getPosition();
-
-        char buffer[64];
-        sprintf(buffer, "u_emissiveLights[%zu].position", i);
-        GLint loc_pos = glGetUniformLocation(program, buffer);
-        if (loc_pos >= 0) glUniform3fv(loc_pos, 1, pos);
-        
-        sprintf(buffer, "u_emissiveLights[%zu].color", i);
-        GLint loc_color = glGetUniformLocation(program, buffer);
-        if (loc_color >= 0) glUniform3fv(loc_color, 1, mat.lightColor);
-        
-        sprintf(buffer, "u_emissiveLights[%zu].intensity", i);
-        GLint loc_lightIntensity = glGetUniformLocation(program, buffer);
-        if (loc_lightIntensity >= 0) glUniform1f(loc_lightIntensity, mat.emissiveIntensity);
-    }
-
-    // Configuration du matériau de l'objet
-    const Material& mat = obj->getMaterial();
-    
-    GLint loc_matDiffuse = glGetUniformLocation(program, "u_material.diffuseColor");
-    GLint loc_matSpecular = glGetUniformLocation(program, "u_material.specularColor");
-    GLint loc_matShininess = glGetUniformLocation(program, "u_material.shininess");
-    GLint loc_isEmissive = glGetUniformLocation(program, "u_material.isEmissive");
-    GLint loc_emissiveIntensity = glGetUniformLocation(program, "u_material.emissiveIntensity");
-    GLint loc_lightColor = glGetUniformLocation(program, "u_material.lightColor");
-    
-    if (loc_matDiffuse >= 0) glUniform3fv(loc_matDiffuse, 1, mat.diffuse);
-    if (loc_matSpecular >= 0) glUniform3fv(loc_matSpecular, 1, mat.specular);
-    if (loc_matShininess >= 0) glUniform1f(loc_matShininess, mat.shininess);
-    if (loc_isEmissive >= 0) glUniform1i(loc_isEmissive, mat.isEmissive ? 1 : 0);
-    if (loc_emissiveIntensity >= 0) glUniform1f(loc_emissiveIntensity, mat.emissiveIntensity);
-    if (loc_lightColor >= 0) glUniform3fv(loc_lightColor, 1, mat.lightColor);
-    
-    // Gérer l'affichage de la texture pour le shader Basic - CORRECTION COMPLÈTE
-    GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-    GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-    
-    bool hasTexture = (obj->getMaterial().diffuseMap != 0);
-    if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, hasTexture);
-    if (loc_useTexture >= 0) glUniform1i(loc_useTexture, mat.useTextureInBasicShader);
-    
-    // Lier la texture seulement si on veut l'utiliser ET qu'elle existe
-    if (hasTexture && mat.useTextureInBasicShader) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, obj->getMaterial().diffuseMap);
-        GLint loc_texture = glGetUniformLocation(program, "u_texture");
-        if (loc_texture >= 0) glUniform1i(loc_texture, 0);
-    } else {
-        // IMPORTANT: Débinder la texture si on ne l'utilise pas
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-}
-
-void SolarSystemScene::setupColorShader(GLuint program, Mesh* obj) {
-    const Material& mat = obj->getMaterial();
-    GLint loc_color = glGetUniformLocation(program, "u_color");
-    if (loc_color >= 0) {
-        glUniform3fv(loc_color, 1, mat.diffuse);
-    }
-    
-    // Gérer l'affichage de la texture pour le shader Color - CORRECTION
-    GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-    GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-    
-    bool hasTexture = (obj->getMaterial().diffuseMap != 0);
-    if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, hasTexture);
-    if (loc_useTexture >= 0) glUniform1i(loc_useTexture, mat.useTextureInColorShader);
-    
-    // Lier la texture seulement si on veut l'utiliser ET qu'elle existe
-    if (hasTexture && mat.useTextureInColorShader) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, obj->getMaterial().diffuseMap);
-        GLint loc_texture = glGetUniformLocation(program, "u_texture");
-        if (loc_texture >= 0) glUniform1i(loc_texture, 0);
-    } else {
-        // IMPORTANT: Débinder la texture si on ne l'utilise pas
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-}
-
-void SolarSystemScene::setupEnvMapShader(GLuint program, Mesh* obj, const float* cameraPos) {
-    const Material& mat = obj->getMaterial();
-    
-    // Position de la caméra pour les réflections
-    GLint loc_viewPos = glGetUniformLocation(program, "u_viewPos");
-    if (loc_viewPos >= 0) glUniform3fv(loc_viewPos, 1, cameraPos);
-    
-    // Nouveau uniform pour ignorer le matériau
-    GLint loc_ignoreMaterial = glGetUniformLocation(program, "u_ignoreObjectMaterial");
-    if (loc_ignoreMaterial >= 0) glUniform1i(loc_ignoreMaterial, mat.ignoreObjectMaterialInEnvMap);
-    
-    // Si on ignore le matériau, pas besoin de configurer les autres paramètres
-    if (!mat.ignoreObjectMaterialInEnvMap) {
-        // Paramètres du matériau pour l'environment mapping
-        GLint loc_matDiffuse = glGetUniformLocation(program, "u_material.diffuseColor");
-        GLint loc_matSpecular = glGetUniformLocation(program, "u_material.specularColor");
-        GLint loc_matShininess = glGetUniformLocation(program, "u_material.shininess");
-        GLint loc_specularStrength = glGetUniformLocation(program, "u_material.specularStrength");
-        
-        if (loc_matDiffuse >= 0) glUniform3fv(loc_matDiffuse, 1, mat.diffuse);
-        if (loc_matSpecular >= 0) glUniform3fv(loc_matSpecular, 1, mat.specular);
-        if (loc_matShininess >= 0) glUniform1f(loc_matShininess, mat.shininess);
-        if (loc_specularStrength >= 0) glUniform1f(loc_specularStrength, mat.specularStrength);
-        
-        // Gérer l'affichage de la texture pour le shader EnvMap
-        GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-        GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-        
-        bool hasTexture = (obj->getMaterial().diffuseMap != 0);
-        if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, hasTexture);
-        if (loc_useTexture >= 0) glUniform1i(loc_useTexture, mat.useTextureInEnvMapShader);
-        
-        // Lier la texture seulement si on veut l'utiliser ET qu'elle existe
-        if (hasTexture && mat.useTextureInEnvMapShader) {
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, obj->getMaterial().diffuseMap);
-            GLint loc_texture = glGetUniformLocation(program, "u_texture");
-            if (loc_texture >= 0) glUniform1i(loc_texture, 1);
-        } else {
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, 0);
-        }
-    } else {
-        // Si on ignore le matériau, débinder toutes les textures
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        
-        GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-        GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-        if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, 0);
-        if (loc_useTexture >= 0) glUniform1i(loc_useTexture, 0);
-    }
-    
-    // Associer le cubemap au shader (unité de texture 0) - toujours nécessaire
-    if (m_CubeMap.IsLoaded()) {
-        m_CubeMap.Bind(0);
-        GLint loc_envmap = glGetUniformLocation(program, "u_envmap");
-        if (loc_envmap >= 0) glUniform1i(loc_envmap, 0);
-    }
+    // Lumières émissives : grille construite en début de frame par LightManager
+    LightManager::Get().Apply(shader);
 }
 
 void SolarSystemScene::Cleanup() {
@@ -439,6 +353,12 @@ void SolarSystemScene::Cleanup() {
     m_sun = nullptr;
     m_objects.clear();
     m_planets.clear();
+    m_planetSystem.Clear();
+
+    delete m_asteroidMesh;
+    m_asteroidMesh = nullptr;
+    m_asteroidBelt.Clear();
+    m_instancedRenderer.Cleanup();
 }
 
 void SolarSystemScene::createSun() {
@@ -463,7 +383,7 @@ void SolarSystemScene::createSun() {
     // Il peut être changé via l'interface utilisateur
     m_sun->setCurrentShader(nullptr); // Sera assigné lors du premier rendu
 
-    m_objects.push_back(m_sun);
+    AddObject(m_sun);
 }
 
 void SolarSystemScene::createPlanets() {
@@ -476,19 +396,25 @@ void SolarSystemScene::createPlanets() {
         {50.0f, 0.15f, 4.0f},   // Jupiter
     };
 
-    for(int i = 0; i < 7; i++) {
+    // Une planète par ligne de planetData (les textures en prévoient davantage)
+    for(size_t i = 0; i < std::size(planetData); i++) {
         m_planets.emplace_back();
         m_planets.back().Initialize(
             planetData[i][0],    // rayon orbital
             planetData[i][1],    // vitesse de rotation
             planetData[i][2]     // taille
         );
+        m_planets.back().AttachToSystem(&m_planetSystem, m_planetSystem.AddBody(
+            planetData[i][0],
+            planetData[i][1],
+            planetData[i][2]
+        ));
         
         // Chaque planète peut avoir son propre shader
         Mesh* planetMesh = m_planets.back().GetMesh();
         planetMesh->setCurrentShader(nullptr); // Sera assigné lors du premier rendu
         
-        m_objects.push_back(planetMesh);
+        AddObject(planetMesh);
     }
 }
 
@@ -521,9 +447,60 @@ void SolarSystemScene::loadPlanetTextures() {
 }
 
 void SolarSystemScene::updatePlanets(float deltaTime) {
+    // Toutes les matrices sont calculées en un passage, puis copiées dans les meshes
+    m_planetSystem.Update(deltaTime);
     for(auto& planet : m_planets) {
-        planet.Update(deltaTime);
+        planet.SyncFromSystem();
+    }
+    if (s_AsteroidBeltEnabled) {
+        m_asteroidBelt.Update(deltaTime);
+    }
+}
+
+void SolarSystemScene::submitAsteroidBelt() {
+    // Sphère de rayon 1 : le rayon monde d'un astéroïde est sa taille
+    m_visibleAsteroids.clear();
+    for (size_t i = 0; i < m_asteroidBelt.GetCount(); ++i) {
+        const float* transform = m_asteroidBelt.GetTransform(i);
+        float size = m_asteroidBelt.GetSize(i);
+        float boxMin[3] = { transform[12] - size, transform[13] - size, transform[14] - size };
+        float boxMax[3] = { transform[12] + size, transform[13] + size, transform[14] + size };
+        if (m_frustum.Intersects(Bounds::FromBox(boxMin, boxMax, size))) {
+            m_visibleAsteroids.insert(m_visibleAsteroids.end(), transform, transform + 16);
+        }
+    }
+    m_instancedRenderer.SubmitInstances(m_asteroidMesh, m_visibleAsteroids.data(),
+        m_visibleAsteroids.size() / 16, m_asteroidMaterial);
+}
+
+void SolarSystemScene::createAsteroidBelt() {
+    // Sphère grossière partagée par tous les astéroïdes
+    m_asteroidMesh = new Mesh();
+    m_asteroidMesh->createSphere(1.0f, 8, 6);
+
+    m_asteroidMaterial = Material();
+    m_asteroidMaterial.diffuse[0] = 0.45f;
+    m_asteroidMaterial.diffuse[1] = 0.42f;
+    m_asteroidMaterial.diffuse[2] = 0.38f;
+    m_asteroidMaterial.specular[0] = m_asteroidMaterial.specular[1] = m_asteroidMaterial.specular[2] = 0.1f;
+    m_asteroidMaterial.specularStrength = 0.1f;
+    m_asteroidMaterial.illuminationModel = Material::IlluminationModel::LAMBERT;
+
+    // Graine fixe : la ceinture est identique à chaque lancement
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> radiusDist(39.0f, 46.0f);
+    std::uniform_real_distribution<float> sizeDist(0.05f, 0.25f);
+    std::uniform_real_distribution<float> angleDist(0.0f, 6.2831853f);
+
+    m_asteroidBelt.Reserve(ASTEROID_COUNT);
+    for (int i = 0; i < ASTEROID_COUNT; ++i) {
+        float radius = radiusDist(rng);
+        // Vitesse képlérienne approximative : plus lent vers l'extérieur
+        float speed = 0.3f * std::pow(35.0f / radius, 1.5f);
+        size_t index = m_asteroidBelt.AddBody(radius, speed, sizeDist(rng));
+        m_asteroidBelt.SetAngle(index, angleDist(rng));
     }
+    m_asteroidBelt.Update(0.0f);
 }
 
 // ==================== DemoScene Implementation ====================
@@ -577,84 +554,50 @@ void DemoScene::Render(const Mat4& projection, const Mat4& view) {
     extern CameraController* g_Camera;
     const float* cameraPos = g_Camera->GetPosition();
 
-    for (Mesh* obj : m_objects) {
-        GLShader* currentShader = obj->getCurrentShader();
-        
-        // Si l'objet n'a pas de shader assigné, utiliser le shader approprié par défaut
-        if (!currentShader) {
+    // Lumières émissives de la scène (grille de clusters pour le shader Basic)
+    LightManager& lights = LightManager::Get();
+    lights.BeginFrame();
+    lights.AddEmissiveMeshes(m_objects);
+    lights.Build(view, projection);
+
+    // Uniforms communs : une fois par programme, les draws triés suivent
+    GLShader& basicShader = GetBasicShader();
+    basicShader.Use();
+    setupBasicShaderDemo(basicShader, light_color, light_intensity, lightPos, cameraPos);
+    lights.Apply(basicShader);
+    GLShader& envMapShader = GetEnvMapShader();
+    envMapShader.Use();
+    setupEnvMapShaderDemo(envMapShader, cameraPos);
+
+    // Si un objet n'a pas de shader assigné, utiliser le shader approprié par défaut
+    // (selon son rang dans la scène, avant le tri par visibilité)
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        Mesh* obj = m_objects[i];
+        if (!obj->getCurrentShader()) {
             // Assigner différents shaders aux objets de demo pour montrer la variété
-            size_t objIndex = std::find(m_objects.begin(), m_objects.end(), obj) - m_objects.begin();
-            switch (objIndex % 3) {
-                case 0: currentShader = &GetColorShader(); break;
-                case 1: currentShader = &GetBasicShader(); break;
-                case 2: currentShader = &GetEnvMapShader(); break;
-                default: currentShader = &GetBasicShader(); break;
+            switch (i % 3) {
+                case 0: obj->setCurrentShader(&GetColorShader()); break;
+                case 1: obj->setCurrentShader(&GetBasicShader()); break;
+                case 2: obj->setCurrentShader(&GetEnvMapShader()); break;
+                default: obj->setCurrentShader(&GetBasicShader()); break;
             }
-            obj->setCurrentShader(currentShader);
-        }
-
-        GLuint program = currentShader->GetProgram();
-        glUseProgram(program);
-
-        // Matrices communes
-        GLint loc_proj = glGetUniformLocation(program, "u_projection");
-        if (loc_proj >= 0) glUniformMatrix4fv(loc_proj, 1, GL_FALSE, projection.data());
-        
-        GLint loc_view = glGetUniformLocation(program, "u_view");
-        if (loc_view >= 0) glUniformMatrix4fv(loc_view, 1, GL_FALSE, view.data());
-
-        // Matrice de transformation de l'objet
-        float modelMatrix[16];
-        obj->calculateModelMatrix(modelMatrix);
-        GLint loc_transform = glGetUniformLocation(program, "u_transform");
-        if (loc_transform >= 0) glUniformMatrix4fv(loc_transform, 1, GL_FALSE, modelMatrix);
-
-        // Configuration spécifique selon le shader
-        if (currentShader == &GetColorShader()) {
-            setupColorShaderDemo(program, obj);
-        }
-        else if (currentShader == &GetBasicShader()) {
-            setupBasicShaderDemo(program, obj, light_color, light_intensity, lightPos, cameraPos);
-        }
-        else if (currentShader == &GetEnvMapShader()) {
-            setupEnvMapShaderDemo(program, obj, cameraPos);
         }
-
-        obj->draw(*currentShader);
     }
-}
 
-void DemoScene::setupColorShaderDemo(GLuint program, Mesh* obj) {
-    const Material& mat = obj->getMaterial();
-    GLint loc_color = glGetUniformLocation(program, "u_color");
-    if (loc_color >= 0) {
-        glUniform3fv(loc_color, 1, mat.diffuse);
-    }
-    
-    // Gérer l'affichage de la texture pour le shader Color - CORRECTION
-    GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-    GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-    
-    bool hasTexture = (obj->getMaterial().diffuseMap != 0);
-    if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, hasTexture);
-    if (loc_useTexture >= 0) glUniform1i(loc_useTexture, mat.useTextureInColorShader);
-    
-    // Lier la texture seulement si on veut l'utiliser ET qu'elle existe
-    if (hasTexture && mat.useTextureInColorShader) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, obj->getMaterial().diffuseMap);
-        GLint loc_texture = glGetUniformLocation(program, "u_texture");
-        if (loc_texture >= 0) glUniform1i(loc_texture, 0);
-    } else {
-        // IMPORTANT: Débinder la texture si on ne l'utilise pas
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
+    m_renderQueue.Begin(view, projection);
+    for (Mesh* obj : GatherVisible()) {
+        GLShader* currentShader = obj->getCurrentShader();
+
+        // EnvMap lit le cubemap sur l'unité 0, sa texture sur l'unité 1
+        GLuint textureUnit = (currentShader == &envMapShader) ? 1 : 0;
+        m_renderQueue.Submit(obj, *currentShader, textureUnit);
     }
+    m_renderQueue.Flush();
 }
 
-void DemoScene::setupBasicShaderDemo(GLuint program, Mesh* obj, float* light_color, float light_intensity, float* lightPos, const float* cameraPos) {
+void DemoScene::setupBasicShaderDemo(GLShader& shader, float* light_color, float light_intensity, float* lightPos, const float* cameraPos) {
     // Éclairage
-    GLint loc_lightDir = glGetUniformLocation(program, "u_light.direction");
+    GLint loc_lightDir = shader.GetLocation(Uniform::LightDirection);
     if (loc_lightDir >= 0) glUniform3f(loc_lightDir, lightPos[0], lightPos[1], lightPos[2]);
     
     float lightDiffuse[3] = {
@@ -663,103 +606,27 @@ void DemoScene::setupBasicShaderDemo(GLuint program, Mesh* obj, float* light_col
         light_color[2] * light_intensity
     };
 
-    GLint loc_lightDiffuse = glGetUniformLocation(program, "u_light.diffuseColor");
-    GLint loc_lightSpecular = glGetUniformLocation(program, "u_light.specularColor");
-    GLint loc_intensity = glGetUniformLocation(program, "u_intensity");
-    GLint loc_viewPos = glGetUniformLocation(program, "u_viewPos");
+    GLint loc_lightDiffuse = shader.GetLocation(Uniform::LightDiffuseColor);
+    GLint loc_lightSpecular = shader.GetLocation(Uniform::LightSpecularColor);
+    GLint loc_intensity = shader.GetLocation(Uniform::Intensity);
+    GLint loc_viewPos = shader.GetLocation(Uniform::ViewPos);
     
     if (loc_intensity >= 0) glUniform1f(loc_intensity, light_intensity);
     if (loc_lightDiffuse >= 0) glUniform3fv(loc_lightDiffuse, 1, lightDiffuse);
     if (loc_lightSpecular >= 0) glUniform3fv(loc_lightSpecular, 1, lightDiffuse);
     if (loc_viewPos >= 0) glUniform3fv(loc_viewPos, 1, cameraPos);
-
-    // Matériau
-    const Material& mat = obj->getMaterial();
-    GLint loc_matDiffuse = glGetUniformLocation(program, "u_material.diffuseColor");
-    GLint loc_matSpecular = glGetUniformLocation(program, "u_material.specularColor");
-    GLint loc_matShininess = glGetUniformLocation(program, "u_material.shininess");
-    GLint loc_isEmissive = glGetUniformLocation(program, "u_material.isEmissive");
-    
-    if (loc_matDiffuse >= 0) glUniform3fv(loc_matDiffuse, 1, mat.diffuse);
-    if (loc_matSpecular >= 0) glUniform3fv(loc_matSpecular, 1, mat.specular);
-    if (loc_matShininess >= 0) glUniform1f(loc_matShininess, mat.shininess);
-    if (loc_isEmissive >= 0) glUniform1i(loc_isEmissive, mat.isEmissive ? 1 : 0);
-    
-    // Gérer l'affichage de la texture pour le shader Basic - CORRECTION
-    GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-    GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-    
-    bool hasTexture = (obj->getMaterial().diffuseMap != 0);
-    if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, hasTexture);
-    if (loc_useTexture >= 0) glUniform1i(loc_useTexture, mat.useTextureInBasicShader);
-    
-    // Lier la texture seulement si on veut l'utiliser ET qu'elle existe
-    if (hasTexture && mat.useTextureInBasicShader) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, obj->getMaterial().diffuseMap);
-        GLint loc_texture = glGetUniformLocation(program, "u_texture");
-        if (loc_texture >= 0) glUniform1i(loc_texture, 0);
-    } else {
-        // IMPORTANT: Débinder la texture si on ne l'utilise pas
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
 }
 
-void DemoScene::setupEnvMapShaderDemo(GLuint program, Mesh* obj, const float* cameraPos) {
-    const Material& mat = obj->getMaterial();
-    
-    GLint loc_viewPos = glGetUniformLocation(program, "u_viewPos");
+void DemoScene::setupEnvMapShaderDemo(GLShader& shader, const float* cameraPos) {
+    GLint loc_viewPos = shader.GetLocation(Uniform::ViewPos);
     if (loc_viewPos >= 0) glUniform3fv(loc_viewPos, 1, cameraPos);
-    
-    // Nouveau uniform pour ignorer le matériau
-    GLint loc_ignoreMaterial = glGetUniformLocation(program, "u_ignoreObjectMaterial");
-    if (loc_ignoreMaterial >= 0) glUniform1i(loc_ignoreMaterial, mat.ignoreObjectMaterialInEnvMap);
-    
-    // Si on ignore le matériau, pas besoin de configurer les autres paramètres
-    if (!mat.ignoreObjectMaterialInEnvMap) {
-        GLint loc_matDiffuse = glGetUniformLocation(program, "u_material.diffuseColor");
-        GLint loc_matSpecular = glGetUniformLocation(program, "u_material.specularColor");
-        GLint loc_matShininess = glGetUniformLocation(program, "u_material.shininess");
-        GLint loc_specularStrength = glGetUniformLocation(program, "u_material.specularStrength");
-        
-        if (loc_matDiffuse >= 0) glUniform3fv(loc_matDiffuse, 1, mat.diffuse);
-        if (loc_matSpecular >= 0) glUniform3fv(loc_matSpecular, 1, mat.specular);
-        if (loc_matShininess >= 0) glUniform1f(loc_matShininess, mat.shininess);
-        if (loc_specularStrength >= 0) glUniform1f(loc_specularStrength, mat.specularStrength);
-        
-        // Gérer l'affichage de la texture pour le shader EnvMap
-        GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-        GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-        
-        bool hasTexture = (obj->getMaterial().diffuseMap != 0);
-        if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, hasTexture);
-        if (loc_useTexture >= 0) glUniform1i(loc_useTexture, mat.useTextureInEnvMapShader);
-        
-        if (hasTexture && mat.useTextureInEnvMapShader) {
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, obj->getMaterial().diffuseMap);
-            GLint loc_texture = glGetUniformLocation(program, "u_texture");
-            if (loc_texture >= 0) glUniform1i(loc_texture, 1);
-        } else {
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, 0);
-        }
-    } else {
-        // Si on ignore le matériau, débinder toutes les textures
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        
-        GLint loc_useTexture = glGetUniformLocation(program, "u_useTexture");
-        GLint loc_hasTexture = glGetUniformLocation(program, "u_hasTexture");
-        if (loc_hasTexture >= 0) glUniform1i(loc_hasTexture, 0);
-        if (loc_useTexture >= 0) glUniform1i(loc_useTexture, 0);
-    }
-    
+
+    // Texture de l'objet (unité 1) et ignoreObjectMaterialInEnvMap : RenderQueue et MaterialBuffer
+
     // Associer le cubemap au shader
     if (m_CubeMap.IsLoaded()) {
         m_CubeMap.Bind(0);
-        GLint loc_envmap = glGetUniformLocation(program, "u_envmap");
+        GLint loc_envmap = shader.GetLocation(Uniform::EnvMap);
         if (loc_envmap >= 0) glUniform1i(loc_envmap, 0);
     }
 }
@@ -783,7 +650,7 @@ void DemoScene::createDemoObjects() {
     colorCube->setMaterial(matColor);
     colorCube->setPosition(-8, 0, -10); // Position initiale
     colorCube->setCurrentShader(nullptr); // Sera assigné lors du rendu
-    m_objects.push_back(colorCube);
+    AddObject(colorCube);
 
     // Cube texturé - utilisera le shader basique
     Mesh* texCube = new Mesh();
@@ -797,7 +664,7 @@ void DemoScene::createDemoObjects() {
     texCube->setMaterial(matTex);
     texCube->setPosition(0, 0, -10);  // Position initiale
     texCube->setCurrentShader(nullptr);
-    m_objects.push_back(texCube);
+    AddObject(texCube);
 
     // Cube environment mapping - utilisera le shader d'environment mapping
     Mesh* envCube = new Mesh();
@@ -810,7 +677,7 @@ void DemoScene::createDemoObjects() {
     envCube->setMaterial(matEnv);
     envCube->setPosition(8, 0, -10);  // Position initiale
     envCube->setCurrentShader(nullptr);
-    m_objects.push_back(envCube);
+    AddObject(envCube);
 }
 
 // ==================== EmptyScene Implementation ====================
@@ -827,6 +694,7 @@ bool EmptyScene::Initialize() {
             std::cerr << "Failed to initialize shaders for EmptyScene" << std::endl;
             return false;
         }
+        InitializeIndirect();
         std::cout << "EmptyScene shaders initialized successfully" << std::endl;
     }
     catch (const std::exception& e) {
@@ -850,17 +718,30 @@ void EmptyScene::Update(float deltaTime) {
 }
 
 void EmptyScene::Render(const Mat4& projection, const Mat4& view) {
-    for (Mesh* obj : m_objects) {
-        if (obj) {
-            if (!obj->getCurrentShader()) {
-                obj->setCurrentShader(&m_basicShader);
-            }
-            GLShader* shader = obj->getCurrentShader();
-            if (shader) {
-                obj->draw(*shader);
-            }
+    LightManager& lights = LightManager::Get();
+    lights.BeginFrame();
+    lights.AddEmissiveMeshes(m_objects);
+    lights.Build(view, projection);
+    m_basicShader.Use();
+    lights.Apply(m_basicShader);
+
+    m_renderQueue.Begin(view, projection);
+    m_indirectRenderer.Begin();
+    for (Mesh* obj : GatherVisible()) {
+        if (!obj->getCurrentShader()) {
+            obj->setCurrentShader(&m_basicShader);
+        }
+        GLShader* shader = obj->getCurrentShader();
+        // Shader Basic : un seul multi-draw pour tous ces objets
+        if (shader == &m_basicShader && m_indirectRenderer.Submit(obj)) {
+            continue;
+        }
+        if (shader) {
+            m_renderQueue.Submit(obj, *shader);
         }
     }
+    m_renderQueue.Flush();
+    FlushIndirect(m_lodCameraPos);
 }
 
 void EmptyScene::Cleanup() {
@@ -880,6 +761,112 @@ void EmptyScene::Cleanup() {
     std::cout << "Shaders cleaned up" << std::endl;
 }
 
+// ==================== BenchmarkScene Implementation ====================
+
+BenchmarkScene::BenchmarkScene(int objectCount)
+    : Scene("Benchmark"), m_objectCount(objectCount) {
+}
+
+BenchmarkScene::~BenchmarkScene() {
+    Cleanup();
+}
+
+bool BenchmarkScene::Initialize() {
+    if (!InitializeShaders()) {
+        return false;
+    }
+    InitializeIndirect();
+
+    // Grille carrée de sphères autour de l'origine, géométrie partagée
+    int side = (int)std::ceil(std::sqrt((float)m_objectCount));
+    const float spacing = 3.0f;
+    for (int i = 0; i < m_objectCount; ++i) {
+        Mesh* mesh = new Mesh();
+        mesh->createSphere(1.0f, 16, 12);
+
+        Material mat;
+        mat.diffuse[0] = 0.3f + 0.7f * (float)(i % side) / side;
+        mat.diffuse[1] = 0.3f + 0.7f * (float)(i / side) / side;
+        mat.diffuse[2] = 0.6f;
+        mesh->setMaterial(mat);
+        mesh->setPosition((i % side - side * 0.5f) * spacing, 0.0f, (i / side - side * 0.5f) * spacing);
+        AddObject(mesh);
+    }
+    return true;
+}
+
+void BenchmarkScene::Update(float deltaTime) {
+    // Chaque matrice change à chaque frame, comme pour des objets animés
+    m_time += deltaTime;
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        m_objects[i]->setRotation(0.0f, m_time + i * 0.01f, 0.0f);
+    }
+}
+
+void BenchmarkScene::Render(const Mat4& projection, const Mat4& view) {
+    GLShader& shader = GetBasicShader();
+    shader.Use();
+
+    // Une seule lumière émissive fixe au-dessus de la grille
+    const float lightPos[3] = { 0.0f, 30.0f, 0.0f };
+    const float lightColor[3] = { 1.0f, 1.0f, 1.0f };
+    const float viewPos[3] = { 0.0f, 60.0f, 60.0f };
+    GLint loc_viewPos = shader.GetLocation(Uniform::ViewPos);
+    if (loc_viewPos >= 0) glUniform3fv(loc_viewPos, 1, viewPos);
+
+    LightManager& lights = LightManager::Get();
+    lights.BeginFrame();
+    lights.AddLight(lightPos, lightColor, 40.0f);
+    lights.Build(view, projection);
+    lights.Apply(shader);
+
+    if (m_instancing) {
+        m_instancedRenderer.Begin();
+    }
+    m_indirectRenderer.Begin();
+    for (Mesh* obj : m_objects) {
+        obj->updateLOD(m_lodCameraPos, m_lodPixelScale);
+        if (m_instancing && m_instancedRenderer.Submit(obj)) {
+            continue;
+        }
+        if (m_indirectRenderer.Submit(obj)) {
+            continue;
+        }
+        obj->draw(shader);
+    }
+    FlushIndirect(viewPos);
+
+    if (m_instancing) {
+        GLShader& instancedShader = m_instancedRenderer.GetShader();
+        instancedShader.Use();
+        loc_viewPos = instancedShader.GetLocation(Uniform::ViewPos);
+        if (loc_viewPos >= 0) glUniform3fv(loc_viewPos, 1, viewPos);
+        lights.Apply(instancedShader);
+        m_instancedRenderer.Flush();
+    }
+}
+
+bool BenchmarkScene::SetInstancingEnabled(bool enabled) {
+    if (enabled && !m_instancedRenderer.IsInitialized()) {
+        // Programme cassé : on repart de zéro à chaque demande
+        m_instancedRenderer.Cleanup();
+        if (!m_instancedRenderer.Initialize(GetShaderPath("BasicInstanced.vs"), GetShaderPath("BasicInstanced.fs")) ||
+            !m_instancedRenderer.IsInitialized()) {
+            return false;
+        }
+    }
+    m_instancing = enabled;
+    return true;
+}
+
+void BenchmarkScene::Cleanup() {
+    for (Mesh* obj : m_objects) {
+        delete obj;
+    }
+    m_objects.clear();
+    m_instancedRenderer.Cleanup();
+}
+
 // ==================== SceneManager Implementation ====================
 
 SceneManager& SceneManager::GetInstance() {
@@ -972,8 +959,15 @@ void SceneManager::Update(float deltaTime) {
     }
 }
 
-void SceneManager::Render(const Mat4& projection, const Mat4& view) {
+void SceneManager::Render(const Mat4& projection, const Mat4& view, const Frustum& frustum) {
     if (m_activeScene) {
+        m_activeScene->SetFrustum(frustum);
+
+        // Position caméra : translation de l'inverse de la vue
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        Mat4 inverseView = view.inverse();
+        m_activeScene->SetLODView(inverseView.data() + 12, projection.data()[5] * viewport[3] * 0.5f);
         m_activeScene->Render(projection, view);
     }
 }
@@ -985,6 +979,11 @@ void SceneManager::Cleanup() {
     m_sceneOrder.clear();
 }
 
+Scene* SceneManager::GetScene(const std::string& name) const {
+    auto it = m_scenes.find(name);
+    return it != m_scenes.end() ? it->second.get() : nullptr;
+}
+
 std::vector<std::string> SceneManager::GetSceneNames() const {
     return m_sceneOrder;
 }
@@ -0,0 +1,99 @@
+#include "../include/ShaderWatcher.h"
+#include "../include/ProgramRegistry.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+ShaderWatcher& ShaderWatcher::Get() {
+    static ShaderWatcher instance;
+    return instance;
+}
+
+ShaderWatcher::~ShaderWatcher() {
+    Stop();
+}
+
+void ShaderWatcher::Start() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Running) {
+        return;
+    }
+    m_Running = true;
+    m_Thread = std::thread(&ShaderWatcher::WatchLoop, this);
+}
+
+void ShaderWatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Running) {
+            return;
+        }
+        m_Running = false;
+    }
+    m_Wake.notify_all();
+    if (m_Thread.joinable()) {
+        m_Thread.join();
+    }
+}
+
+void ShaderWatcher::Update() {
+    ProgramRegistry& registry = ProgramRegistry::Get();
+
+    std::vector<std::pair<std::string, std::string>> changed;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (registry.GetPathsRevision() != m_PathsRevision) {
+            m_PathsRevision = registry.GetPathsRevision();
+            m_WatchedPaths = registry.GetSourcePaths();
+        }
+        changed.swap(m_ChangedSources);
+    }
+
+    for (const auto& file : changed) {
+        registry.Reload(file.first, file.second);
+    }
+}
+
+void ShaderWatcher::WatchLoop() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (m_Running) {
+        std::vector<std::string> paths = m_WatchedPaths;
+        lock.unlock();
+
+        // Lecture des fichiers modifiés hors du thread de rendu
+        std::vector<std::pair<std::string, std::string>> changed;
+        for (const std::string& path : paths) {
+            std::error_code ec;
+            std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, ec);
+            if (ec) {
+                continue;   // fichier en cours de remplacement par l'éditeur
+            }
+
+            auto it = m_WriteTimes.find(path);
+            if (it == m_WriteTimes.end()) {
+                m_WriteTimes[path] = writeTime;     // premier relevé : référence
+                continue;
+            }
+            if (it->second == writeTime) {
+                continue;
+            }
+            it->second = writeTime;
+
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                continue;
+            }
+            std::string source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            changed.emplace_back(path, std::move(source));
+        }
+
+        lock.lock();
+        for (auto& file : changed) {
+            std::cout << "Shader modifié: " << file.first << std::endl;
+            m_ChangedSources.push_back(std::move(file));
+        }
+        m_Wake.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL_MS), [this]() { return !m_Running; });
+    }
+}
@@ -1,6 +1,7 @@
 #include "../include/Skybox.h"
+#include "../include/GLStateCache.h"
 #include "../include/UBOManager.h"
-#include <stb/stb_image.h>
+#include "../include/TextureStreamer.h"
 #include <iostream>
 #include <filesystem>
 #include <vector>
@@ -91,8 +92,8 @@ bool Skybox::CreateBuffers() {
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
     
-    glBindVertexArray(m_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    GLStateCache::Get().BindVertexArray(m_VAO);
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), skyboxVertices, GL_STATIC_DRAW);
     
     glEnableVertexAttribArray(0);
@@ -126,6 +127,11 @@ bool Skybox::LoadCubeMap() {
         return CreateProceduralCubeMap(); // Fallback sur un cubemap procédural
     }
 
+    // Version compressée produite par "make textures", si disponible
+    if (LoadCompressedCubeMap(skyboxDir.string(), faceFiles)) {
+        return true;
+    }
+
     // Construire les chemins complets
     std::vector<std::string> fullPaths;
     for (const auto& filename : faceFiles) {
@@ -139,33 +145,18 @@ bool Skybox::LoadCubeMap() {
         }
     }
 
-    // Charger le cubemap
-    glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
-
-    for (int i = 0; i < 6; i++) {
-        int width, height, channels;
-        unsigned char* data = stbi_load(fullPaths[i].c_str(), &width, &height, &channels, 0);
-        
-        if (data) {
-            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, width, height, 0,
-                         format, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
-            std::cout << "Loaded cubemap face " << i << ": " << fullPaths[i] << std::endl;
-        } else {
-            std::cerr << "Failed to load cubemap texture: " << fullPaths[i] << std::endl;
-            return CreateProceduralCubeMap();
-        }
+    // Charger le cubemap : décodage en arrière-plan, faces noires en attendant
+    GLuint texture = TextureStreamer::Get().RequestCubeMap(fullPaths);
+    if (!texture) {
+        return CreateProceduralCubeMap();
     }
+    if (m_TextureID) {
+        TextureStreamer::Get().Cancel(m_TextureID);
+        GLStateCache::Get().DeleteTextures(1, &m_TextureID);
+    }
+    m_TextureID = texture;
 
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-
-    std::cout << "Skybox cubemap loaded successfully!" << std::endl;
+    std::cout << "Skybox cubemap queued for streaming" << std::endl;
     return true;
 }
 
@@ -192,6 +183,11 @@ bool Skybox::LoadCubeMap(std::string directory) {
         return CreateProceduralCubeMap(); // Fallback sur un cubemap procédural
     }
 
+    // Version compressée produite par "make textures", si disponible
+    if (LoadCompressedCubeMap(skyboxDir.string(), faceFiles)) {
+        return true;
+    }
+
     // Construire les chemins complets
     std::vector<std::string> fullPaths;
     for (const auto& filename : faceFiles) {
@@ -205,33 +201,54 @@ bool Skybox::LoadCubeMap(std::string directory) {
         }
     }
 
-    // Charger le cubemap
-    glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
+    // Charger le cubemap : décodage en arrière-plan, faces noires en attendant
+    GLuint texture = TextureStreamer::Get().RequestCubeMap(fullPaths);
+    if (!texture) {
+        return CreateProceduralCubeMap();
+    }
+    if (m_TextureID) {
+        TextureStreamer::Get().Cancel(m_TextureID);
+        GLStateCache::Get().DeleteTextures(1, &m_TextureID);
+    }
+    m_TextureID = texture;
 
-    for (int i = 0; i < 6; i++) {
-        int width, height, channels;
-        unsigned char* data = stbi_load(fullPaths[i].c_str(), &width, &height, &channels, 0);
-        
-        if (data) {
-            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, width, height, 0,
-                         format, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
-            std::cout << "Loaded cubemap face " << i << ": " << fullPaths[i] << std::endl;
-        } else {
-            std::cerr << "Failed to load cubemap texture: " << fullPaths[i] << std::endl;
-            return CreateProceduralCubeMap();
+    std::cout << "Skybox cubemap queued for streaming" << std::endl;
+    return true;
+}
+
+bool Skybox::LoadCompressedCubeMap(const std::string& directory, const std::vector<std::string>& faceFiles) {
+    std::filesystem::path compressed = std::filesystem::path(directory) / "skybox.ktx2";
+    std::error_code ec;
+    if (!std::filesystem::exists(compressed, ec)) {
+        return false;
+    }
+
+    // Ignoré si une des faces a été modifiée depuis la conversion (même règle que les textures 2D)
+    auto compressedTime = std::filesystem::last_write_time(compressed, ec);
+    if (ec) {
+        return false;
+    }
+    for (const auto& filename : faceFiles) {
+        auto faceTime = std::filesystem::last_write_time(std::filesystem::path(directory) / filename, ec);
+        if (!ec && compressedTime < faceTime) {
+            std::cout << "Stale compressed skybox ignored: " << compressed.string()
+                      << " (" << filename << " is newer)" << std::endl;
+            return false;
         }
     }
 
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    GLuint texture = TextureStreamer::Get().RequestCubeMapKTX2(compressed.string());
+    if (!texture) {
+        std::cerr << "Compressed skybox not supported, using PNG faces: " << compressed << std::endl;
+        return false;
+    }
+    if (m_TextureID) {
+        TextureStreamer::Get().Cancel(m_TextureID);
+        GLStateCache::Get().DeleteTextures(1, &m_TextureID);
+    }
+    m_TextureID = texture;
 
-    std::cout << "Skybox cubemap loaded successfully!" << std::endl;
+    std::cout << "Compressed skybox queued for streaming: " << compressed << std::endl;
     return true;
 }
 
@@ -239,7 +256,7 @@ bool Skybox::CreateProceduralCubeMap() {
     std::cout << "Creating procedural cubemap for skybox..." << std::endl;
     
     glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
+    GLStateCache::Get().BindTexture(0, GL_TEXTURE_CUBE_MAP, m_TextureID);
     
     // Couleurs pour chaque face du skybox
     unsigned char colors[6][3] = {
@@ -295,17 +312,17 @@ void Skybox::Draw(const Mat4& viewMatrix, const Mat4& projectionMatrix) {
     // Sauvegarder les états OpenGL
     GLboolean depthWriteEnabled;
     glGetBooleanv(GL_DEPTH_WRITEMASK, &depthWriteEnabled);
-    GLboolean cullFaceEnabled = glIsEnabled(GL_CULL_FACE);
+    GLStateCache& state = GLStateCache::Get();
+    bool cullFaceEnabled = state.IsEnabled(GL_CULL_FACE);
     GLenum depthFunc;
     glGetIntegerv(GL_DEPTH_FUNC, (GLint*)&depthFunc);
     
     // Configurer les états pour le skybox
     glDepthMask(GL_FALSE);
     glDepthFunc(GL_LEQUAL);  // Important pour que le skybox passe le test de profondeur
-    glDisable(GL_CULL_FACE);
+    state.Disable(GL_CULL_FACE);
     
-    GLuint program = m_Shader.GetProgram();
-    glUseProgram(program);
+    state.UseProgram(m_Shader.GetProgram());
 
     // Configurer les matrices - enlever la translation de la vue
     Mat4 skyboxView = viewMatrix;
@@ -314,35 +331,34 @@ void Skybox::Draw(const Mat4& viewMatrix, const Mat4& projectionMatrix) {
     viewData[13] = 0.0f; // ty
     viewData[14] = 0.0f; // tz
 
-    GLint loc_proj = glGetUniformLocation(program, "u_projection");
+    GLint loc_proj = m_Shader.GetLocation(Uniform::Projection);
     if (loc_proj >= 0) glUniformMatrix4fv(loc_proj, 1, GL_FALSE, projectionMatrix.data());
     
-    GLint loc_view = glGetUniformLocation(program, "u_view");
+    GLint loc_view = m_Shader.GetLocation(Uniform::View);
     if (loc_view >= 0) glUniformMatrix4fv(loc_view, 1, GL_FALSE, skyboxView.data());
 
     // Lier le cubemap
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
-    GLint loc_skybox = glGetUniformLocation(program, "u_skybox");
+    state.BindTexture(0, GL_TEXTURE_CUBE_MAP, m_TextureID);
+    GLint loc_skybox = m_Shader.GetLocation(Uniform::Skybox);
     if (loc_skybox >= 0) glUniform1i(loc_skybox, 0);
 
     // Rendu
-    glBindVertexArray(m_VAO);
+    state.BindVertexArray(m_VAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
 
-    // Restaurer les états OpenGL
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-    
+    // Restaurer les états OpenGL (les liaisons restent, suivies par le cache)
     if (depthWriteEnabled) glDepthMask(GL_TRUE);
     glDepthFunc(depthFunc);
-    if (cullFaceEnabled) glEnable(GL_CULL_FACE);
+    state.SetEnabled(GL_CULL_FACE, cullFaceEnabled);
 }
 
 void Skybox::Cleanup() {
-    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
-    if (m_VBO) glDeleteBuffers(1, &m_VBO);
-    if (m_TextureID) glDeleteTextures(1, &m_TextureID);
+    if (m_VAO) GLStateCache::Get().DeleteVertexArrays(1, &m_VAO);
+    if (m_VBO) GLStateCache::Get().DeleteBuffers(1, &m_VBO);
+    if (m_TextureID) {
+        TextureStreamer::Get().Cancel(m_TextureID);
+        GLStateCache::Get().DeleteTextures(1, &m_TextureID);
+    }
     m_Shader.Destroy();
     
     m_VAO = m_VBO = m_TextureID = 0;
@@ -0,0 +1,94 @@
+#include "../include/TextureCache.h"
+#include "../include/GLStateCache.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+// ==================== Texture ====================
+
+Texture::~Texture() {
+    if (id) {
+        TextureStreamer::Get().Cancel(id);
+        GLStateCache::Get().DeleteTextures(1, &id);
+    }
+}
+
+const std::string& TextureHandle::GetPath() const {
+    static const std::string empty;
+    return m_Texture ? m_Texture->path : empty;
+}
+
+// ==================== TextureCache ====================
+
+TextureCache::TextureCache() {
+    TextureStreamer::Get().SetUploadListener([this](GLuint texture, size_t residentBytes) {
+        OnUploaded(texture, residentBytes);
+    });
+}
+
+std::string TextureCache::MakeKey(const std::string& path, const TextureSettings& settings) {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), "|%s|%s|%x", settings.srgb ? "srgb" : "linear",
+             settings.mipmaps ? "mip" : "nomip", settings.wrap);
+    return (ec ? path : canonical.string()) + suffix;
+}
+
+TextureHandle TextureCache::Load2D(const std::string& path, const TextureSettings& settings) {
+    std::string key = MakeKey(path, settings);
+
+    auto it = m_Entries.find(key);
+    if (it != m_Entries.end()) {
+        if (std::shared_ptr<Texture> texture = it->second.lock()) {
+            m_Hits++;
+            return TextureHandle(texture);
+        }
+        m_Entries.erase(it);
+    }
+
+    GLuint id = TextureStreamer::Get().RequestTexture2D(path, settings);
+    if (!id) {
+        return TextureHandle();
+    }
+
+    auto texture = std::make_shared<Texture>();
+    texture->id = id;
+    texture->path = path;
+    texture->residentBytes = 4;  // placeholder 1x1 tant que l'image n'est pas arrivée
+
+    m_Misses++;
+    m_Entries[key] = texture;
+    m_ByID[id] = texture;
+    return TextureHandle(texture);
+}
+
+void TextureCache::OnUploaded(GLuint texture, size_t residentBytes) {
+    auto it = m_ByID.find(texture);
+    if (it == m_ByID.end()) {
+        return;
+    }
+    if (std::shared_ptr<Texture> entry = it->second.lock()) {
+        entry->residentBytes = residentBytes;
+    } else {
+        m_ByID.erase(it);
+    }
+}
+
+TextureCache::Stats TextureCache::GetStats() const {
+    Stats stats;
+    stats.hits = m_Hits;
+    stats.misses = m_Misses;
+    for (const auto& entry : m_Entries) {
+        if (auto texture = entry.second.lock()) {
+            stats.liveEntries++;
+            stats.residentBytes += texture->residentBytes;
+        }
+    }
+    return stats;
+}
+
+void TextureCache::ResetStats() {
+    m_Hits = m_Misses = 0;
+}
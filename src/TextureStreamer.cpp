@@ -0,0 +1,330 @@
+#include "../include/TextureStreamer.h"
+#include "../include/GLStateCache.h"
+#include "../include/ThreadPool.h"
+#include "../include/RenderStats.h"
+#include <stb/stb_image.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+void TextureStreamer::ImageDeleter::operator()(unsigned char* data) const {
+    stbi_image_free(data);
+}
+
+size_t TextureStreamer::DecodedImage::GetByteSize() const {
+    if (blocks) {
+        size_t total = 0;
+        for (size_t level = 0; level < blocks->levels.size(); ++level) {
+            total += blocks->GetFaceSize(level);
+        }
+        return total;
+    }
+    return static_cast<size_t>(width) * height * 4;
+}
+
+GLenum TextureStreamer::GetCompressedFormat(uint32_t format, bool srgb) {
+    const bool s3tc = GLEW_EXT_texture_compression_s3tc;
+    const bool bptc = GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+
+    // Les blocs sont identiques en sRGB et en linéaire : seule l'interprétation change
+    switch (format) {
+        case KTX2::BC1_RGB_UNORM: case KTX2::BC1_RGB_SRGB:
+            return !s3tc ? 0 : srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case KTX2::BC1_RGBA_UNORM: case KTX2::BC1_RGBA_SRGB:
+            return !s3tc ? 0 : srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case KTX2::BC3_UNORM: case KTX2::BC3_SRGB:
+            return !s3tc ? 0 : srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case KTX2::BC7_UNORM: case KTX2::BC7_SRGB:
+            return !bptc ? 0 : srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default:
+            return 0;
+    }
+}
+
+std::string TextureStreamer::FindCompressedVariant(const std::string& path) {
+    std::filesystem::path compressed = std::filesystem::path(path).replace_extension(".ktx2");
+    std::error_code ec;
+    if (!std::filesystem::exists(compressed, ec)) {
+        return std::string();
+    }
+
+    // Ignoré si l'image source a été modifiée depuis la conversion
+    auto sourceTime = std::filesystem::last_write_time(path, ec);
+    if (!ec && std::filesystem::last_write_time(compressed, ec) < sourceTime) {
+        std::cout << "Stale compressed texture ignored: " << compressed.string() << std::endl;
+        return std::string();
+    }
+
+    KTX2::Image header;
+    if (!KTX2::ReadHeader(compressed.string(), header) || header.faceCount != 1 ||
+        !GetCompressedFormat(header.format, true)) {
+        return std::string();
+    }
+    return compressed.string();
+}
+
+TextureStreamer& TextureStreamer::Get() {
+    static TextureStreamer instance;
+    return instance;
+}
+
+GLuint TextureStreamer::RequestTexture2D(const std::string& path, const TextureSettings& settings) {
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "Erreur de chargement de la texture: " << path << std::endl;
+        return 0;
+    }
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    GLStateCache::Get().BindTexture(0, GL_TEXTURE_2D, texture);
+
+    // Placeholder gris neutre en attendant le décodage (1x1 : chaîne de mipmaps complète)
+    const unsigned char placeholder[4] = { 128, 128, 128, 255 };
+    glTexImage2D(GL_TEXTURE_2D, 0, settings.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, settings.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, settings.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, settings.mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    std::string compressed = FindCompressedVariant(path);
+    Submit(texture, GL_TEXTURE_2D, settings, { compressed.empty() ? path : compressed });
+    return texture;
+}
+
+GLuint TextureStreamer::RequestCubeMap(const std::vector<std::string>& faces) {
+    if (faces.size() != 6) {
+        std::cerr << "CubeMap requires exactly 6 faces" << std::endl;
+        return 0;
+    }
+    for (const std::string& face : faces) {
+        if (!std::filesystem::exists(face)) {
+            std::cerr << "Missing cubemap face: " << face << std::endl;
+            return 0;
+        }
+    }
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    GLStateCache::Get().BindTexture(0, GL_TEXTURE_CUBE_MAP, texture);
+
+    // Placeholder noir, identique à la couleur de fond
+    const unsigned char placeholder[4] = { 0, 0, 0, 255 };
+    for (int i = 0; i < 6; i++) {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+    }
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    TextureSettings settings;
+    settings.srgb = false;
+    settings.mipmaps = false;
+    settings.wrap = GL_CLAMP_TO_EDGE;
+    Submit(texture, GL_TEXTURE_CUBE_MAP, settings, faces);
+    return texture;
+}
+
+GLuint TextureStreamer::RequestCubeMapKTX2(const std::string& path) {
+    KTX2::Image header;
+    if (!KTX2::ReadHeader(path, header) || header.faceCount != 6 || !GetCompressedFormat(header.format, false)) {
+        return 0;
+    }
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    GLStateCache::Get().BindTexture(0, GL_TEXTURE_CUBE_MAP, texture);
+
+    const unsigned char placeholder[4] = { 0, 0, 0, 255 };
+    for (int i = 0; i < 6; i++) {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+    }
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    TextureSettings settings;
+    settings.srgb = false;
+    settings.mipmaps = false;
+    settings.wrap = GL_CLAMP_TO_EDGE;
+    Submit(texture, GL_TEXTURE_CUBE_MAP, settings, { path });
+    return texture;
+}
+
+void TextureStreamer::Submit(GLuint texture, GLenum target, const TextureSettings& settings,
+                             const std::vector<std::string>& paths) {
+    Job job;
+    job.texture = texture;
+    job.target = target;
+    job.settings = settings;
+    job.paths = paths;
+    job.images = ThreadPool::Get().Submit([paths]() { return Decode(paths); });
+    m_Jobs.push_back(std::move(job));
+}
+
+std::vector<TextureStreamer::DecodedImage> TextureStreamer::Decode(const std::vector<std::string>& paths) {
+    // KTX2 : lecture des blocs, une DecodedImage par face
+    if (paths.size() == 1 && std::filesystem::path(paths[0]).extension() == ".ktx2") {
+        auto blocks = std::make_shared<KTX2::Image>();
+        std::string error;
+        if (!KTX2::Load(paths[0], *blocks, error)) {
+            std::cerr << "Erreur de chargement de la texture: " << error << std::endl;
+            return {};
+        }
+        std::vector<DecodedImage> faces(blocks->faceCount);
+        for (uint32_t face = 0; face < blocks->faceCount; ++face) {
+            faces[face].width = static_cast<int>(blocks->width);
+            faces[face].height = static_cast<int>(blocks->height);
+            faces[face].blocks = blocks;
+            faces[face].face = face;
+        }
+        return faces;
+    }
+
+    std::vector<DecodedImage> images(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        int channels = 0;
+        images[i].pixels.reset(stbi_load(paths[i].c_str(), &images[i].width, &images[i].height, &channels, 4));
+        if (!images[i].pixels) {
+            std::cerr << "Erreur de chargement de la texture: " << paths[i] << std::endl;
+            return {};
+        }
+    }
+    return images;
+}
+
+void TextureStreamer::Cancel(GLuint texture) {
+    // La tâche de décodage en cours se termine seule, son résultat est ignoré
+    for (auto it = m_Jobs.begin(); it != m_Jobs.end(); ++it) {
+        if (it->texture == texture) {
+            m_Jobs.erase(it);
+            return;
+        }
+    }
+}
+
+void TextureStreamer::Update() {
+    size_t uploaded = 0;
+    auto it = m_Jobs.begin();
+    while (it != m_Jobs.end()) {
+        // Au moins une texture par frame, même si elle dépasse le budget à elle seule
+        if (uploaded > 0 && uploaded >= m_UploadBudget) {
+            break;
+        }
+        if (it->images.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+
+        std::vector<DecodedImage> images = it->images.get();
+        if (!images.empty()) {
+            size_t residentBytes = Upload(*it, images);
+            for (const DecodedImage& image : images) {
+                uploaded += image.GetByteSize();
+            }
+            if (m_UploadListener) {
+                m_UploadListener(it->texture, residentBytes);
+            }
+        }
+        // Échec de décodage : le placeholder reste en place
+        it = m_Jobs.erase(it);
+    }
+
+    RenderStats::Get().textureUploadBytes += uploaded;
+}
+
+size_t TextureStreamer::Upload(Job& job, std::vector<DecodedImage>& images) {
+    size_t residentBytes = 0;
+    GLenum internalFormat = job.settings.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+
+    GLStateCache::Get().BindTexture(0, job.target, job.texture);
+    if (images[0].blocks) {
+        // Blocs compressés et mipmaps précalculés, envoyés tels quels
+        const KTX2::Image& blocks = *images[0].blocks;
+        GLenum compressedFormat = GetCompressedFormat(blocks.format, job.settings.srgb);
+        size_t levelCount = job.settings.mipmaps || job.target == GL_TEXTURE_CUBE_MAP ? blocks.levels.size() : 1;
+        for (const DecodedImage& image : images) {
+            GLenum target = job.target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + image.face : job.target;
+            for (size_t level = 0; level < levelCount; ++level) {
+                UploadLevel(target, static_cast<GLint>(level), compressedFormat,
+                            blocks.GetLevelWidth(level), blocks.GetLevelHeight(level),
+                            blocks.GetFaceData(level, image.face), blocks.GetFaceSize(level), true);
+                residentBytes += blocks.GetFaceSize(level);
+            }
+        }
+        glTexParameteri(job.target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount - 1));
+        if (levelCount == 1) {
+            glTexParameteri(job.target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        }
+    } else if (job.target == GL_TEXTURE_CUBE_MAP) {
+        for (const DecodedImage& image : images) {
+            GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(&image - &images[0]);
+            UploadLevel(target, 0, internalFormat, image.width, image.height,
+                        image.pixels.get(), image.GetByteSize(), false);
+            residentBytes += image.GetByteSize();
+        }
+    } else {
+        UploadLevel(GL_TEXTURE_2D, 0, internalFormat, images[0].width, images[0].height,
+                    images[0].pixels.get(), images[0].GetByteSize(), false);
+        residentBytes = images[0].GetByteSize();
+        if (job.settings.mipmaps) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+            residentBytes += residentBytes / 3;  // chaîne de mipmaps : ~1/3 en plus
+        }
+    }
+    RenderStats::Get().textureUploads++;
+    return residentBytes;
+}
+
+void TextureStreamer::UploadLevel(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                                  const unsigned char* data, size_t size, bool compressed) {
+    auto upload = [&](const void* pixels) {
+        if (compressed) {
+            glCompressedTexImage2D(target, level, internalFormat, width, height, 0, static_cast<GLsizei>(size), pixels);
+        } else {
+            glTexImage2D(target, level, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        }
+    };
+
+    const bool usePBO = GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object;
+    if (!usePBO) {
+        upload(data);
+        return;
+    }
+
+    // Copie dans un PBO réalloué (orphelin) à chaque envoi : l'envoi lit
+    // depuis le buffer et le transfert se fait sans bloquer sur le précédent
+    if (!m_PBO) {
+        glGenBuffers(1, &m_PBO);
+    }
+    // Délié après l'envoi : les autres glTexImage2D lisent la mémoire CPU
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBO);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        memcpy(mapped, data, size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        upload((void*)0);
+        state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        upload(data);
+    }
+}
+
+void TextureStreamer::Cleanup() {
+    // Les textures elles-mêmes appartiennent à leurs propriétaires
+    m_Jobs.clear();
+    if (m_PBO) {
+        GLStateCache::Get().DeleteBuffers(1, &m_PBO);
+        m_PBO = 0;
+    }
+}
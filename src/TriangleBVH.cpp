@@ -0,0 +1,337 @@
+#include "../include/TriangleBVH.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+    const int BIN_COUNT = 16;
+    const unsigned int MAX_LEAF_TRIANGLES = 4;
+    // Profondeur bornée par la pile de Raycast
+    const int MAX_DEPTH = 60;
+    const int STACK_SIZE = 64;
+
+    float BoxArea(const float* boxMin, const float* boxMax) {
+        float dx = boxMax[0] - boxMin[0];
+        float dy = boxMax[1] - boxMin[1];
+        float dz = boxMax[2] - boxMin[2];
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+}
+
+// Boîte des triangles et intervalle de leurs centroïdes
+struct TriangleBVH::Bin {
+    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    float centroidMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float centroidMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    unsigned int count = 0;
+
+    void Add(const TriangleBox& box) {
+        for (int axis = 0; axis < 3; ++axis) {
+            min[axis] = std::min(min[axis], box.min[axis]);
+            max[axis] = std::max(max[axis], box.max[axis]);
+            centroidMin[axis] = std::min(centroidMin[axis], box.centroid[axis]);
+            centroidMax[axis] = std::max(centroidMax[axis], box.centroid[axis]);
+        }
+        count++;
+    }
+    void Merge(const Bin& other) {
+        if (other.count == 0) {
+            return;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            min[axis] = std::min(min[axis], other.min[axis]);
+            max[axis] = std::max(max[axis], other.max[axis]);
+            centroidMin[axis] = std::min(centroidMin[axis], other.centroidMin[axis]);
+            centroidMax[axis] = std::max(centroidMax[axis], other.centroidMax[axis]);
+        }
+        count += other.count;
+    }
+    float Cost() const { return count ? count * BoxArea(min, max) : 0.0f; }
+};
+
+void TriangleBVH::Clear() {
+    m_Nodes.clear();
+    m_Triangles.clear();
+    m_Vertices = nullptr;
+    m_Indices = nullptr;
+}
+
+size_t TriangleBVH::GetByteSize() const {
+    return m_Nodes.size() * sizeof(Node) + m_Triangles.size() * sizeof(unsigned int);
+}
+
+void TriangleBVH::Build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    Clear();
+    unsigned int triangleCount = static_cast<unsigned int>(indices.size() / 3);
+    if (triangleCount == 0) {
+        return;
+    }
+    m_Vertices = vertices.data();
+    m_Indices = indices.data();
+
+    // Boîte et centroïde de chaque triangle, calculés une fois pour toute la construction.
+    // Réordonnées avec m_Triangles : chaque nœud lit une plage contiguë
+    std::vector<TriangleBox> boxes(triangleCount);
+    for (unsigned int t = 0; t < triangleCount; ++t) {
+        const float* a = vertices[indices[t * 3 + 0]].position;
+        const float* b = vertices[indices[t * 3 + 1]].position;
+        const float* c = vertices[indices[t * 3 + 2]].position;
+        TriangleBox& box = boxes[t];
+        for (int axis = 0; axis < 3; ++axis) {
+            box.min[axis] = std::min(a[axis], std::min(b[axis], c[axis]));
+            box.max[axis] = std::max(a[axis], std::max(b[axis], c[axis]));
+            box.centroid[axis] = (a[axis] + b[axis] + c[axis]) * (1.0f / 3.0f);
+        }
+    }
+
+    m_Triangles.resize(triangleCount);
+    for (unsigned int t = 0; t < triangleCount; ++t) {
+        m_Triangles[t] = t;
+    }
+
+    // Au plus 2n - 1 nœuds : pas de réallocation pendant la découpe
+    m_Nodes.reserve(triangleCount * 2);
+    m_Nodes.emplace_back();
+    m_Nodes[0].leftFirst = 0;
+    m_Nodes[0].count = triangleCount;
+    Subdivide(boxes);
+    m_Nodes.shrink_to_fit();
+}
+
+void TriangleBVH::Subdivide(std::vector<TriangleBox>& boxes) {
+    struct Pending {
+        unsigned int node;
+        int depth;
+        float centroidMin[3];
+        float centroidMax[3];
+    };
+
+    // Racine : boîte des triangles et intervalle des centroïdes en un passage.
+    // Ceux des enfants sont ensuite déduits des intervalles de découpe.
+    Pending root = { 0, 0, { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+    Bin rootBounds;
+    for (const TriangleBox& box : boxes) {
+        rootBounds.Add(box);
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        m_Nodes[0].min[axis] = rootBounds.min[axis];
+        m_Nodes[0].max[axis] = rootBounds.max[axis];
+        root.centroidMin[axis] = rootBounds.centroidMin[axis];
+        root.centroidMax[axis] = rootBounds.centroidMax[axis];
+    }
+
+    // Pile explicite : un modèle de plusieurs millions de triangles ne doit pas
+    // dépendre de la taille de la pile d'appel
+    std::vector<Pending> pending;
+    pending.push_back(root);
+    while (!pending.empty()) {
+        Pending current = pending.back();
+        pending.pop_back();
+
+        Node& node = m_Nodes[current.node];
+        if (node.count <= MAX_LEAF_TRIANGLES || current.depth >= MAX_DEPTH) {
+            continue;
+        }
+
+        // Découpe le long du plus grand étalement des centroïdes (la boîte des
+        // triangles peut être bien plus grande) : un seul axe à remplir
+        int axis = 0;
+        for (int other = 1; other < 3; ++other) {
+            if (current.centroidMax[other] - current.centroidMin[other] >
+                current.centroidMax[axis] - current.centroidMin[axis]) {
+                axis = other;
+            }
+        }
+        float extent = current.centroidMax[axis] - current.centroidMin[axis];
+        if (extent <= 0.0f) {
+            continue;   // centroïdes confondus : rien à séparer
+        }
+        float origin = current.centroidMin[axis];
+        float scale = BIN_COUNT / extent;
+        auto binOf = [&](const TriangleBox& box) {
+            return std::min(BIN_COUNT - 1, static_cast<int>((box.centroid[axis] - origin) * scale));
+        };
+
+        Bin bins[BIN_COUNT];
+        for (unsigned int i = 0; i < node.count; ++i) {
+            const TriangleBox& box = boxes[node.leftFirst + i];
+            bins[binOf(box)].Add(box);
+        }
+
+        // Meilleure frontière : somme des (aire x triangles) de chaque côté, balayage gauche puis droite
+        Bin leftSides[BIN_COUNT - 1];
+        Bin left;
+        for (int b = 0; b < BIN_COUNT - 1; ++b) {
+            left.Merge(bins[b]);
+            leftSides[b] = left;
+        }
+        float bestCost = FLT_MAX;
+        int bestSplit = 0;
+        Bin right, bestRight;
+        for (int b = BIN_COUNT - 1; b > 0; --b) {
+            right.Merge(bins[b]);
+            float cost = leftSides[b - 1].Cost() + right.Cost();
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+                bestRight = right;
+            }
+        }
+
+        // Un nœud interne coûte environ un test de triangle de plus
+        float nodeArea = BoxArea(node.min, node.max);
+        if (bestCost + nodeArea >= node.count * nodeArea) {
+            continue;
+        }
+
+        // Partition en place des triangles du nœud (même calcul d'intervalle que plus haut)
+        unsigned int i = node.leftFirst;
+        unsigned int j = node.leftFirst + node.count;
+        while (i < j) {
+            if (binOf(boxes[i]) < bestSplit) {
+                i++;
+            } else {
+                --j;
+                std::swap(m_Triangles[i], m_Triangles[j]);
+                std::swap(boxes[i], boxes[j]);
+            }
+        }
+        unsigned int leftCount = i - node.leftFirst;
+        if (leftCount == 0 || leftCount == node.count) {
+            continue;
+        }
+
+        unsigned int leftIndex = static_cast<unsigned int>(m_Nodes.size());
+        m_Nodes.emplace_back();
+        m_Nodes.emplace_back();
+        Node& parent = m_Nodes[current.node];
+        const Bin* sides[2] = { &leftSides[bestSplit - 1], &bestRight };
+        for (unsigned int side = 0; side < 2; ++side) {
+            Node& child = m_Nodes[leftIndex + side];
+            child.leftFirst = side == 0 ? parent.leftFirst : i;
+            child.count = side == 0 ? leftCount : parent.count - leftCount;
+            Pending next = { leftIndex + side, current.depth + 1, {}, {} };
+            for (int a = 0; a < 3; ++a) {
+                child.min[a] = sides[side]->min[a];
+                child.max[a] = sides[side]->max[a];
+                next.centroidMin[a] = sides[side]->centroidMin[a];
+                next.centroidMax[a] = sides[side]->centroidMax[a];
+            }
+            pending.push_back(next);
+        }
+        parent.leftFirst = leftIndex;
+        parent.count = 0;
+    }
+}
+
+bool TriangleBVH::IntersectTriangle(unsigned int triangle, const float* origin, const float* direction, float& distance) const {
+    // Möller-Trumbore, sans élimination des faces arrière
+    const float* a = m_Vertices[m_Indices[triangle * 3 + 0]].position;
+    const float* b = m_Vertices[m_Indices[triangle * 3 + 1]].position;
+    const float* c = m_Vertices[m_Indices[triangle * 3 + 2]].position;
+    float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    float p[3] = {
+        direction[1] * e2[2] - direction[2] * e2[1],
+        direction[2] * e2[0] - direction[0] * e2[2],
+        direction[0] * e2[1] - direction[1] * e2[0]
+    };
+    float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    if (std::fabs(det) < 1e-12f) {
+        return false;
+    }
+    float invDet = 1.0f / det;
+    float s[3] = { origin[0] - a[0], origin[1] - a[1], origin[2] - a[2] };
+    float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    float q[3] = {
+        s[1] * e1[2] - s[2] * e1[1],
+        s[2] * e1[0] - s[0] * e1[2],
+        s[0] * e1[1] - s[1] * e1[0]
+    };
+    float v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    float t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+    if (t < 0.0f || t >= distance) {
+        return false;
+    }
+    distance = t;
+    return true;
+}
+
+bool TriangleBVH::Raycast(const float* origin, const float* direction, float& distance) const {
+    if (m_Nodes.empty()) {
+        return false;
+    }
+
+    float inverse[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        inverse[axis] = 1.0f / direction[axis];
+    }
+    // Distance d'entrée dans la boîte, FLT_MAX si manquée ou plus loin que l'impact courant
+    auto entry = [&](const Node& node) {
+        float tMin = 0.0f;
+        float tMax = distance;
+        for (int axis = 0; axis < 3; ++axis) {
+            float t1 = (node.min[axis] - origin[axis]) * inverse[axis];
+            float t2 = (node.max[axis] - origin[axis]) * inverse[axis];
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+        }
+        return tMin <= tMax ? tMin : FLT_MAX;
+    };
+
+    if (entry(m_Nodes[0]) == FLT_MAX) {
+        return false;
+    }
+
+    bool hit = false;
+    unsigned int stack[STACK_SIZE];
+    int stackSize = 0;
+    unsigned int nodeIndex = 0;
+    while (true) {
+        const Node& node = m_Nodes[nodeIndex];
+        if (node.count > 0) {
+            for (unsigned int i = 0; i < node.count; ++i) {
+                hit |= IntersectTriangle(m_Triangles[node.leftFirst + i], origin, direction, distance);
+            }
+        } else {
+            // Enfant le plus proche d'abord : l'autre est souvent éliminé par l'impact trouvé
+            unsigned int nearIndex = node.leftFirst;
+            unsigned int farIndex = node.leftFirst + 1;
+            float nearT = entry(m_Nodes[nearIndex]);
+            float farT = entry(m_Nodes[farIndex]);
+            if (farT < nearT) {
+                std::swap(nearIndex, farIndex);
+                std::swap(nearT, farT);
+            }
+            if (nearT != FLT_MAX) {
+                if (farT != FLT_MAX) {
+                    stack[stackSize++] = farIndex;
+                }
+                nodeIndex = nearIndex;
+                continue;
+            }
+        }
+
+        // Nœud suivant de la pile, sauf s'il est déjà derrière l'impact
+        bool found = false;
+        while (stackSize > 0) {
+            nodeIndex = stack[--stackSize];
+            if (entry(m_Nodes[nodeIndex]) != FLT_MAX) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            break;
+        }
+    }
+    return hit;
+}
@@ -1,4 +1,7 @@
 #include "../include/UBOManager.h"
+#include "../include/GLStateCache.h"
+#include "../include/RenderStats.h"
+#include <cstring>
 #include <iostream>
 
 UBOManager& UBOManager::Get() {
@@ -7,36 +10,131 @@ UBOManager& UBOManager::Get() {
 }
 
 void UBOManager::Initialize() {
+    GLStateCache& state = GLStateCache::Get();
+
     // Création de l'UBO pour projection + view
     glGenBuffers(1, &m_projViewUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, m_projViewUBO);
+    state.BindBuffer(GL_UNIFORM_BUFFER, m_projViewUBO);
     glBufferData(GL_UNIFORM_BUFFER, PROJ_VIEW_SIZE, nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, PROJECTION_VIEW_BINDING, m_projViewUBO);
+    state.BindBufferBase(GL_UNIFORM_BUFFER, PROJECTION_VIEW_BINDING, m_projViewUBO);
     
-    // Création de l'UBO pour transform
+    // Création de l'UBO pour transform (chemin historique et débordement du ring)
     glGenBuffers(1, &m_transformUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, m_transformUBO);
+    state.BindBuffer(GL_UNIFORM_BUFFER, m_transformUBO);
     glBufferData(GL_UNIFORM_BUFFER, MATRIX_SIZE, nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, TRANSFORM_BINDING, m_transformUBO);
-    
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    state.BindBufferBase(GL_UNIFORM_BUFFER, TRANSFORM_BINDING, m_transformUBO);
+
+    // Chaque slot doit commencer sur GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT (souvent 256)
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment <= 0) alignment = 256;
+    m_slotSize = ((MATRIX_SIZE + alignment - 1) / alignment) * alignment;
+    m_frameSize = m_slotSize * MAX_TRANSFORMS_PER_FRAME;
+
+    glGenBuffers(1, &m_ringUBO);
+    state.BindBuffer(GL_UNIFORM_BUFFER, m_ringUBO);
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+        // Buffer persistant et cohérent : on écrit directement dans la mémoire mappée
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr size = (GLsizeiptr)(m_frameSize * RING_FRAMES);
+        glBufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+        m_mappedRing = (unsigned char*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags);
+    }
+    if (!m_mappedRing) {
+        // Repli : une seule région, orphelinée à chaque début de frame
+        glBufferData(GL_UNIFORM_BUFFER, m_frameSize, nullptr, GL_STREAM_DRAW);
+    }
+    std::cout << "Transform ring buffer: " << MAX_TRANSFORMS_PER_FRAME << " slots of "
+              << m_slotSize << " bytes, " << (m_mappedRing ? "persistent mapping" : "orphaning") << std::endl;
 }
 
 void UBOManager::Cleanup() {
-    if (m_projViewUBO) glDeleteBuffers(1, &m_projViewUBO);
-    if (m_transformUBO) glDeleteBuffers(1, &m_transformUBO);
-    m_projViewUBO = m_transformUBO = 0;
+    for (GLsync& fence : m_fences) {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    GLStateCache& state = GLStateCache::Get();
+    if (m_mappedRing) {
+        state.BindBuffer(GL_UNIFORM_BUFFER, m_ringUBO);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        m_mappedRing = nullptr;
+    }
+    if (m_ringUBO) state.DeleteBuffers(1, &m_ringUBO);
+    if (m_projViewUBO) state.DeleteBuffers(1, &m_projViewUBO);
+    if (m_transformUBO) state.DeleteBuffers(1, &m_transformUBO);
+    m_projViewUBO = m_transformUBO = m_ringUBO = 0;
+}
+
+void UBOManager::BeginFrame() {
+    m_slotCursor = 0;
+    m_inFrame = IsRingBufferEnabled();
+    if (!m_inFrame) return;
+
+    if (m_mappedRing) {
+        // Attendre que le GPU ait fini de lire cette région (frame N - RING_FRAMES)
+        GLsync& fence = m_fences[m_frameIndex];
+        if (fence) {
+            GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            while (result == GL_TIMEOUT_EXPIRED) {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        m_frameOffset = m_frameSize * m_frameIndex;
+    } else {
+        GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_ringUBO);
+        glBufferData(GL_UNIFORM_BUFFER, m_frameSize, nullptr, GL_STREAM_DRAW);
+        m_frameOffset = 0;
+    }
+}
+
+void UBOManager::EndFrame() {
+    if (!m_inFrame) return;
+    m_inFrame = false;
+
+    if (m_mappedRing) {
+        m_fences[m_frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_frameIndex = (m_frameIndex + 1) % RING_FRAMES;
+    }
+    // Les draws suivants (UI...) repassent par l'UBO historique
+    GLStateCache::Get().BindBufferBase(GL_UNIFORM_BUFFER, TRANSFORM_BINDING, m_transformUBO);
 }
 
 void UBOManager::UpdateProjectionView(const float* projection, const float* view) {
-    glBindBuffer(GL_UNIFORM_BUFFER, m_projViewUBO);
+    GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_projViewUBO);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, MATRIX_SIZE, projection);
     glBufferSubData(GL_UNIFORM_BUFFER, MATRIX_SIZE, MATRIX_SIZE, view);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
 void UBOManager::UpdateTransform(const float* transform) {
-    glBindBuffer(GL_UNIFORM_BUFFER, m_transformUBO);
+    RenderStats::Get().transformUploads++;
+
+    if (!m_inFrame || m_slotCursor >= MAX_TRANSFORMS_PER_FRAME) {
+        // Hors frame ou ring plein : chemin synchrone, toujours correct
+        UpdateTransformLegacy(transform);
+        return;
+    }
+
+    size_t offset = m_frameOffset + m_slotCursor * m_slotSize;
+    m_slotCursor++;
+
+    GLStateCache& state = GLStateCache::Get();
+    if (m_mappedRing) {
+        memcpy(m_mappedRing + offset, transform, MATRIX_SIZE);
+        state.BindBufferRange(GL_UNIFORM_BUFFER, TRANSFORM_BINDING, m_ringUBO, offset, MATRIX_SIZE);
+    } else {
+        // La région vient d'être orphelinée : pas d'attente sur les draws précédents
+        state.BindBufferRange(GL_UNIFORM_BUFFER, TRANSFORM_BINDING, m_ringUBO, offset, MATRIX_SIZE);
+        state.BindBuffer(GL_UNIFORM_BUFFER, m_ringUBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, MATRIX_SIZE, transform);
+    }
+}
+
+void UBOManager::UpdateTransformLegacy(const float* transform) {
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBufferBase(GL_UNIFORM_BUFFER, TRANSFORM_BINDING, m_transformUBO);
+    // La liaison indexée peut avoir été évitée : la cible générique est liée à part
+    state.BindBuffer(GL_UNIFORM_BUFFER, m_transformUBO);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, MATRIX_SIZE, transform);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
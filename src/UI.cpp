@@ -1,9 +1,19 @@
 #include "../include/UI.h"
+#include "../include/GLStateCache.h"
 #include "../imgui/imgui.h"
 #include "../imgui/imgui_impl_glfw.h"
 #include "../imgui/imgui_impl_opengl3.h"
 #include "../include/SceneManager.h"
 #include "../include/Skybox.h"  // Added Skybox include
+#include "../include/RenderStats.h"
+#include "../include/GeometryCache.h"
+#include "../include/MeshImportQueue.h"
+#include "../include/TextureStreamer.h"
+#include "../include/ResourceManager.h"
+#include "../include/ProgramRegistry.h"
+#include "../include/LightManager.h"
+#include "../include/LodSelector.h"
+#include "../include/IndirectRenderer.h"
 #include <windows.h>
 #include <commdlg.h>
 #include <shlobj.h>      // For shell browsing functions
@@ -90,6 +100,8 @@ void UI::RenderUI(float fps, const float* cameraPos, const float* cameraDir) {
 
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    // Le backend ImGui lie ses propres programme, VAO et texture
+    GLStateCache::Get().Invalidate();
 }
 
 void UI::ShowMainWindow(float fps, const float* cameraPos, const float* cameraDir) {
@@ -104,6 +116,61 @@ void UI::ShowMainWindow(float fps, const float* cameraPos, const float* cameraDi
             }
         }
         ImGui::Text("FPS: %.1f", fps);
+        const RenderStats& stats = RenderStats::Get();
+        ImGui::Text("Frustum culling: %d visible, %d culled", stats.visibleObjects, stats.culledObjects);
+        ImGui::Text("Draws: %d, program switches: %d, texture binds: %d",
+            stats.draws, stats.programSwitches, stats.textureBinds);
+        ImGui::Text("GL state calls: %d issued, %d skipped", stats.stateCallsIssued, stats.stateCallsSkipped);
+        ImGui::Text("Instanced: %d draw calls, %d instances", stats.instancedDrawCalls, stats.instances);
+        if (IndirectRenderer::IsSupported()) {
+            bool indirect = IndirectRenderer::IsEnabled();
+            if (ImGui::Checkbox("Multi-draw indirect", &indirect)) {
+                IndirectRenderer::SetEnabled(indirect);
+            }
+            ImGui::SameLine();
+            ImGui::Text("%d call(s), %d draws", stats.indirectDrawCalls, stats.indirectDraws);
+        }
+        bool asteroids = SolarSystemScene::IsAsteroidBeltEnabled();
+        if (ImGui::Checkbox("Asteroid belt (instanced)", &asteroids)) {
+            SolarSystemScene::SetAsteroidBeltEnabled(asteroids);
+        }
+        ImGui::Checkbox("Level of detail", &LodSelector::Get().enabled);
+        ImGui::SameLine();
+        ImGui::Text("Triangles submitted: %d", stats.triangles);
+        ImGui::Text("Uniform driver lookups: %d", stats.uniformDriverLookups);
+        ImGui::Text("Material buffer uploads: %d", stats.materialUploads);
+        ImGui::Text("Clustered lights: %d lights, %d cluster entries, max %u per cluster",
+            stats.lights, stats.lightIndices, LightManager::Get().GetMaxLightsPerCluster());
+        GeometryCache::Stats geomStats = GeometryCache::Get().GetStats();
+        ImGui::Text("Geometry cache: %zu hits, %zu misses, %.1f KB saved",
+            geomStats.hits, geomStats.misses, geomStats.bytesSaved / 1024.0f);
+        GeometryArena::Stats arenaStats = GeometryArena::Get().GetStats();
+        ImGui::Text("Geometry arena: %zu live / %zu allocations, %zu frees, %.1f / %.1f MB",
+            arenaStats.liveAllocations, arenaStats.totalAllocations, arenaStats.frees,
+            arenaStats.bytesUsed / (1024.0f * 1024.0f), arenaStats.bytesReserved / (1024.0f * 1024.0f));
+        ImGui::Text("  %zu holes (%.1f KB), %.0f%% fragmented, %zu defragmentations",
+            arenaStats.holeCount, arenaStats.holeBytes / 1024.0f, arenaStats.fragmentation * 100.0f,
+            arenaStats.defragmentations);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Defragment")) {
+            GeometryArena::Get().Defragment();
+        }
+        TextureCache::Stats texStats = ResourceManager::Get().GetTextures().GetStats();
+        ImGui::Text("Texture cache: %zu textures, %.1f MB resident, %.0f%% hit rate",
+            texStats.liveEntries, texStats.residentBytes / (1024.0f * 1024.0f), texStats.GetHitRate() * 100.0f);
+        ProgramRegistry::Stats progStats = ProgramRegistry::Get().GetStats();
+        ImGui::Text("Shader programs: %zu live, %zu compiled, %zu from binary cache, %zu shared, %zu pending (%.1f ms blocked)",
+            progStats.livePrograms, progStats.compiled, progStats.binaryHits, progStats.shared, progStats.pending, progStats.blockingMs);
+        ImGui::Text("Texture streaming: %zu pending, %d uploaded (%.1f KB) this frame",
+            TextureStreamer::Get().GetPendingCount(), stats.textureUploads, stats.textureUploadBytes / 1024.0f);
+        const MeshImportQueue& imports = MeshImportQueue::Get();
+        if (imports.GetPendingCount() > 0) {
+            ImGui::Text("Importing %zu model(s)...", imports.GetPendingCount());
+        }
+        if (!imports.GetLastImportName().empty()) {
+            ImGui::Text("Last import: %s, %.1f MB/s", imports.GetLastImportName().c_str(), imports.GetLastThroughputMBs());
+        }
+        ShowSelection();
         ShowObjectControls();
         ShowShaderSettings();
         ShowSceneControls();
@@ -319,7 +386,7 @@ void UI::ShowShaderSettings() {
                     }
                     
                     // Option pour afficher la texture de l'objet dans le shader EnvMap
-                    bool hasTexture = (mat.diffuseMap != 0);
+                    bool hasTexture = (mat.diffuseMap.GetID() != 0);
                     
                     if (ImGui::SliderFloat("Reflection Strength", &mat.specularStrength, 0.0f, 2.0f)) {
                         materialChanged = true;
@@ -399,7 +466,7 @@ void UI::ShowShaderSettings() {
                     if (ImGui::ColorEdit3("Diffuse Color", mat.diffuse)) materialChanged = true;
                     
                     // Option pour afficher la texture de l'objet dans le shader Basic
-                    bool hasTexture = (mat.diffuseMap != 0);
+                    bool hasTexture = (mat.diffuseMap.GetID() != 0);
                     if (hasTexture) {
                         if (ImGui::Checkbox("Use Object Texture", &mat.useTextureInBasicShader)) {
                             materialChanged = true;
@@ -450,11 +517,15 @@ void UI::ShowShaderSettings() {
 }
 
 void UI::SetSceneObjects(const std::vector<Mesh*>& objects, Mesh* sun, const std::vector<Planet>& planets) {
+    // Appelée à chaque frame : la sélection ne se perd qu'au changement de scène
+    if (m_SceneObjects != &objects) {
+        m_SelectedObject = -1;
+    }
+
     // Reset les pointeurs avant d'assigner les nouveaux
     m_SceneObjects = nullptr;
     m_Sun = nullptr;
     m_Planets = nullptr;
-    m_SelectedObject = -1;
 
     // Assigner les nouveaux pointeurs
     m_SceneObjects = const_cast<std::vector<Mesh*>*>(&objects);
@@ -462,6 +533,49 @@ void UI::SetSceneObjects(const std::vector<Mesh*>& objects, Mesh* sun, const std
     m_Planets = const_cast<std::vector<Planet>*>(&planets);
 }
 
+void UI::SelectObject(Mesh* object, double pickMs) {
+    m_LastPickMs = pickMs;
+    m_SelectedObject = -1;
+    if (!m_SceneObjects || !object) {
+        return;
+    }
+    auto it = std::find(m_SceneObjects->begin(), m_SceneObjects->end(), object);
+    if (it != m_SceneObjects->end()) {
+        m_SelectedObject = static_cast<int>(it - m_SceneObjects->begin());
+    }
+}
+
+void UI::ShowSelection() {
+    if (!m_SceneObjects) return;
+
+    // Un objet supprimé depuis la sélection la rend caduque
+    if (m_SelectedObject >= static_cast<int>(m_SceneObjects->size())) {
+        m_SelectedObject = -1;
+    }
+
+    if (ImGui::CollapsingHeader("Selection", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Click in the view (cursor released) to select, last pick %.3f ms", m_LastPickMs);
+        if (m_SelectedObject < 0) {
+            ImGui::Text("No object selected");
+            return;
+        }
+
+        Mesh* obj = (*m_SceneObjects)[m_SelectedObject];
+        ImGui::Text("Object %d", m_SelectedObject);
+        float pos[3] = {obj->getPosition()[0], obj->getPosition()[1], obj->getPosition()[2]};
+        float scale[3] = {obj->getScale()[0], obj->getScale()[1], obj->getScale()[2]};
+        if (ImGui::DragFloat3("Position##selection", pos, 0.1f)) {
+            obj->setPosition(pos[0], pos[1], pos[2]);
+        }
+        if (ImGui::DragFloat3("Scale##selection", scale, 0.1f, 0.1f, 100.0f)) {
+            obj->setScale(scale[0], scale[1], scale[2]);
+        }
+        if (ImGui::Button("Deselect")) {
+            m_SelectedObject = -1;
+        }
+    }
+}
+
 void UI::SetShaders(GLShader* basic, GLShader* color, GLShader* envmap) {
     m_BasicShader = basic;
     m_ColorShader = color;
@@ -784,17 +898,25 @@ void UI::ShowLoadModelDialog() {
             Scene* currentScene = sceneManager.GetActiveScene();
             
             if (currentScene) {
-                Mesh* newMesh = new Mesh();
-                if (newMesh->loadFromOBJFile(filepath)) {
-                    newMesh->setPosition(0.0f, 0.0f, -5.0f);
-                    newMesh->setScale(1.0f, 1.0f, 1.0f);
-                    newMesh->setCurrentShader(&(currentScene->GetBasicShader()));
-                    currentScene->AddObject(newMesh);
-                    m_ShowLoadModelDialog = false;
-                    memset(filepath, 0, sizeof(filepath));
-                } else {
-                    delete newMesh;
-                }
+                // Import en arrière-plan : le mesh est ajouté à la scène d'origine
+                // quand la géométrie est prête, la boucle de rendu continue entre-temps
+                std::string sceneName = currentScene->GetName();
+                std::string path = filepath;
+                MeshImportQueue::Get().Request(path, ObjImportOptions(),
+                    [sceneName, path](const std::shared_ptr<MeshGeometry>& geometry) {
+                        Scene* scene = SceneManager::GetInstance().GetScene(sceneName);
+                        if (!geometry || !scene) {
+                            return;
+                        }
+                        Mesh* newMesh = new Mesh();
+                        newMesh->applyOBJGeometry(geometry);
+                        newMesh->setPosition(0.0f, 0.0f, -5.0f);
+                        newMesh->setScale(1.0f, 1.0f, 1.0f);
+                        newMesh->setCurrentShader(&(scene->GetBasicShader()));
+                        scene->AddObject(newMesh);
+                    });
+                m_ShowLoadModelDialog = false;
+                memset(filepath, 0, sizeof(filepath));
             }
         }
 
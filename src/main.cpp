@@ -5,9 +5,14 @@
 #include <GLFW/glfw3.h>
 
 #include <iostream>
+#include <fstream>
 #include <memory>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
 
 #include "../include/GLShader.h"
+#include "../include/GLStateCache.h"
 #include "../include/Mesh.h"
 #include "../include/Mat4.h"
 #include "../include/UI.h"
@@ -17,6 +22,17 @@
 #include "../include/ResourceManager.h"
 #include "../include/SceneManager.h"
 #include "../include/UBOManager.h"
+#include "../include/RenderStats.h"
+#include "../include/MeshImportQueue.h"
+#include "../include/TextureStreamer.h"
+#include "../include/ProgramRegistry.h"
+#include "../include/ShaderWatcher.h"
+#include "../include/MaterialBuffer.h"
+#include "../include/LightManager.h"
+#include "../include/LodSelector.h"
+#include "../include/IndirectRenderer.h"
+#include "../include/GeometryArena.h"
+#include "../imgui/imgui.h"
 
 // Variables globales principales
 std::unique_ptr<UI> g_UI;
@@ -74,16 +90,45 @@ void processInput(GLFWwindow* window) {
     }
 }
 
+// Clic gauche dans la vue (curseur libéré, hors des fenêtres ImGui) : sélection de l'objet visé
+void handlePicking(const Mat4& projection, const Mat4& view) {
+    static bool wasPressed = false;
+    bool pressed = glfwGetMouseButton(g_Window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+    bool clicked = pressed && !wasPressed;
+    wasPressed = pressed;
+    if (!clicked || !g_Camera || g_Camera->IsCursorLocked() || ImGui::GetIO().WantCaptureMouse) {
+        return;
+    }
+
+    Scene* scene = g_SceneManager ? g_SceneManager->GetActiveScene() : nullptr;
+    if (!scene || !g_UI) {
+        return;
+    }
+
+    float origin[3], direction[3];
+    g_Camera->GetCursorRay(projection, view, origin, direction);
+    double start = glfwGetTime();
+    Mesh* picked = scene->Pick(origin, direction, CAM_FAR);
+    g_UI->SelectObject(picked, (glfwGetTime() - start) * 1000.0);
+}
+
 void Render() {
     // Calcul du FPS et temps écoulé
     float current_time = glfwGetTime();
     elapsed_time = current_time - last_frame_time;
     last_frame_time = current_time;
     fps = 1.0f / elapsed_time;
+    RenderStats::Get().Reset();
+
+    // Envoi au GPU des modèles et textures décodés en arrière-plan
+    MeshImportQueue::Get().ProcessCompleted();
+    TextureStreamer::Get().Update();
+    ProgramRegistry::Get().Poll();
+    ShaderWatcher::Get().Update();
 
     // Configuration OpenGL
     glViewport(0, 0, width, height);
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);  // Couleur de fond temporaire pour debug
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -105,6 +150,7 @@ void Render() {
     }
     
     // Mettre à jour les UBOs avec les nouvelles matrices
+    UBOManager::Get().BeginFrame();
     UBOManager::Get().UpdateProjectionView(projectionMatrix.data(), viewMatrix.data());
 
     // Rendu de la skybox en premier (avec états spéciaux)
@@ -115,8 +161,11 @@ void Render() {
     // Rendu du reste de la scène
     if (g_SceneManager) {
         g_SceneManager->Update(elapsed_time);
-        g_SceneManager->Render(projectionMatrix, viewMatrix);
+        handlePicking(projectionMatrix, viewMatrix);
+        // Frustum de la caméra : les objets hors champ ne génèrent aucun appel GL
+        g_SceneManager->Render(projectionMatrix, viewMatrix, Frustum(projectionMatrix * viewMatrix));
     }
+    UBOManager::Get().EndFrame();
 
     // Interface utilisateur
     Scene* activeScene = g_SceneManager ? g_SceneManager->GetActiveScene() : nullptr;
@@ -130,9 +179,10 @@ void Render() {
     }
 }
 
-bool initializeOpenGL() {
+bool initializeOpenGL(bool visible = true) {
     // Configuration de la fenêtre GLFW
     glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
     
     g_Window = glfwCreateWindow(width, height, "OpenGL Scene Manager", nullptr, nullptr);
     if (!g_Window) {
@@ -153,6 +203,8 @@ bool initializeOpenGL() {
         std::cerr << "Erreur : Impossible d'initialiser GLEW" << std::endl;
         return false;
     }
+    // Nouveau contexte : rien de ce que le cache croyait lié n'existe
+    GLStateCache::Get().Invalidate();
 
     return true;
 }
@@ -242,8 +294,8 @@ bool Initialize() {
     }
 
     // Configuration OpenGL globale
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().Enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Initialiser l'UBO Manager immédiatement après OpenGL
@@ -257,6 +309,9 @@ bool Initialize() {
         return false;
     }
 
+    // Les shaders modifiés sur disque sont recompilés sans redémarrer
+    ShaderWatcher::Get().Start();
+
     // Affichage des contrôles
     std::cout << "=== Scene Manager Initialized ===" << std::endl;
     std::cout << "Controls:" << std::endl;
@@ -270,6 +325,8 @@ bool Initialize() {
 }
 
 void Cleanup() {
+    ShaderWatcher::Get().Stop();
+    MeshImportQueue::Get().Shutdown();
     if (g_SceneManager) {
         g_SceneManager->Cleanup();
         g_SceneManager = nullptr;
@@ -278,15 +335,309 @@ void Cleanup() {
     g_UI.reset();
     g_Skybox.reset();
     g_Camera.reset();
+    MaterialBuffer::Get().Cleanup();
+    GeometryArena::Get().Cleanup();
+    LightManager::Get().Cleanup();
     UBOManager::Get().Cleanup();
+    TextureStreamer::Get().Cleanup();
+}
+
+// Temps CPU moyen d'une frame de la scène de benchmark, en millisecondes
+static double measureBenchmarkFrames(BenchmarkScene& scene, const Mat4& projection, const Mat4& view, int frames) {
+    const int warmupFrames = 10;
+    double total = 0.0;
+
+    for (int i = 0; i < warmupFrames + frames; ++i) {
+        double start = glfwGetTime();
+
+        RenderStats::Get().Reset();
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        UBOManager::Get().BeginFrame();
+        UBOManager::Get().UpdateProjectionView(projection.data(), view.data());
+        scene.Update(1.0f / 60.0f);
+        scene.Render(projection, view);
+        UBOManager::Get().EndFrame();
+
+        // Le temps mesuré s'arrête avant le swap : seul le coût de soumission compte
+        double cpuTime = glfwGetTime() - start;
+        glfwSwapBuffers(g_Window);
+        if (i >= warmupFrames) {
+            total += cpuTime;
+        }
+    }
+    return total * 1000.0 / frames;
 }
 
-int main() {
+// Mode sans interface : --benchmark [objets] [frames]
+static int runBenchmark(int objectCount, int frames) {
+    if (!initializeOpenGL(false)) {
+        return -1;
+    }
+    glfwSwapInterval(0);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    UBOManager::Get().Initialize();
+
+    int result = 0;
+    {
+        BenchmarkScene scene(objectCount);
+        if (!scene.Initialize()) {
+            std::cerr << "Failed to initialize benchmark scene" << std::endl;
+            result = -1;
+        } else {
+            Mat4 projection = Mat4::perspective(FOV, (float)width / height, CAM_NEAR, CAM_FAR);
+            const float eye[3] = { 0.0f, 120.0f, 160.0f };
+            const float target[3] = { 0.0f, 0.0f, 0.0f };
+            const float up[3] = { 0.0f, 1.0f, 0.0f };
+            Mat4 view = Mat4::lookAt(eye, target, up);
+            scene.SetLODView(eye, projection.data()[5] * height * 0.5f);
+
+            // Les premières mesures comparent des chemins par draw
+            IndirectRenderer::SetEnabled(false);
+            UBOManager::Get().SetRingBufferEnabled(false);
+            double legacyMs = measureBenchmarkFrames(scene, projection, view, frames);
+            UBOManager::Get().SetRingBufferEnabled(true);
+            double ringMs = measureBenchmarkFrames(scene, projection, view, frames);
+
+            std::cout << "=== Transform UBO benchmark ===" << std::endl;
+            std::cout << "Objects: " << objectCount << ", frames: " << frames << std::endl;
+            std::cout << "glBufferSubData per draw: " << legacyMs << " ms/frame (CPU)" << std::endl;
+            std::cout << "Ring buffer ("
+                      << (UBOManager::Get().IsPersistentlyMapped() ? "persistent" : "orphaning")
+                      << "): " << ringMs << " ms/frame (CPU)" << std::endl;
+            if (ringMs > 0.0) {
+                std::cout << "Speedup: " << legacyMs / ringMs << "x" << std::endl;
+            }
+
+            // Même scène, ring actif : matériau renvoyé à chaque draw ou seulement quand il change
+            MaterialBuffer::Get().SetPerDrawUpload(true);
+            double perDrawMs = measureBenchmarkFrames(scene, projection, view, frames);
+            MaterialBuffer::Get().SetPerDrawUpload(false);
+            double bufferMs = measureBenchmarkFrames(scene, projection, view, frames);
+
+            std::cout << "=== Material buffer benchmark ===" << std::endl;
+            std::cout << "Material upload per draw: " << perDrawMs << " ms/frame (CPU)" << std::endl;
+            std::cout << "Material buffer, index only: " << bufferMs << " ms/frame (CPU), "
+                      << RenderStats::Get().materialUploads << " upload(s) last frame" << std::endl;
+            if (bufferMs > 0.0) {
+                std::cout << "Speedup: " << perDrawMs / bufferMs << "x" << std::endl;
+            }
+
+            // Niveaux de détail : triangles soumis par frame, tessellation complète ou réduite
+            LodSelector& lod = LodSelector::Get();
+            lod.enabled = false;
+            double fullMs = measureBenchmarkFrames(scene, projection, view, frames);
+            int fullTriangles = RenderStats::Get().triangles;
+            lod.enabled = true;
+            double lodMs = measureBenchmarkFrames(scene, projection, view, frames);
+            int lodTriangles = RenderStats::Get().triangles;
+
+            std::cout << "=== Level of detail benchmark ===" << std::endl;
+            std::cout << "LOD off: " << fullTriangles << " triangles/frame, " << fullMs << " ms/frame (CPU)" << std::endl;
+            std::cout << "LOD on: " << lodTriangles << " triangles/frame, " << lodMs << " ms/frame (CPU)" << std::endl;
+
+            // Même scène (LOD actif) : un draw par objet ou un multi-draw indirect
+            std::cout << "=== Multi-draw indirect benchmark ===" << std::endl;
+            if (!IndirectRenderer::IsSupported()) {
+                std::cout << "OpenGL 4.3 unavailable, skipped" << std::endl;
+            } else {
+                IndirectRenderer::SetEnabled(true);
+                double indirectMs = measureBenchmarkFrames(scene, projection, view, frames);
+                std::cout << "Per-draw submission: " << lodMs << " ms/frame (CPU)" << std::endl;
+                std::cout << "Multi-draw indirect: " << indirectMs << " ms/frame (CPU), "
+                          << RenderStats::Get().indirectDrawCalls << " call(s) for "
+                          << RenderStats::Get().indirectDraws << " draws" << std::endl;
+                if (indirectMs > 0.0) {
+                    std::cout << "Speedup: " << lodMs / indirectMs << "x" << std::endl;
+                }
+            }
+        }
+        scene.Cleanup();
+        scene.CleanupShaders();
+    }
+
+    MaterialBuffer::Get().Cleanup();
+    GeometryArena::Get().Cleanup();
+    LightManager::Get().Cleanup();
+    UBOManager::Get().Cleanup();
+    glfwDestroyWindow(g_Window);
+    glfwTerminate();
+    return result;
+}
+
+// Une frame de la scène de benchmark rendue dans le framebuffer actif, puis relue (RGBA)
+static void renderCheckFrame(BenchmarkScene& scene, const Mat4& projection, const Mat4& view,
+                             std::vector<unsigned char>& pixels) {
+    RenderStats::Get().Reset();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    UBOManager::Get().BeginFrame();
+    UBOManager::Get().UpdateProjectionView(projection.data(), view.data());
+    scene.Render(projection, view);
+    UBOManager::Get().EndFrame();
+
+    pixels.resize((size_t)width * height * 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+}
+
+static void writePPM(const std::string& path, const std::vector<unsigned char>& pixels) {
+    std::ofstream file(path, std::ios::binary);
+    file << "P6\n" << width << " " << height << "\n255\n";
+    // Lignes de bas en haut dans glReadPixels
+    for (int y = height - 1; y >= 0; --y) {
+        for (int x = 0; x < width; ++x) {
+            file.write(reinterpret_cast<const char*>(&pixels[((size_t)y * width + x) * 4]), 3);
+        }
+    }
+}
+
+// Pixels dont une composante s'écarte de plus de la tolérance
+static size_t countDifferentPixels(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b) {
+    const int tolerance = 8;
+    size_t different = 0;
+    for (size_t i = 0; i + 3 < a.size(); i += 4) {
+        for (int c = 0; c < 3; ++c) {
+            if (std::abs(a[i + c] - b[i + c]) > tolerance) {
+                ++different;
+                break;
+            }
+        }
+    }
+    return different;
+}
+
+// Mode sans interface : --render-check [objets]
+// Rend la même frame par draw (référence), instanciée puis en multi-draw indirect,
+// dans un framebuffer hors écran, et compare les images. Prévu pour tourner sans
+// GPU sur llvmpipe (Mesa, LIBGL_ALWAYS_SOFTWARE=1). Code de sortie 1 si un chemin
+// diffère ou si rien n'est dessiné ; les images fautives sont écrites en .ppm.
+static int runRenderCheck(int objectCount) {
+    if (!initializeOpenGL(false)) {
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << ", OpenGL " << glGetString(GL_VERSION) << std::endl;
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    UBOManager::Get().Initialize();
+
+    // La fenêtre cachée n'a pas de pixels garantis : rendu dans un FBO
+    GLuint fbo = 0, colorBuffer = 0, depthBuffer = 0;
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    int result = 0;
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Render check: incomplete framebuffer" << std::endl;
+        result = -1;
+    }
+
+    BenchmarkScene scene(objectCount);
+    if (result == 0 && !scene.Initialize()) {
+        std::cerr << "Failed to initialize benchmark scene" << std::endl;
+        result = -1;
+    }
+    if (result == 0) {
+        Mat4 projection = Mat4::perspective(FOV, (float)width / height, CAM_NEAR, CAM_FAR);
+        const float eye[3] = { 0.0f, 40.0f, 60.0f };
+        const float target[3] = { 0.0f, 0.0f, 0.0f };
+        const float up[3] = { 0.0f, 1.0f, 0.0f };
+        Mat4 view = Mat4::lookAt(eye, target, up);
+        scene.SetLODView(eye, projection.data()[5] * height * 0.5f);
+
+        std::vector<unsigned char> reference, image;
+        IndirectRenderer::SetEnabled(false);
+        renderCheckFrame(scene, projection, view, reference);
+
+        // Une image vide passerait toutes les comparaisons
+        size_t covered = 0;
+        for (size_t i = 0; i < reference.size(); i += 4) {
+            if (reference[i] || reference[i + 1] || reference[i + 2]) ++covered;
+        }
+        std::cout << "Per-draw reference: " << covered << " lit pixels of " << (size_t)width * height << std::endl;
+        if (covered < (size_t)width * height / 100) {
+            std::cerr << "Render check failed: reference image is empty" << std::endl;
+            writePPM("render_check_reference.ppm", reference);
+            result = 1;
+        }
+
+        // Pixels différents tolérés sur les arêtes (0,1 % de l'image). Un chemin
+        // retombé sur les draws individuels (programme cassé) compte comme un échec.
+        const size_t maxDifferent = (size_t)width * height / 1000;
+        auto compare = [&](const char* name, int pathDraws) {
+            if (pathDraws == 0) {
+                std::cerr << "Render check failed: " << name << " path drew nothing (fell back to per-draw)" << std::endl;
+                result = 1;
+                return;
+            }
+            size_t different = countDifferentPixels(reference, image);
+            std::cout << name << ": " << different << " pixel(s) differ from the reference" << std::endl;
+            if (different > maxDifferent) {
+                std::cerr << "Render check failed: " << name << " path" << std::endl;
+                writePPM("render_check_reference.ppm", reference);
+                writePPM(std::string("render_check_") + name + ".ppm", image);
+                result = 1;
+            }
+        };
+
+        if (!scene.SetInstancingEnabled(true)) {
+            std::cerr << "Render check failed: instanced shader unavailable" << std::endl;
+            result = 1;
+        } else {
+            renderCheckFrame(scene, projection, view, image);
+            compare("instanced", RenderStats::Get().instances);
+            scene.SetInstancingEnabled(false);
+        }
+
+        if (IndirectRenderer::IsSupported()) {
+            IndirectRenderer::SetEnabled(true);
+            renderCheckFrame(scene, projection, view, image);
+            compare("indirect", RenderStats::Get().indirectDraws);
+        } else {
+            std::cout << "OpenGL 4.3 unavailable, indirect path not checked" << std::endl;
+        }
+        std::cout << (result == 0 ? "Render check passed" : "Render check FAILED") << std::endl;
+    }
+    scene.Cleanup();
+    scene.CleanupShaders();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+    glDeleteFramebuffers(1, &fbo);
+    MaterialBuffer::Get().Cleanup();
+    GeometryArena::Get().Cleanup();
+    LightManager::Get().Cleanup();
+    UBOManager::Get().Cleanup();
+    glfwDestroyWindow(g_Window);
+    glfwTerminate();
+    return result;
+}
+
+int main(int argc, char** argv) {
     if (!glfwInit()) {
         std::cerr << "Erreur : Impossible d'initialiser GLFW" << std::endl;
         return -1;
     }
 
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--benchmark") == 0) {
+            int objectCount = (i + 1 < argc) ? atoi(argv[i + 1]) : 5000;
+            int frames = (i + 2 < argc) ? atoi(argv[i + 2]) : 200;
+            return runBenchmark(objectCount > 0 ? objectCount : 5000, frames > 0 ? frames : 200);
+        }
+        if (strcmp(argv[i], "--render-check") == 0) {
+            int objectCount = (i + 1 < argc) ? atoi(argv[i + 1]) : 400;
+            return runRenderCheck(objectCount > 0 ? objectCount : 400);
+        }
+    }
+
     if (!Initialize()) {
         std::cerr << "Erreur : Impossible d'initialiser l'application" << std::endl;
         glfwTerminate();
@@ -296,11 +647,18 @@ int main() {
     last_frame_time = glfwGetTime();
 
     // Boucle principale
+    bool shaderReportPrinted = false;
     while (!glfwWindowShouldClose(g_Window)) {
         processInput(g_Window);
         Render();
         glfwSwapBuffers(g_Window);
         glfwPollEvents();
+
+        // Après la première frame, les programmes de la scène active sont liés
+        if (!shaderReportPrinted) {
+            ProgramRegistry::Get().PrintReport();
+            shaderReportPrinted = true;
+        }
     }
 
     // Nettoyage
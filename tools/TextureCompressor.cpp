@@ -0,0 +1,372 @@
+// Conversion hors ligne des textures en KTX2 compressé par blocs (BC1 / BC3),
+// avec la chaîne de mipmaps précalculée. Utilisé par "make textures".
+// Usage : texcompress.exe [--linear] [--format auto|bc1|bc3] [--no-mips] <sortie.ktx2> <image>
+//         texcompress.exe [--linear] [--format ...] --cube <sortie.ktx2> <+X> <-X> <+Y> <-Y> <+Z> <-Z>
+// BC7 est accepté par le chargeur (KTX2 produits par d'autres outils) mais pas encodé ici.
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+#include "../include/KTX2.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    bool linear = false;
+    bool mipmaps = true;
+    bool cube = false;
+    std::string format = "auto";
+};
+
+// Image RGBA en flottants, couleur en espace linéaire
+struct FloatImage {
+    int width = 0;
+    int height = 0;
+    std::vector<float> pixels;
+};
+
+float SRGBToLinear(float c) {
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToSRGB(float c) {
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+FloatImage ToFloat(const unsigned char* rgba, int width, int height, bool srgb) {
+    float lut[256];
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = srgb ? SRGBToLinear(i / 255.0f) : i / 255.0f;
+    }
+
+    FloatImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < image.pixels.size(); ++i) {
+        image.pixels[i] = (i % 4 == 3) ? rgba[i] / 255.0f : lut[rgba[i]];
+    }
+    return image;
+}
+
+std::vector<unsigned char> ToBytes(const FloatImage& image, bool srgb) {
+    std::vector<unsigned char> rgba(image.pixels.size());
+    for (size_t i = 0; i < rgba.size(); ++i) {
+        float c = std::min(1.0f, std::max(0.0f, image.pixels[i]));
+        if (srgb && i % 4 != 3) c = LinearToSRGB(c);
+        rgba[i] = static_cast<unsigned char>(c * 255.0f + 0.5f);
+    }
+    return rgba;
+}
+
+// Réduction 2x2 en espace linéaire (le dernier texel d'une dimension impaire est replié)
+FloatImage Downsample(const FloatImage& source) {
+    FloatImage result;
+    result.width = std::max(1, source.width / 2);
+    result.height = std::max(1, source.height / 2);
+    result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+    for (int y = 0; y < result.height; ++y) {
+        for (int x = 0; x < result.width; ++x) {
+            int x0 = std::min(2 * x, source.width - 1), x1 = std::min(2 * x + 1, source.width - 1);
+            int y0 = std::min(2 * y, source.height - 1), y1 = std::min(2 * y + 1, source.height - 1);
+            for (int c = 0; c < 4; ++c) {
+                float sum = source.pixels[(static_cast<size_t>(y0) * source.width + x0) * 4 + c] +
+                            source.pixels[(static_cast<size_t>(y0) * source.width + x1) * 4 + c] +
+                            source.pixels[(static_cast<size_t>(y1) * source.width + x0) * 4 + c] +
+                            source.pixels[(static_cast<size_t>(y1) * source.width + x1) * 4 + c];
+                result.pixels[(static_cast<size_t>(y) * result.width + x) * 4 + c] = sum * 0.25f;
+            }
+        }
+    }
+    return result;
+}
+
+// ==================== Encodage BC1 / BC3 ====================
+
+uint16_t PackRGB565(const float color[3]) {
+    int r = static_cast<int>(std::min(31.0f, std::max(0.0f, color[0] * 31.0f / 255.0f + 0.5f)));
+    int g = static_cast<int>(std::min(63.0f, std::max(0.0f, color[1] * 63.0f / 255.0f + 0.5f)));
+    int b = static_cast<int>(std::min(31.0f, std::max(0.0f, color[2] * 31.0f / 255.0f + 0.5f)));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRGB565(uint16_t packed, float color[3]) {
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = static_cast<float>((r << 3) | (r >> 2));
+    color[1] = static_cast<float>((g << 2) | (g >> 4));
+    color[2] = static_cast<float>((b << 3) | (b >> 2));
+}
+
+// Palette 4 couleurs du mode opaque (color0 > color1)
+void BuildPalette(uint16_t c0, uint16_t c1, float palette[4][3]) {
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+        palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+    }
+}
+
+float AssignIndices(const float block[16][3], const float palette[4][3], int indices[16]) {
+    float error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = 1e30f;
+        for (int p = 0; p < 4; ++p) {
+            float dr = block[i][0] - palette[p][0];
+            float dg = block[i][1] - palette[p][1];
+            float db = block[i][2] - palette[p][2];
+            float d = dr * dr + dg * dg + db * db;
+            if (d < best) {
+                best = d;
+                indices[i] = p;
+            }
+        }
+        error += best;
+    }
+    return error;
+}
+
+// Extrémités le long de l'axe principal, puis un pas de moindres carrés
+void EncodeColorBlock(const float block[16][3], unsigned char out[8]) {
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) mean[c] += block[i][c] / 16.0f;
+    }
+
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i) {
+        float d[3] = { block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2] };
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[3] = {
+            cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+            cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+            cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]
+        };
+        float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        if (length < 1e-6f) break;
+        for (int c = 0; c < 3; ++c) axis[c] = next[c] / length;
+    }
+
+    float minT = 1e30f, maxT = -1e30f;
+    for (int i = 0; i < 16; ++i) {
+        float t = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    float endpoint0[3], endpoint1[3];
+    for (int c = 0; c < 3; ++c) {
+        endpoint0[c] = mean[c] + axis[c] * maxT;
+        endpoint1[c] = mean[c] + axis[c] * minT;
+    }
+
+    uint16_t c0 = PackRGB565(endpoint0);
+    uint16_t c1 = PackRGB565(endpoint1);
+    float palette[4][3];
+    int indices[16];
+    BuildPalette(std::max(c0, c1), std::min(c0, c1), palette);
+    float error = AssignIndices(block, palette, indices);
+
+    // Moindres carrés : extrémités optimales pour les indices choisis
+    static const float WEIGHT0[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f, ax[3] = { 0, 0, 0 }, bx[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i) {
+        float a = WEIGHT0[indices[i]], b = 1.0f - a;
+        aa += a * a; bb += b * b; ab += a * b;
+        for (int c = 0; c < 3; ++c) { ax[c] += a * block[i][c]; bx[c] += b * block[i][c]; }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) > 1e-6f) {
+        float refined0[3], refined1[3];
+        for (int c = 0; c < 3; ++c) {
+            refined0[c] = (ax[c] * bb - bx[c] * ab) / det;
+            refined1[c] = (bx[c] * aa - ax[c] * ab) / det;
+        }
+        uint16_t r0 = PackRGB565(refined0), r1 = PackRGB565(refined1);
+        float refinedPalette[4][3];
+        int refinedIndices[16];
+        BuildPalette(std::max(r0, r1), std::min(r0, r1), refinedPalette);
+        float refinedError = AssignIndices(block, refinedPalette, refinedIndices);
+        if (refinedError < error) {
+            c0 = r0; c1 = r1;
+            memcpy(indices, refinedIndices, sizeof(indices));
+        }
+    }
+
+    uint16_t high = std::max(c0, c1), low = std::min(c0, c1);
+    uint32_t bits = 0;
+    if (high != low) {
+        for (int i = 0; i < 16; ++i) bits |= static_cast<uint32_t>(indices[i]) << (2 * i);
+    }
+    out[0] = high & 0xFF; out[1] = high >> 8;
+    out[2] = low & 0xFF;  out[3] = low >> 8;
+    for (int i = 0; i < 4; ++i) out[4 + i] = (bits >> (8 * i)) & 0xFF;
+}
+
+// Alpha BC3 : mode 8 valeurs (alpha0 > alpha1)
+void EncodeAlphaBlock(const float alpha[16], unsigned char out[8]) {
+    float minA = 255.0f, maxA = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        minA = std::min(minA, alpha[i]);
+        maxA = std::max(maxA, alpha[i]);
+    }
+    int a0 = static_cast<int>(maxA + 0.5f), a1 = static_cast<int>(minA + 0.5f);
+    out[0] = static_cast<unsigned char>(a0);
+    out[1] = static_cast<unsigned char>(a1);
+
+    uint64_t bits = 0;
+    if (a0 != a1) {
+        float palette[8] = { (float)a0, (float)a1 };
+        for (int i = 1; i < 7; ++i) palette[i + 1] = ((7 - i) * a0 + i * a1) / 7.0f;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            float bestError = 1e30f;
+            for (int p = 0; p < 8; ++p) {
+                float d = std::fabs(alpha[i] - palette[p]);
+                if (d < bestError) { bestError = d; best = p; }
+            }
+            bits |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+    for (int i = 0; i < 6; ++i) out[2 + i] = (bits >> (8 * i)) & 0xFF;
+}
+
+// Encode un niveau RGBA8 ; les blocs partiels répètent les texels du bord
+std::vector<unsigned char> EncodeLevel(const std::vector<unsigned char>& rgba, int width, int height, bool withAlpha) {
+    const int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const size_t blockBytes = withAlpha ? 16 : 8;
+    std::vector<unsigned char> out(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            float color[16][3];
+            float alpha[16];
+            for (int i = 0; i < 16; ++i) {
+                int x = std::min(bx * 4 + i % 4, width - 1);
+                int y = std::min(by * 4 + i / 4, height - 1);
+                const unsigned char* texel = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+                color[i][0] = texel[0]; color[i][1] = texel[1]; color[i][2] = texel[2];
+                alpha[i] = texel[3];
+            }
+            unsigned char* block = &out[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+            if (withAlpha) {
+                EncodeAlphaBlock(alpha, block);
+                EncodeColorBlock(color, block + 8);
+            } else {
+                EncodeColorBlock(color, block);
+            }
+        }
+    }
+    return out;
+}
+
+bool HasAlpha(const unsigned char* rgba, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        if (rgba[i * 4 + 3] != 255) return true;
+    }
+    return false;
+}
+
+int Usage() {
+    fprintf(stderr,
+        "usage: texcompress [--linear] [--format auto|bc1|bc3] [--no-mips] <out.ktx2> <image>\n"
+        "       texcompress [--linear] [--format auto|bc1|bc3] --cube <out.ktx2> <+X> <-X> <+Y> <-Y> <+Z> <-Z>\n");
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    int arg = 1;
+    for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; ++arg) {
+        if (strcmp(argv[arg], "--linear") == 0) options.linear = true;
+        else if (strcmp(argv[arg], "--no-mips") == 0) options.mipmaps = false;
+        else if (strcmp(argv[arg], "--cube") == 0) options.cube = true;
+        else if (strcmp(argv[arg], "--format") == 0 && arg + 1 < argc) options.format = argv[++arg];
+        else return Usage();
+    }
+
+    const int faceCount = options.cube ? 6 : 1;
+    if (argc - arg != 1 + faceCount) {
+        return Usage();
+    }
+    const std::string output = argv[arg];
+
+    // Décodage de toutes les faces (mêmes dimensions exigées pour un cubemap)
+    std::vector<unsigned char*> faces(faceCount, nullptr);
+    int width = 0, height = 0;
+    bool anyAlpha = false;
+    for (int face = 0; face < faceCount; ++face) {
+        int w, h, channels;
+        faces[face] = stbi_load(argv[arg + 1 + face], &w, &h, &channels, 4);
+        if (!faces[face]) {
+            fprintf(stderr, "cannot load %s: %s\n", argv[arg + 1 + face], stbi_failure_reason());
+            return 1;
+        }
+        if (face > 0 && (w != width || h != height)) {
+            fprintf(stderr, "cube faces must share the same size: %s\n", argv[arg + 1 + face]);
+            return 1;
+        }
+        width = w;
+        height = h;
+        anyAlpha = anyAlpha || HasAlpha(faces[face], static_cast<size_t>(w) * h);
+    }
+
+    bool withAlpha = options.format == "bc3" || (options.format == "auto" && anyAlpha);
+    if (options.format != "auto" && options.format != "bc1" && options.format != "bc3") {
+        fprintf(stderr, "unsupported format '%s' (BC7 is load-only)\n", options.format.c_str());
+        return 1;
+    }
+
+    const bool srgb = !options.linear;
+    KTX2::Image image;
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.faceCount = static_cast<uint32_t>(faceCount);
+    image.format = withAlpha ? (srgb ? KTX2::BC3_SRGB : KTX2::BC3_UNORM)
+                             : (srgb ? KTX2::BC1_RGB_SRGB : KTX2::BC1_RGB_UNORM);
+
+    size_t levelCount = 1;
+    if (options.mipmaps) {
+        for (int size = std::max(width, height); size > 1; size /= 2) levelCount++;
+    }
+    image.levels.resize(levelCount);
+
+    size_t uncompressedBytes = 0;
+    for (int face = 0; face < faceCount; ++face) {
+        FloatImage level = ToFloat(faces[face], width, height, srgb);
+        for (size_t i = 0; i < levelCount; ++i) {
+            if (i > 0) level = Downsample(level);
+            std::vector<unsigned char> rgba = i == 0
+                ? std::vector<unsigned char>(faces[face], faces[face] + static_cast<size_t>(width) * height * 4)
+                : ToBytes(level, srgb);
+            std::vector<unsigned char> blocks = EncodeLevel(rgba, level.width, level.height, withAlpha);
+            image.levels[i].insert(image.levels[i].end(), blocks.begin(), blocks.end());
+            uncompressedBytes += rgba.size();
+        }
+        stbi_image_free(faces[face]);
+    }
+
+    std::string error;
+    if (!KTX2::Save(output, image, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    printf("%s: %dx%d%s, %s, %zu levels, %.2f MB (RGBA8: %.2f MB, %.1fx smaller)\n",
+           output.c_str(), width, height, options.cube ? " cube" : "", withAlpha ? "BC3" : "BC1",
+           levelCount, image.GetByteSize() / (1024.0 * 1024.0), uncompressedBytes / (1024.0 * 1024.0),
+           static_cast<double>(uncompressedBytes) / image.GetByteSize());
+    return 0;
+}